@@ -59,6 +59,11 @@
         //#define LV_MEM_POOL_ALLOC   your_alloc          /* Uncomment if using an external allocator*/
     #endif
 
+    /*Size of the part of `LV_MEM_SIZE` reserved for small allocations (objects, animations, timers, linked list nodes, etc).
+     *They are served from free lists of a few size classes which is faster and doesn't fragment the rest of the memory.
+     *It's used in 1 kB pages. 0: disable*/
+    #define LV_MEM_SLAB_SIZE (16U * 1024U)     /*[bytes]*/
+
 #else       /*LV_MEM_CUSTOM*/
     #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
     #define LV_MEM_CUSTOM_ALLOC   malloc
@@ -80,9 +85,18 @@
 /*Default display refresh period. LVG will redraw changed areas with this period time*/
 #define LV_DISP_DEF_REFR_PERIOD 30      /*[ms]*/
 
+/*If more areas are invalidated in a refresh period than what fits to the display's list (LV_INV_BUF_SIZE)
+ *mark them on a grid of this size tiles and redraw the covering rectangles instead of the whole screen.
+ *The grid needs (hor. res / size / 8) * (ver. res / size) bytes. 0: redraw the whole screen*/
+#define LV_INV_TILE_SIZE 16             /*[px]*/
+
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
+/*Put the children of objects with at least this many children on a grid by their position
+ *to check only the children around the point when searching the pressed object. 0: check all children*/
+#define LV_INDEV_HIT_GRID_MIN 32
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #define LV_TICK_CUSTOM 1
@@ -110,7 +124,8 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost. The corners of several smaller shadows can be cached in it
+    *and the least recently used ones are dropped first.*/
     #define LV_SHADOW_CACHE_SIZE 0
 
     /* Set number of maximally cached circle data.
@@ -118,6 +133,12 @@
     * radius * 4 bytes are used per circle (the most often used radiuses are saved)
     * 0: to disable caching */
     #define LV_CIRCLE_CACHE_SIZE 4
+
+    /* Size of the cache of pre-rendered rounded corners in bytes.
+    * The 4 corners of a radius are saved as a (2 * radius)^2 bytes opacity map
+    * to draw rounded rectangles without evaluating a mask on every line (the most recently used radiuses are saved)
+    * 0: to disable caching */
+    #define LV_CORNER_CACHE_SIZE (16 * 1024)
 #endif /*LV_DRAW_COMPLEX*/
 
 /*Default image cache size. Image caching keeps the images opened.
@@ -153,6 +174,29 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (32*1024)
 
+/*Number of resolved style properties to cache (e.g. 4096) to avoid searching the styles of the objects on every read.
+ *The properties of all objects share the cache. It should be large enough for the properties of the objects on the screen.
+ *Every property needs 12 + sizeof(lv_style_value_t) bytes (16 on 32 bit systems), on every rendering thread,
+ *and every object 4 bytes. 0: no caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 4096
+
+/*Render the invalidated areas in horizontal bands on several threads at once.
+ *Requires POSIX threads and the software renderer (other draw units render on one thread).
+ *The draw events (e.g. `LV_EVENT_DRAW_PART_BEGIN`) are sent from the rendering threads,
+ *so their callbacks shouldn't write shared data.*/
+#define LV_USE_REFR_THREADS 0
+#if LV_USE_REFR_THREADS
+    /*Number of rendering threads, including the one calling `lv_timer_handler()`*/
+    #define LV_REFR_THREAD_CNT 4
+
+    /*Don't split an area into bands lower than this many rows (starting threads has a cost too)*/
+    #define LV_REFR_THREAD_MIN_BAND 16
+#endif
+
+/*Blend with SSE2/AVX2 (x86) or NEON (ARM) instructions if the CPU supports them (checked at runtime on x86).
+ *Works with 32 bit and not swapped 16 bit colors and GCC compatible compilers. The result is the same as without it.*/
+#define LV_DRAW_SW_SIMD 1
+
 /*-------------
  * GPU
  *-----------*/
@@ -370,8 +414,18 @@
  *Compiler error will be triggered if a font needs it.*/
 #define LV_FONT_FMT_TXT_LARGE 1
 
+/*Build direct lookup tables for the glyph ids of the Basic Multilingual Plane (0.5 kB per 256 code points with glyphs)
+ *and for the kerning pairs of the first 128 glyphs (16 kB, only for fonts with kerning pairs) when a font is first used.
+ *Speeds up getting the glyphs of large and sparse fonts, e.g. CJK fonts.*/
+#define LV_FONT_FMT_TXT_FAST_LOOKUP 1
+
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 1
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of the decompressed glyph bitmaps in bytes (per rendering thread).
+     *The least recently used glyphs are dropped if it's full. 0: decompress the glyph on every draw*/
+    #define LV_FONT_COMPRESSED_CACHE_SIZE (8 * 1024)
+#endif
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 1
@@ -454,6 +508,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LAYOUT_CACHE 1   /*Store the lines of the text in labels to not measure them again on every redraw*/
 #endif
 
 #define LV_USE_LINE       1
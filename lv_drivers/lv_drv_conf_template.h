@@ -102,7 +102,9 @@
 #  define SDL_ZOOM        1
 
 /* Used to test true double buffering with only address changing.
- * Use 2 draw buffers, bith with SDL_HOR_RES x SDL_VER_RES size*/
+ * Use 2 draw buffers, both with SDL_HOR_RES x SDL_VER_RES size.
+ * With `direct_mode = 1` only the changed areas are rendered and uploaded to the window.
+ * Requires LV_COLOR_DEPTH 32*/
 #  define SDL_DOUBLE_BUFFERED 0
 
 /*Eclipse: <SDL2/SDL.h>    Visual Studio: <SDL.h>*/
@@ -70,8 +70,8 @@ typedef struct {
     volatile bool sdl_refr_qry;
 #if SDL_DOUBLE_BUFFERED
     uint32_t * tft_fb_act;
-#else
-    uint32_t * tft_fb;
+    lv_area_t dirty_area;       /*Union of the areas flushed since the last upload*/
+    bool dirty;
 #endif
 }monitor_t;
 
@@ -80,6 +80,7 @@ typedef struct {
  **********************/
 static void window_create(monitor_t * m);
 static void window_update(monitor_t * m);
+static void flush_area(monitor_t * m, lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 static void monitor_sdl_clean_up(void);
 static void sdl_event_handler(lv_timer_t * t);
 static void monitor_sdl_refr(lv_timer_t * t);
@@ -98,6 +99,7 @@ monitor_t monitor2;
 #endif
 
 static volatile bool sdl_inited = false;
+static lv_timer_t * event_timer;
 
 static bool left_button_down = false;
 static int16_t last_x = 0;
@@ -134,7 +136,23 @@ void sdl_init(void)
 
     SDL_StartTextInput();
 
-    lv_timer_create(sdl_event_handler, 10, NULL);
+    event_timer = lv_timer_create(sdl_event_handler, 10, NULL);
+}
+
+/**
+ * Handle the pending SDL events now and make the SDL input devices read them in the next `lv_timer_handler()`.
+ * Call it before `lv_timer_handler()` when `sdl_wait_event()` is used.
+ * After the first call the events are not polled by a timer anymore.
+ */
+void sdl_handle_events(void)
+{
+    /*The events are handled right after waking up so polling them is not required*/
+    if(event_timer) {
+        lv_timer_del(event_timer);
+        event_timer = NULL;
+    }
+
+    sdl_event_handler(NULL);
 }
 
 /**
@@ -145,51 +163,7 @@ void sdl_init(void)
  */
 void sdl_display_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
 {
-    const lv_coord_t hres = disp_drv->physical_hor_res == -1 ? disp_drv->hor_res : disp_drv->physical_hor_res;
-    const lv_coord_t vres = disp_drv->physical_ver_res == -1 ? disp_drv->ver_res : disp_drv->physical_ver_res;
-
-//    printf("x1:%d,y1:%d,x2:%d,y2:%d\n", area->x1, area->y1, area->x2, area->y2);
-
-    /*Return if the area is out the screen*/
-    if(area->x2 < 0 || area->y2 < 0 || area->x1 > hres - 1 || area->y1 > vres - 1) {
-        lv_disp_flush_ready(disp_drv);
-        return;
-    }
-
-#if SDL_DOUBLE_BUFFERED
-    monitor.tft_fb_act = (uint32_t *)color_p;
-#else /*SDL_DOUBLE_BUFFERED*/
-
-    int32_t y;
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    int32_t x;
-    for(y = area->y1; y <= area->y2 && y < vres; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            monitor.tft_fb[y * hres + x] = lv_color_to32(*color_p);
-            color_p++;
-        }
-
-    }
-#else
-    uint32_t w = lv_area_get_width(area);
-    for(y = area->y1; y <= area->y2 && y < vres; y++) {
-        memcpy(&monitor.tft_fb[y * hres + area->x1], color_p, w * sizeof(lv_color_t));
-        color_p += w;
-    }
-#endif
-#endif /*SDL_DOUBLE_BUFFERED*/
-
-    monitor.sdl_refr_qry = true;
-
-    /* TYPICALLY YOU DO NOT NEED THIS
-     * If it was the last part to refresh update the texture of the window.*/
-    if(lv_disp_flush_is_last(disp_drv)) {
-        monitor_sdl_refr(NULL);
-    }
-
-    /*IMPORTANT! It must be called to tell the system the flush is ready*/
-    lv_disp_flush_ready(disp_drv);
-
+    flush_area(&monitor, disp_drv, area, color_p);
 }
 
 
@@ -203,53 +177,7 @@ void sdl_display_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
  */
 void sdl_display_flush2(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
 {
-    const lv_coord_t hres = disp_drv->physical_hor_res == -1 ? disp_drv->hor_res : disp_drv->physical_hor_res;
-    const lv_coord_t vres = disp_drv->physical_ver_res == -1 ? disp_drv->ver_res : disp_drv->physical_ver_res;
-
-    /*Return if the area is out the screen*/
-    if(area->x2 < 0 || area->y2 < 0 || area->x1 > hres - 1 || area->y1 > vres - 1) {
-        lv_disp_flush_ready(disp_drv);
-        return;
-    }
-
-#if SDL_DOUBLE_BUFFERED
-    monitor2.tft_fb_act = (uint32_t *)color_p;
-
-    monitor2.sdl_refr_qry = true;
-
-    /*IMPORTANT! It must be called to tell the system the flush is ready*/
-    lv_disp_flush_ready(disp_drv);
-#else
-
-    int32_t y;
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    int32_t x;
-    for(y = area->y1; y <= area->y2 && y < vres; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            monitor2.tft_fb[y * hres + x] = lv_color_to32(*color_p);
-            color_p++;
-        }
-
-    }
-#else
-    uint32_t w = lv_area_get_width(area);
-    for(y = area->y1; y <= area->y2 && y < vres; y++) {
-        memcpy(&monitor2.tft_fb[y * hres + area->x1], color_p, w * sizeof(lv_color_t));
-        color_p += w;
-    }
-#endif
-
-    monitor2.sdl_refr_qry = true;
-
-    /* TYPICALLY YOU DO NOT NEED THIS
-     * If it was the last part to refresh update the texture of the window.*/
-    if(lv_disp_flush_is_last(disp_drv)) {
-        monitor_sdl_refr(NULL);
-    }
-
-    /*IMPORTANT! It must be called to tell the system the flush is ready*/
-    lv_disp_flush_ready(disp_drv);
-#endif
+    flush_area(&monitor2, disp_drv, area, color_p);
 }
 #endif
 
@@ -273,6 +201,7 @@ static void sdl_event_handler(lv_timer_t * t)
         mouse_handler(&event);
         mousewheel_handler(&event);
         keyboard_handler(&event);
+        indev_read_ready(&event);
 
         if((&event)->type == SDL_WINDOWEVENT) {
             switch((&event)->window.event) {
@@ -321,6 +250,93 @@ static void monitor_sdl_refr(lv_timer_t * t)
 #endif
 }
 
+/**
+ * Flush a buffer to the marked area of a window.
+ * Without double buffering only the area of the texture is locked and written (no intermediate frame buffer).
+ * With double buffering the draw buffer is the frame buffer and only the union of the flushed areas is uploaded.
+ * @param m pointer to the window's monitor
+ * @param disp_drv pointer to driver where this function belongs
+ * @param area an area where to copy `color_p`
+ * @param color_p an array of pixels to copy to the `area` part of the screen
+ */
+static void flush_area(monitor_t * m, lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    const lv_coord_t hres = disp_drv->physical_hor_res == -1 ? disp_drv->hor_res : disp_drv->physical_hor_res;
+    const lv_coord_t vres = disp_drv->physical_ver_res == -1 ? disp_drv->ver_res : disp_drv->physical_ver_res;
+
+    /*Return if the area is out the screen*/
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, LV_MIN(hres, SDL_HOR_RES) - 1, LV_MIN(vres, SDL_VER_RES) - 1);
+    lv_area_t clipped;
+    if(!_lv_area_intersect(&clipped, area, &scr_area)) {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+#if SDL_DOUBLE_BUFFERED
+    m->tft_fb_act = (uint32_t *)color_p;
+
+    /*In direct mode the area is the whole screen but only the invalidated areas were redrawn.
+     *The rest of the buffer is the same as the previous frame (the buffers are synced by LVGL).*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp_drv->direct_mode && disp) {
+        uint32_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            if(disp->inv_area_joined[i]) continue;
+            if(!_lv_area_intersect(&clipped, &disp->inv_areas[i], &scr_area)) continue;
+            if(m->dirty) _lv_area_join(&m->dirty_area, &m->dirty_area, &clipped);
+            else m->dirty_area = clipped;
+            m->dirty = true;
+        }
+    }
+    else {
+        if(m->dirty) _lv_area_join(&m->dirty_area, &m->dirty_area, &clipped);
+        else m->dirty_area = clipped;
+        m->dirty = true;
+    }
+#else /*SDL_DOUBLE_BUFFERED*/
+    SDL_Rect r;
+    r.x = clipped.x1;
+    r.y = clipped.y1;
+    r.w = lv_area_get_width(&clipped);
+    r.h = lv_area_get_height(&clipped);
+
+    void * pixels;
+    int pitch;
+    if(SDL_LockTexture(m->texture, &r, &pixels, &pitch) == 0) {
+        /*Skip the clipped rows and columns of the source*/
+        uint32_t w = lv_area_get_width(area);
+        color_p += (clipped.y1 - area->y1) * w + (clipped.x1 - area->x1);
+
+        int32_t y;
+        for(y = 0; y < r.h; y++) {
+            uint32_t * dst = (uint32_t *)((uint8_t *)pixels + y * pitch);
+#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
+            int32_t x;
+            for(x = 0; x < r.w; x++) {
+                dst[x] = lv_color_to32(color_p[x]);
+            }
+#else
+            memcpy(dst, color_p, r.w * sizeof(lv_color_t));
+#endif
+            color_p += w;
+        }
+        SDL_UnlockTexture(m->texture);
+    }
+#endif /*SDL_DOUBLE_BUFFERED*/
+
+    m->sdl_refr_qry = true;
+
+    /* TYPICALLY YOU DO NOT NEED THIS
+     * If it was the last part to refresh update the texture of the window.*/
+    if(lv_disp_flush_is_last(disp_drv)) {
+        monitor_sdl_refr(NULL);
+    }
+
+    /*IMPORTANT! It must be called to tell the system the flush is ready*/
+    lv_disp_flush_ready(disp_drv);
+}
+
 static void monitor_sdl_clean_up(void)
 {
     SDL_DestroyTexture(monitor.texture);
@@ -350,17 +366,21 @@ static void window_create(monitor_t * m)
                               SDL_HOR_RES * SDL_ZOOM, SDL_VER_RES * SDL_ZOOM, flag);       /*last param. SDL_WINDOW_BORDERLESS to hide borders*/
 
     m->renderer = SDL_CreateRenderer(m->window, -1, SDL_RENDERER_SOFTWARE);
+    /*Streaming to lock and write only the flushed areas. The content of the rest of the texture is kept.*/
     m->texture = SDL_CreateTexture(m->renderer,
-                                SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, SDL_HOR_RES, SDL_VER_RES);
+                                SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, SDL_HOR_RES, SDL_VER_RES);
     SDL_SetTextureBlendMode(m->texture, SDL_BLENDMODE_BLEND);
 
     /*Initialize the frame buffer to gray (77 is an empirical value) */
-#if SDL_DOUBLE_BUFFERED
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, SDL_HOR_RES * sizeof(uint32_t));
-#else
-    m->tft_fb = (uint32_t *)malloc(sizeof(uint32_t) * SDL_HOR_RES * SDL_VER_RES);
-    memset(m->tft_fb, 0x44, SDL_HOR_RES * SDL_VER_RES * sizeof(uint32_t));
-#endif
+    void * pixels;
+    int pitch;
+    if(SDL_LockTexture(m->texture, NULL, &pixels, &pitch) == 0) {
+        int32_t y;
+        for(y = 0; y < SDL_VER_RES; y++) {
+            memset((uint8_t *)pixels + y * pitch, 0x44, SDL_HOR_RES * sizeof(uint32_t));
+        }
+        SDL_UnlockTexture(m->texture);
+    }
 
     m->sdl_refr_qry = true;
 
@@ -368,11 +388,17 @@ static void window_create(monitor_t * m)
 
 static void window_update(monitor_t * m)
 {
-#if SDL_DOUBLE_BUFFERED == 0
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb, SDL_HOR_RES * sizeof(uint32_t));
-#else
-    if(m->tft_fb_act == NULL) return;
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, SDL_HOR_RES * sizeof(uint32_t));
+#if SDL_DOUBLE_BUFFERED
+    /*Upload only the changed part of the frame buffer. The other areas are the same in the texture.*/
+    if(m->dirty) {
+        SDL_Rect r;
+        r.x = m->dirty_area.x1;
+        r.y = m->dirty_area.y1;
+        r.w = lv_area_get_width(&m->dirty_area);
+        r.h = lv_area_get_height(&m->dirty_area);
+        SDL_UpdateTexture(m->texture, &r, &m->tft_fb_act[r.y * SDL_HOR_RES + r.x], SDL_HOR_RES * sizeof(uint32_t));
+        m->dirty = false;
+    }
 #endif
     SDL_RenderClear(m->renderer);
     lv_disp_t * d = _lv_refr_get_disp_refreshing();
@@ -18,7 +18,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-
+static void indev_read_pause(lv_indev_drv_t * indev_drv, const lv_indev_data_t * data);
 
 /**********************
  *  STATIC VARIABLES
@@ -51,6 +51,8 @@ void sdl_mouse_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
     data->point.x = last_x;
     data->point.y = last_y;
     data->state = left_button_down ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+
+    indev_read_pause(indev_drv, data);
 }
 
 
@@ -66,6 +68,8 @@ void sdl_mousewheel_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
     data->state = wheel_state;
     data->enc_diff = wheel_diff;
     wheel_diff = 0;
+
+    indev_read_pause(indev_drv, data);
 }
 
 /**
@@ -94,12 +98,99 @@ void sdl_keyboard_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
         memmove(buf, buf + 1, len);
         data->continue_reading = true;
     }
+
+    indev_read_pause(indev_drv, data);
+}
+
+/**
+ * Sleep until an SDL event arrives, `sdl_wake_up()` is called or the timeout expires.
+ * It doesn't call LVGL so the LVGL lock needn't be held while waiting.
+ * @param timeout_ms the longest time to wait, typically the return value of `lv_timer_handler()`.
+ *                   `LV_NO_TIMER_READY`: wait without timeout
+ * @return true: an event is waiting to be handled; false: the timeout expired
+ */
+bool sdl_wait_event(uint32_t timeout_ms)
+{
+    if(timeout_ms == LV_NO_TIMER_READY) return SDL_WaitEvent(NULL) != 0;
+
+    if(timeout_ms > INT32_MAX) timeout_ms = INT32_MAX;
+    return SDL_WaitEventTimeout(NULL, (int)timeout_ms) != 0;
+}
+
+/**
+ * Wake up `sdl_wait_event()`, e.g. after `lv_async_call()` from an other thread.
+ * It's safe to call from any thread.
+ */
+void sdl_wake_up(void)
+{
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    SDL_PushEvent(&event);
+}
+
+/**
+ * Make the SDL input devices read in the next `lv_timer_handler()` if `event` is an input event.
+ * This way an input is processed immediately even if the read timers would wait for their period.
+ * It also resumes the read timers paused while the input devices were idle.
+ * @param event describes the event
+ */
+void indev_read_ready(SDL_Event * event)
+{
+    switch(event->type) {
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEWHEEL:
+        case SDL_FINGERUP:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERMOTION:
+        case SDL_KEYDOWN:
+        case SDL_TEXTINPUT:
+            break;
+        default:
+            return;
+    }
+
+    lv_indev_t * indev = lv_indev_get_next(NULL);
+    while(indev) {
+        lv_indev_drv_t * drv = indev->driver;
+        if(drv->read_timer &&
+           (drv->read_cb == sdl_mouse_read || drv->read_cb == sdl_mousewheel_read || drv->read_cb == sdl_keyboard_read)) {
+            lv_timer_resume(drv->read_timer);
+            lv_timer_ready(drv->read_timer);
+        }
+        indev = lv_indev_get_next(indev);
+    }
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Pause the read timer of an SDL input device if it has nothing to process until the next input event.
+ * A released pointer is still read while its scroll is being thrown.
+ * `indev_read_ready()` resumes the timer when an input event arrives.
+ * @param indev_drv pointer to the related input device driver
+ * @param data the data just read
+ */
+static void indev_read_pause(lv_indev_drv_t * indev_drv, const lv_indev_data_t * data)
+{
+    if(indev_drv->read_timer == NULL) return;
+    if(data->state != LV_INDEV_STATE_RELEASED || data->continue_reading || data->enc_diff) return;
+
+    lv_indev_t * indev = lv_indev_get_next(NULL);
+    while(indev && indev->driver != indev_drv) indev = lv_indev_get_next(indev);
+    if(indev == NULL) return;
+
+    /*The release has to be processed first*/
+    if(indev->proc.state != LV_INDEV_STATE_RELEASED) return;
+    if(indev_drv->type == LV_INDEV_TYPE_POINTER && indev->proc.types.pointer.scroll_obj) return;
+
+    lv_timer_pause(indev_drv->read_timer);
+}
+
 int quit_filter(void * userdata, SDL_Event * event)
 {
     (void)userdata;
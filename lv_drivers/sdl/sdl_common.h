@@ -84,6 +84,28 @@ void sdl_mousewheel_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
  */
 void sdl_keyboard_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
 
+/**
+ * Sleep until an SDL event arrives, `sdl_wake_up()` is called or the timeout expires.
+ * It doesn't call LVGL so the LVGL lock needn't be held while waiting.
+ * @param timeout_ms the longest time to wait, typically the return value of `lv_timer_handler()`.
+ *                   `LV_NO_TIMER_READY`: wait without timeout
+ * @return true: an event is waiting to be handled; false: the timeout expired
+ */
+bool sdl_wait_event(uint32_t timeout_ms);
+
+/**
+ * Wake up `sdl_wait_event()`, e.g. after `lv_async_call()` from an other thread.
+ * It's safe to call from any thread.
+ */
+void sdl_wake_up(void);
+
+/**
+ * Handle the pending SDL events now and make the SDL input devices read them in the next `lv_timer_handler()`.
+ * Call it before `lv_timer_handler()` when `sdl_wait_event()` is used.
+ * After the first call the events are not polled by a timer anymore.
+ */
+void sdl_handle_events(void);
+
 #endif /* USE_SDL || USE_SDL_GPU */
 
 #ifdef __cplusplus
@@ -29,6 +29,7 @@ void mouse_handler(SDL_Event * event);
 void mousewheel_handler(SDL_Event * event);
 uint32_t keycode_to_ctrl_key(SDL_Keycode sdl_key);
 void keyboard_handler(SDL_Event * event);
+void indev_read_ready(SDL_Event * event);
 
 #endif /* USE_SDL || USE_SDL_GPU */
 
@@ -65,6 +65,7 @@ static void sdl_event_handler(lv_timer_t * t);
  ***********************/
 
 static volatile bool sdl_inited = false;
+static lv_timer_t * event_timer;
 
 
 /**********************
@@ -86,7 +87,23 @@ void sdl_init(void)
 
     SDL_StartTextInput();
 
-    lv_timer_create(sdl_event_handler, 1, NULL);
+    event_timer = lv_timer_create(sdl_event_handler, 1, NULL);
+}
+
+/**
+ * Handle the pending SDL events now and make the SDL input devices read them in the next `lv_timer_handler()`.
+ * Call it before `lv_timer_handler()` when `sdl_wait_event()` is used.
+ * After the first call the events are not polled by a timer anymore.
+ */
+void sdl_handle_events(void)
+{
+    /*The events are handled right after waking up so polling them is not required*/
+    if(event_timer) {
+        lv_timer_del(event_timer);
+        event_timer = NULL;
+    }
+
+    sdl_event_handler(NULL);
 }
 
 void sdl_disp_drv_init(lv_disp_drv_t * disp_drv, lv_coord_t hor_res, lv_coord_t ver_res)
@@ -174,6 +191,7 @@ static void sdl_event_handler(lv_timer_t * t)
         mouse_handler(&event);
         mousewheel_handler(&event);
         keyboard_handler(&event);
+        indev_read_ready(&event);
 
         switch (event.type) {
             case SDL_WINDOWEVENT: {
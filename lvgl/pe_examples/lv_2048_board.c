@@ -0,0 +1,573 @@
+/**
+ * @file lv_2048_board.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_2048_board.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_2048_board_class
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A tile text pre-rendered to an A8 image, drawn with the text color as recolor*/
+typedef struct {
+    const lv_font_t * font;
+    uint8_t exp;
+    lv_img_dsc_t img;       /*`img.data == NULL` marks a free slot*/
+} glyph_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_2048_board_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_2048_board_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_2048_board_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static void get_tile_area(lv_obj_t * obj, uint32_t index, lv_area_t * area);
+static void invalidate_tile(lv_obj_t * obj, uint32_t index);
+static bool alloc_fx(lv_2048_board_t * board);
+static lv_coord_t get_ext_draw_size(lv_obj_t * obj);
+static const lv_img_dsc_t * glyph_cache_get(uint8_t exp, const lv_font_t * font);
+static void glyph_cache_free(void);
+static void draw_tile_text(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, const lv_img_dsc_t * img,
+                           lv_color_t text_color, uint16_t zoom);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_2048_board_class  = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = lv_2048_board_constructor,
+    .destructor_cb = lv_2048_board_destructor,
+    .event_cb = lv_2048_board_event,
+    .width_def = LV_DPI_DEF * 2,
+    .height_def = LV_DPI_DEF * 2,
+    .instance_size = sizeof(lv_2048_board_t),
+};
+
+static const char * const exp_texts[LV_2048_BOARD_EXP_CNT] = {"", "2", "4", "8", "16", "32", "64", "128", "256",
+                                                              "512", "1024", "2048", "4096", "8192", "16384", "32768"
+                                                             };
+
+static glyph_cache_entry_t glyph_cache[LV_2048_BOARD_GLYPH_CACHE_SIZE];
+static uint32_t glyph_cache_evict;     /*Next slot to reuse when the cache is full*/
+static uint32_t board_cnt;             /*Number of existing boards, the glyph cache is freed with the last one*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_2048_board_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_2048_board_set_grid(lv_obj_t * obj, uint8_t n)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    if(n < 1 || n > LV_2048_BOARD_MAX_N) return;
+
+    uint8_t * cells = lv_mem_alloc(n * n);
+    LV_ASSERT_MALLOC(cells);
+    if(cells == NULL) return;
+    lv_memset_00(cells, n * n);
+
+    lv_2048_board_reset_fx(obj);
+    lv_mem_free(board->cells);
+    board->cells = cells;
+    board->n = n;
+    lv_obj_refresh_ext_draw_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_2048_board_set_tile_dscs(lv_obj_t * obj, const lv_2048_board_tile_dsc_t * dscs, uint8_t cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    board->tile_dscs = cnt ? dscs : NULL;
+    board->tile_dsc_cnt = cnt;
+    lv_obj_invalidate(obj);
+}
+
+void lv_2048_board_set_cell(lv_obj_t * obj, uint32_t index, uint8_t exp)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    if(index >= (uint32_t)board->n * board->n) return;
+    if(board->cells[index] == exp) return;
+
+    board->cells[index] = exp;
+    invalidate_tile(obj, index);
+}
+
+void lv_2048_board_set_cells(lv_obj_t * obj, const uint8_t * cells)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    uint32_t cnt = (uint32_t)board->n * board->n;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_2048_board_set_cell(obj, i, cells[i]);
+    }
+}
+
+void lv_2048_board_set_tile_offset(lv_obj_t * obj, uint32_t index, lv_coord_t x, lv_coord_t y)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    if(index >= (uint32_t)board->n * board->n) return;
+    if(board->fx == NULL) {
+        if(x == 0 && y == 0) return;
+        if(!alloc_fx(board)) return;
+    }
+
+    lv_2048_board_fx_t * fx = &board->fx[index];
+    if(fx->ofs_x == x && fx->ofs_y == y) return;
+
+    /*The cell itself changes too: it shows an empty tile while its tile is away*/
+    lv_area_t cell_area;
+    lv_2048_board_get_cell_area(obj, index, &cell_area);
+    lv_obj_invalidate_area(obj, &cell_area);
+
+    invalidate_tile(obj, index);
+    fx->ofs_x = x;
+    fx->ofs_y = y;
+    invalidate_tile(obj, index);
+}
+
+void lv_2048_board_set_tile_zoom(lv_obj_t * obj, uint32_t index, uint16_t zoom)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    if(index >= (uint32_t)board->n * board->n) return;
+    if(board->fx == NULL) {
+        if(zoom == LV_IMG_ZOOM_NONE) return;
+        if(!alloc_fx(board)) return;
+    }
+
+    lv_2048_board_fx_t * fx = &board->fx[index];
+    zoom = LV_MIN(zoom, LV_2048_BOARD_ZOOM_MAX);
+    if(fx->zoom == zoom) return;
+
+    invalidate_tile(obj, index);
+    fx->zoom = zoom;
+    invalidate_tile(obj, index);
+}
+
+void lv_2048_board_reset_fx(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    if(board->fx == NULL) return;
+
+    uint32_t cnt = (uint32_t)board->n * board->n;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        if(board->fx[i].ofs_x || board->fx[i].ofs_y || board->fx[i].zoom != LV_IMG_ZOOM_NONE) {
+            lv_area_t cell_area;
+            lv_2048_board_get_cell_area(obj, i, &cell_area);
+            lv_obj_invalidate_area(obj, &cell_area);
+            invalidate_tile(obj, i);
+        }
+    }
+
+    lv_mem_free(board->fx);
+    board->fx = NULL;
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+uint8_t lv_2048_board_get_cell(const lv_obj_t * obj, uint32_t index)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    const lv_2048_board_t * board = (const lv_2048_board_t *)obj;
+
+    if(index >= (uint32_t)board->n * board->n) return 0;
+    return board->cells[index];
+}
+
+uint8_t lv_2048_board_get_grid(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    const lv_2048_board_t * board = (const lv_2048_board_t *)obj;
+    return board->n;
+}
+
+lv_coord_t lv_2048_board_get_cell_step(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    lv_coord_t gap = lv_obj_get_style_pad_column(obj, LV_PART_MAIN);
+    lv_coord_t w = lv_obj_get_content_width(obj);
+    return (w - (board->n - 1) * gap) / board->n + gap;
+}
+
+void lv_2048_board_get_cell_area(lv_obj_t * obj, uint32_t index, lv_area_t * area)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    lv_coord_t gap_x = lv_obj_get_style_pad_column(obj, LV_PART_MAIN);
+    lv_coord_t gap_y = lv_obj_get_style_pad_row(obj, LV_PART_MAIN);
+    lv_coord_t w = (lv_area_get_width(&content) - (board->n - 1) * gap_x) / board->n;
+    lv_coord_t h = (lv_area_get_height(&content) - (board->n - 1) * gap_y) / board->n;
+    lv_coord_t row = (lv_coord_t)(index / board->n);
+    lv_coord_t col = (lv_coord_t)(index % board->n);
+
+    area->x1 = content.x1 + col * (w + gap_x);
+    area->y1 = content.y1 + row * (h + gap_y);
+    area->x2 = area->x1 + w - 1;
+    area->y2 = area->y1 + h - 1;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_2048_board_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+    board->n = 0;
+    board->cells = NULL;
+    board->fx = NULL;
+    board->tile_dscs = NULL;
+    board->tile_dsc_cnt = 0;
+    board_cnt++;
+
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_2048_board_set_grid(obj, 4);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_2048_board_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    lv_mem_free(board->cells);
+    board->cells = NULL;
+    lv_mem_free(board->fx);
+    board->fx = NULL;
+
+    board_cnt--;
+    if(board_cnt == 0) glyph_cache_free();
+}
+
+static void lv_2048_board_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+    else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        lv_event_set_ext_draw_size(e, get_ext_draw_size(obj));
+    }
+    else if(code == LV_EVENT_SIZE_CHANGED) {
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+}
+
+static void draw_tile(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, lv_draw_rect_dsc_t * rect_dsc,
+                      const lv_area_t * area, uint8_t exp, uint16_t zoom)
+{
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+
+    /*Most of the time only a few tiles are dirty, skip the others early*/
+    if(!_lv_area_is_on(area, draw_ctx->clip_area)) return;
+
+    lv_color_t text_color;
+    const lv_font_t * font;
+    if(board->tile_dscs) {
+        const lv_2048_board_tile_dsc_t * dsc = &board->tile_dscs[LV_MIN(exp, board->tile_dsc_cnt - 1)];
+        rect_dsc->bg_color = dsc->bg_color;
+        text_color = dsc->text_color;
+        font = dsc->font;
+    }
+    else {
+        text_color = lv_obj_get_style_text_color(obj, LV_PART_ITEMS);
+        font = lv_obj_get_style_text_font(obj, LV_PART_ITEMS);
+    }
+    lv_draw_rect(draw_ctx, rect_dsc, area);
+
+    if(exp == 0 || exp >= LV_2048_BOARD_EXP_CNT) return;
+
+    /*The glyph cache is shared by all rendering threads and evicting from it invalidates the image cache,
+     *so keep the image until it's drawn*/
+    _lv_img_cache_lock();
+    const lv_img_dsc_t * img = glyph_cache_get(exp, font);
+    if(img) draw_tile_text(draw_ctx, area, img, text_color, zoom);
+    _lv_img_cache_unlock();
+}
+
+static void draw_tile_text(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, const lv_img_dsc_t * img,
+                           lv_color_t text_color, uint16_t zoom)
+{
+
+    /*A8 images can't be zoomed (the decoder falls back to line by line reading which ignores zoom),
+     *so the text keeps its size and is clipped to the zoomed tile instead*/
+    lv_coord_t w = img->header.w;
+    lv_coord_t h = img->header.h;
+    lv_area_t txt_area;
+    txt_area.x1 = area->x1 + (lv_area_get_width(area) - w) / 2;
+    txt_area.y1 = area->y1 + (lv_area_get_height(area) - h) / 2;
+    txt_area.x2 = txt_area.x1 + w - 1;
+    txt_area.y2 = txt_area.y1 + h - 1;
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, draw_ctx->clip_area, area)) return;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    if(zoom < LV_IMG_ZOOM_NONE) draw_ctx->clip_area = &clip_area;
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    img_dsc.recolor = text_color;
+    lv_draw_img(draw_ctx, &img_dsc, &txt_area, img);
+
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    if(board->cells == NULL) return;
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_ITEMS, &rect_dsc);
+
+    uint32_t cnt = (uint32_t)board->n * board->n;
+    uint32_t i;
+    lv_area_t area;
+
+    /*Tiles in their cells first. A shifted tile leaves an empty tile behind.*/
+    for(i = 0; i < cnt; i++) {
+        lv_2048_board_fx_t * fx = board->fx ? &board->fx[i] : NULL;
+        if(fx && (fx->ofs_x || fx->ofs_y)) {
+            lv_2048_board_get_cell_area(obj, i, &area);
+            draw_tile(draw_ctx, obj, &rect_dsc, &area, 0, LV_IMG_ZOOM_NONE);
+        }
+        else {
+            get_tile_area(obj, i, &area);
+            draw_tile(draw_ctx, obj, &rect_dsc, &area, board->cells[i], fx ? fx->zoom : LV_IMG_ZOOM_NONE);
+        }
+    }
+
+    /*Shifted (sliding) tiles above the others*/
+    if(board->fx) {
+        for(i = 0; i < cnt; i++) {
+            lv_2048_board_fx_t * fx = &board->fx[i];
+            if(fx->ofs_x == 0 && fx->ofs_y == 0) continue;
+            get_tile_area(obj, i, &area);
+            draw_tile(draw_ctx, obj, &rect_dsc, &area, board->cells[i], fx->zoom);
+        }
+    }
+}
+
+/*The area where the tile of a cell is drawn, with its offset and zoom*/
+static void get_tile_area(lv_obj_t * obj, uint32_t index, lv_area_t * area)
+{
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+    lv_2048_board_get_cell_area(obj, index, area);
+    if(board->fx == NULL) return;
+
+    lv_2048_board_fx_t * fx = &board->fx[index];
+    lv_area_move(area, fx->ofs_x, fx->ofs_y);
+    if(fx->zoom != LV_IMG_ZOOM_NONE) {
+        lv_coord_t w = lv_area_get_width(area);
+        lv_coord_t h = lv_area_get_height(area);
+        lv_coord_t zw = (lv_coord_t)(((int32_t)w * fx->zoom) >> 8);
+        lv_coord_t zh = (lv_coord_t)(((int32_t)h * fx->zoom) >> 8);
+        area->x1 += (w - zw) / 2;
+        area->y1 += (h - zh) / 2;
+        area->x2 = area->x1 + zw - 1;
+        area->y2 = area->y1 + zh - 1;
+    }
+}
+
+static void invalidate_tile(lv_obj_t * obj, uint32_t index)
+{
+    lv_area_t area;
+    get_tile_area(obj, index, &area);
+    lv_obj_invalidate_area(obj, &area);
+}
+
+static bool alloc_fx(lv_2048_board_t * board)
+{
+    uint32_t cnt = (uint32_t)board->n * board->n;
+    board->fx = lv_mem_alloc(cnt * sizeof(lv_2048_board_fx_t));
+    LV_ASSERT_MALLOC(board->fx);
+    if(board->fx == NULL) return false;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        board->fx[i].ofs_x = 0;
+        board->fx[i].ofs_y = 0;
+        board->fx[i].zoom = LV_IMG_ZOOM_NONE;
+    }
+    return true;
+}
+
+/*How far a tile zoomed to the limit can reach out of the board. Fixed for a given size so
+ *zooming a tile never changes it, which would invalidate the whole board.*/
+static lv_coord_t get_ext_draw_size(lv_obj_t * obj)
+{
+    lv_2048_board_t * board = (lv_2048_board_t *)obj;
+    if(board->n == 0) return 0;
+
+    lv_area_t cell_area;
+    lv_2048_board_get_cell_area(obj, 0, &cell_area);
+    lv_coord_t w = LV_MAX(lv_area_get_width(&cell_area), lv_area_get_height(&cell_area));
+    if(w <= 0) return 0;
+    return (lv_coord_t)((((int32_t)w * (LV_2048_BOARD_ZOOM_MAX - LV_IMG_ZOOM_NONE)) >> 9) + 1);
+}
+
+/*Render `txt` into an A8 image: one line, `font->line_height` tall, as wide as the text*/
+static bool glyph_render(glyph_cache_entry_t * entry, const char * txt, const lv_font_t * font)
+{
+    lv_coord_t w = 0;
+    uint32_t i;
+    for(i = 0; txt[i] != '\0'; i++) {
+        w += lv_font_get_glyph_width(font, (uint8_t)txt[i], (uint8_t)txt[i + 1]);
+    }
+    lv_coord_t h = lv_font_get_line_height(font);
+    if(w <= 0 || h <= 0) return false;
+
+    uint8_t * buf = lv_mem_alloc((uint32_t)w * h);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return false;
+    lv_memset_00(buf, (uint32_t)w * h);
+
+    lv_coord_t pen_x = 0;
+    for(i = 0; txt[i] != '\0'; i++) {
+        uint32_t letter = (uint8_t)txt[i];
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, (uint8_t)txt[i + 1])) continue;
+        const lv_font_t * font_glyph = g.resolved_font ? g.resolved_font : font;
+        const uint8_t * bitmap = lv_font_get_glyph_bitmap(font_glyph, letter);
+        uint8_t bpp = g.bpp == 3 ? 4 : g.bpp;   /*Compressed 3 bpp glyphs are decompressed to 4 bpp*/
+        if(bitmap && bpp > 0 && bpp <= 8) {
+            /*Same placement as the letter drawing: `ofs_y` is measured from the baseline*/
+            lv_coord_t x0 = pen_x + g.ofs_x;
+            lv_coord_t y0 = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+            uint32_t bit = 0;
+            uint8_t mask = (uint8_t)((1 << bpp) - 1);
+            lv_coord_t y;
+            for(y = 0; y < g.box_h; y++) {
+                lv_coord_t x;
+                for(x = 0; x < g.box_w; x++, bit += bpp) {
+                    /*Glyph bitmaps are packed without row padding, MSB first*/
+                    uint8_t v = (uint8_t)((bitmap[bit >> 3] >> (8 - bpp - (bit & 7))) & mask);
+                    lv_coord_t px = x0 + x;
+                    lv_coord_t py = y0 + y;
+                    if(v == 0 || px < 0 || px >= w || py < 0 || py >= h) continue;
+                    buf[py * w + px] = (uint8_t)(v * 255 / mask);
+                }
+            }
+        }
+        pen_x += g.adv_w;
+    }
+
+    entry->font = font;
+    lv_memset_00(&entry->img, sizeof(lv_img_dsc_t));
+    entry->img.header.always_zero = 0;
+    entry->img.header.cf = LV_IMG_CF_ALPHA_8BIT;
+    entry->img.header.w = w;
+    entry->img.header.h = h;
+    entry->img.data_size = (uint32_t)w * h;
+    entry->img.data = buf;
+    return true;
+}
+
+/*Get the pre-rendered text of an exponent with a font, render it on the first use*/
+static const lv_img_dsc_t * glyph_cache_get(uint8_t exp, const lv_font_t * font)
+{
+    glyph_cache_entry_t * free_entry = NULL;
+    uint32_t i;
+    for(i = 0; i < LV_2048_BOARD_GLYPH_CACHE_SIZE; i++) {
+        glyph_cache_entry_t * entry = &glyph_cache[i];
+        if(entry->img.data == NULL) {
+            if(free_entry == NULL) free_entry = entry;
+        }
+        else if(entry->exp == exp && entry->font == font) {
+            return &entry->img;
+        }
+    }
+
+    if(free_entry == NULL) {
+        free_entry = &glyph_cache[glyph_cache_evict];
+        glyph_cache_evict = (glyph_cache_evict + 1) % LV_2048_BOARD_GLYPH_CACHE_SIZE;
+        /*The image cache may still hold the old data pointer*/
+        lv_img_cache_invalidate_src(&free_entry->img);
+        lv_mem_free((void *)free_entry->img.data);
+        free_entry->img.data = NULL;
+    }
+
+    free_entry->exp = exp;
+    if(!glyph_render(free_entry, exp_texts[exp], font)) return NULL;
+    return &free_entry->img;
+}
+
+/*Free all pre-rendered texts*/
+static void glyph_cache_free(void)
+{
+    _lv_img_cache_lock();
+    uint32_t i;
+    for(i = 0; i < LV_2048_BOARD_GLYPH_CACHE_SIZE; i++) {
+        glyph_cache_entry_t * entry = &glyph_cache[i];
+        if(entry->img.data == NULL) continue;
+        /*The image cache may still hold the data pointer*/
+        lv_img_cache_invalidate_src(&entry->img);
+        lv_mem_free((void *)entry->img.data);
+        entry->img.data = NULL;
+    }
+    glyph_cache_evict = 0;
+    _lv_img_cache_unlock();
+}
@@ -0,0 +1,178 @@
+/**
+ * @file lv_2048_board.h
+ *
+ */
+
+#ifndef LV_2048_BOARD_H
+#define LV_2048_BOARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_2048_BOARD_MAX_N         8
+#define LV_2048_BOARD_EXP_CNT       16  /**< Exponents 0 (empty) .. 15 (32768)*/
+
+/** Largest tile zoom. The board reserves room around itself for tiles zoomed this much.*/
+#ifndef LV_2048_BOARD_ZOOM_MAX
+#define LV_2048_BOARD_ZOOM_MAX 320
+#endif
+
+/** Number of pre-rendered tile texts kept at once (one per exponent and font)*/
+#ifndef LV_2048_BOARD_GLYPH_CACHE_SIZE
+#define LV_2048_BOARD_GLYPH_CACHE_SIZE 32
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Look of the tiles of one exponent*/
+typedef struct {
+    lv_color_t bg_color;
+    lv_color_t text_color;
+    const lv_font_t * font;
+} lv_2048_board_tile_dsc_t;
+
+/** Animation state of one tile, only allocated while the board has been animated*/
+typedef struct {
+    lv_coord_t ofs_x;   /**< Drawn this far from its cell*/
+    lv_coord_t ofs_y;
+    uint16_t zoom;      /**< 256: normal size*/
+} lv_2048_board_fx_t;
+
+/*Data of 2048 board*/
+typedef struct {
+    lv_obj_t obj;
+    uint8_t n;                                  /**< Cells per side*/
+    uint8_t * cells;                            /**< n*n exponents, row by row*/
+    lv_2048_board_fx_t * fx;                    /**< n*n tile animation states or NULL*/
+    const lv_2048_board_tile_dsc_t * tile_dscs; /**< Per exponent look or NULL to use LV_PART_ITEMS*/
+    uint8_t tile_dsc_cnt;
+} lv_2048_board_t;
+
+extern const lv_obj_class_t lv_2048_board_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a 2048 board object. The tiles are drawn by the board itself from an exponent array,
+ * so a board is a single object however many cells it has.
+ * `LV_PART_MAIN` is the background, `pad_row/column` is the gap between the tiles,
+ * `LV_PART_ITEMS` styles the tiles.
+ * @param parent    pointer to an object, it will be the parent of the new board
+ * @return          pointer to the created board
+ */
+lv_obj_t * lv_2048_board_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the number of cells per side. Clears all cells.
+ * @param obj       pointer to a board object
+ * @param n         cells per side (1..LV_2048_BOARD_MAX_N)
+ */
+void lv_2048_board_set_grid(lv_obj_t * obj, uint8_t n);
+
+/**
+ * Set the look of the tiles per exponent. Exponents without a descriptor use the last one.
+ * @param obj       pointer to a board object
+ * @param dscs      array of `cnt` descriptors indexed by exponent, only the pointer is saved
+ * @param cnt       number of descriptors
+ */
+void lv_2048_board_set_tile_dscs(lv_obj_t * obj, const lv_2048_board_tile_dsc_t * dscs, uint8_t cnt);
+
+/**
+ * Set the exponent of a cell. Only the area of the cell is invalidated, and only if it has changed.
+ * @param obj       pointer to a board object
+ * @param index     row * n + col
+ * @param exp       0: empty, 1: 2, 2: 4 ... 15: 32768
+ */
+void lv_2048_board_set_cell(lv_obj_t * obj, uint32_t index, uint8_t exp);
+
+/**
+ * Set the exponent of all cells
+ * @param obj       pointer to a board object
+ * @param cells     n*n exponents, row by row
+ */
+void lv_2048_board_set_cells(lv_obj_t * obj, const uint8_t * cells);
+
+/**
+ * Draw the tile of a cell shifted from its place, e.g. while sliding.
+ * Shifted tiles are drawn above the others and leave an empty cell behind.
+ * @param obj       pointer to a board object
+ * @param index     row * n + col
+ * @param x         horizontal shift in pixels
+ * @param y         vertical shift in pixels
+ */
+void lv_2048_board_set_tile_offset(lv_obj_t * obj, uint32_t index, lv_coord_t x, lv_coord_t y);
+
+/**
+ * Scale the tile of a cell around its center. The text keeps its size, a shrunk tile clips it.
+ * @param obj       pointer to a board object
+ * @param index     row * n + col
+ * @param zoom      256: normal size, 128: half, at most LV_2048_BOARD_ZOOM_MAX
+ */
+void lv_2048_board_set_tile_zoom(lv_obj_t * obj, uint32_t index, uint16_t zoom);
+
+/**
+ * Put every tile back to its cell with normal size
+ * @param obj       pointer to a board object
+ */
+void lv_2048_board_reset_fx(lv_obj_t * obj);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the exponent of a cell
+ * @param obj       pointer to a board object
+ * @param index     row * n + col
+ * @return          the exponent, 0 if empty
+ */
+uint8_t lv_2048_board_get_cell(const lv_obj_t * obj, uint32_t index);
+
+/**
+ * Get the number of cells per side
+ * @param obj       pointer to a board object
+ * @return          cells per side
+ */
+uint8_t lv_2048_board_get_grid(const lv_obj_t * obj);
+
+/**
+ * Get the distance between the origins of two neighbouring cells (tile size + gap)
+ * @param obj       pointer to a board object
+ * @return          the distance in pixels
+ */
+lv_coord_t lv_2048_board_get_cell_step(lv_obj_t * obj);
+
+/**
+ * Get the area of a cell in absolute coordinates, ignoring offset and zoom
+ * @param obj       pointer to a board object
+ * @param index     row * n + col
+ * @param area      store the area here
+ */
+void lv_2048_board_get_cell_area(lv_obj_t * obj, uint32_t index, lv_area_t * area);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_2048_BOARD_H*/
@@ -1,4 +1,7 @@
 #include "lvgl_2048.h"
+#include "lv_2048_board.h"
+#include "lvgl_2048_engine.h"
+#include "lvgl_2048_solver.h"
 #include "lvgl/examples/lv_examples.h"
 #include "lvgl/src/lv_conf_internal.h"
 #include <stdio.h>
@@ -8,61 +11,113 @@
 #define scr_act_width() lv_obj_get_width(lv_scr_act())   // 800
 #define scr_act_height() lv_obj_get_height(lv_scr_act()) // 480
 
-/* 游戏变量 */
-static int matrix[4][4] = {0};               // 棋盘状态（4×4数组，0表示空，非0表示数字）
-static lv_obj_t *tiles[4][4] = {0};          // 数字块对象数组，用于关联界面和逻辑
-static lv_obj_t *tile_labels[4][4] = {NULL}; // 4x4网格的标签指针
-static lv_obj_t *canvas;                     // 画布
-static lv_obj_t *msg_label;                  // 胜负提示标签
+/* 单步差异：一次移动及随后生成的数字中内容发生变化的格子 */
+typedef enum
+{
+    TILE_CHANGE_SLIDE = 0, // 数字移入或移出
+    TILE_CHANGE_MERGE,     // 合并得到的新数字
+    TILE_CHANGE_SPAWN,     // 新生成的数字
+} tile_change_type_t;
 
-int tile_size = 80;   // 每个格子的大小（需与棋盘线条布局匹配）
-int gap = 10;         // 格子之间的间隙
-int board_x = 20 + 5; // 棋盘在画布内的左上角x坐标
-int board_y = 20 + 5; // 棋盘在画布内的左上角y坐标
+typedef struct
+{
+    uint8_t row;
+    uint8_t col;
+    uint8_t type; // tile_change_type_t
+} tile_change_t;
+
+/* 移动动画：滑动 -> 合并弹跳/新数字放大，整步共用一个时间轴 */
+#define ANIM_SLIDE_TIME 100    // 滑动时长(ms)
+#define ANIM_POP_TIME 120      // 合并弹跳时长(ms)
+#define ANIM_POP_EXTRA 40      // 合并时最大放大量（256为原始大小）
+#define ANIM_SPAWN_TIME 120    // 新数字放大时长(ms)
+#define ANIM_SPAWN_ZOOM_MIN 32 // 新数字起始缩放
+#define ANIM_QUEUE_SIZE 8      // 动画期间最多排队的按键数
+
+#define BOARD_BORDER 2     // 棋盘边框宽度
+#define TILE_SMALL_SIZE 60 // 格子小于此尺寸时改用小字体
+#define TILE_DSC_CNT 12    // 0..2048，更大的数字共用2048的外观
+
+/* 动画对象：时间轴里的动画只能带一个指针，用它找到棋盘和格子 */
+typedef struct
+{
+    lvgl_2048_t *game;
+    uint8_t index; // 格子序号（行*n+列）
+} tile_ref_t;
+
+/* 棋盘实例：状态按最大边长分配，n只决定使用其中多少个格子 */
+struct _lvgl_2048_t
+{
+    uint8_t n;                                     // 棋盘边长
+    bool animate;                                  // 是否播放移动动画
+    lv_obj_t *board;                               // 棋盘控件（lv_2048_board），自己画所有格子
+    lv_obj_t *msg_label;                           // 胜负提示标签（可为NULL，不归棋盘所有）
+    uint8_t cells[LVGL_2048_MAX_CELLS];            // 棋盘状态：每格数字的指数，0表示空
+    tile_ref_t tile_refs[LVGL_2048_MAX_CELLS];     // 各格子的动画对象
+    tile_change_t diff[LVGL_2048_MAX_CELLS];       // 本步变化的格子
+    int diff_cnt;
+    lvgl_2048_move_trace_t trace;                  // 最近一次移动的轨迹
+    lv_anim_timeline_t *timeline;                  // 当前移动的动画时间轴，NULL表示空闲
+    int anim_committed;                            // 滑动阶段是否已结束（数字已刷新）
+    uint32_t anim_commit_progress;                 // 滑动结束对应的时间轴进度(0..0xFFFF)
+    lvgl_2048_dir_t move_queue[ANIM_QUEUE_SIZE];   // 动画期间排队的按键
+    int move_queue_cnt;
+    lvgl_2048_rng_t rng;                           // 生成新数字的随机数状态
+    lvgl_2048_replay_t log;                        // 本局记录
+};
+
+static lvgl_2048_t *default_game; // lvgl_2048_start创建的棋盘，按钮和旧接口操作它
+static lvgl_2048_t *hint_game;    // 正在等待提示结果的棋盘
+static int styles_ready = 0;      // 样式所有棋盘共用，只初始化一次
 
 // 声明所有样式（全局）
 static lv_style_t style_msg_label; // 自定义胜负提示标签的样式
-static lv_style_t style_tile_base; // 基础样式（所有格子共用）
-static lv_style_t style_tile_0;    // 空格子
-static lv_style_t style_tile_2;    // 数字2
-static lv_style_t style_tile_4;    // 数字4
-static lv_style_t style_tile_8;    // 数字8
-static lv_style_t style_tile_16;   // 数字16
-static lv_style_t style_tile_32;   // 数字32
-static lv_style_t style_tile_64;   // 数字64
-static lv_style_t style_tile_128;  // 数字128
-static lv_style_t style_tile_256;  // 数字256
-static lv_style_t style_tile_512;  // 数字512
-static lv_style_t style_tile_1024; // 数字1024
-static lv_style_t style_tile_2048; // 数字2048
+static lv_style_t style_board;     // 棋盘背景与边框
+static lv_style_t style_tile;      // 格子基本样式（所有格子共用）
+
+/* 各指数对应的格子外观：背景色、文字颜色、字体；小格子改用小字体 */
+static lv_2048_board_tile_dsc_t tile_dscs[TILE_DSC_CNT];
+static lv_2048_board_tile_dsc_t tile_dscs_small[TILE_DSC_CNT];
 
 /* 函数声明 */
-void debug_func(void);                           // 调试用
-void draw_2048_square(uint16_t big_square_side); // 画棋盘
-void init_2048_tile_styles(void);                // 生成所有样式
-void init_2048_tiles(void);                      // 初始化4×4格子，位置在棋盘内
-void init_2048_btn(void);                        // 画按钮
-int addRandomMatrix(void);                       // 随机matrix赋值2，等待界面同步
-void lvgl_2048_updateui(void);                   // 同步界面与matrix数据
-int moveLeft(void);                              // 左移
-int moveRight(void);                             // 右移
-int moveUp(void);                                // 上移
-int moveDown(void);                              // 下移
-int isGameOver(void);                            // 判断游戏结束
-int checkWin(void);                              // 判断胜利
-void show_message(const char *msg);              // 显示提示信息
+void debug_func(void);              // 调试用
+void init_2048_tile_styles(void);   // 生成所有样式
+void init_2048_btn(void);           // 画按钮
+int addRandomMatrix(void);          // 默认棋盘随机赋值2，等待界面同步
+void lvgl_2048_updateui(void);      // 同步默认棋盘界面与数据
+void lvgl_2048_apply_diff(void);    // 只同步默认棋盘本次移动变化的格子
+int moveLeft(void);                 // 左移
+int moveRight(void);                // 右移
+int moveUp(void);                   // 上移
+int moveDown(void);                 // 下移
+int isGameOver(void);               // 判断游戏结束
+int checkWin(void);                 // 判断胜利
+void show_message(const char *msg); // 显示提示信息
+static void hint_ready_cb(lvgl_2048_board_t board, int dir, void *user_data); // 提示搜索完成
+static int game_add_random(lvgl_2048_t *game);                               // 随机空格放入2
+static void game_update_ui(lvgl_2048_t *game);                               // 全量同步界面
+static void game_apply_diff(lvgl_2048_t *game);                              // 按差异同步界面
+static void game_diff_add(lvgl_2048_t *game, int row, int col, tile_change_type_t type); // 记录变化的格子
+static int game_move(lvgl_2048_t *game, lvgl_2048_dir_t dir, lvgl_2048_move_trace_t *trace); // 按方向移动
+static int game_is_over(const lvgl_2048_t *game);
+static int game_check_win(const lvgl_2048_t *game);
+static void game_show_message(lvgl_2048_t *game, const char *msg);
+static void game_do_move(lvgl_2048_t *game, lvgl_2048_dir_t dir, int animate); // 执行一次移动
 /*
  */
 
 void debug_func(void)
 {
-    for (int i = 0; i < 4; i++)
+    if (default_game == NULL)
+        return;
+    int n = default_game->n;
+    for (int i = 0; i < n; i++)
     {
-        for (int j = 0; j < 4; j++)
+        for (int j = 0; j < n; j++)
         {
-            if (matrix[i][j] != 0)
+            if (default_game->cells[i * n + j] != 0)
             {
-                LV_LOG_USER("test %d , %d was %d", i, j, matrix[i][j]);
+                LV_LOG_USER("test %d , %d was %d", i, j, lvgl_2048_exp_to_value(default_game->cells[i * n + j]));
             }
         }
     }
@@ -70,79 +125,177 @@ void debug_func(void)
 
 /* 主函数 */
 void lvgl_2048_start(void)
+{
+    lvgl_2048_start_seed((uint32_t)time(NULL)); // 默认用时间做种子，种子会记入对局记录
+}
+
+void lvgl_2048_start_seed(uint32_t seed)
 {
     /*init*/
-    srand((unsigned)time(NULL)); // 初始化随机数种子
-    draw_2048_square(360);       // 画棋盘
-    init_2048_tile_styles();     // 生成所有样式
-    init_2048_tiles();           // 初始化4×4格子，位置在棋盘内，初始化并隐藏胜利文本
-    init_2048_btn();             // 画按钮
-    addRandomMatrix();           // 随机数字2
-    addRandomMatrix();           // 随机数字2
-    lvgl_2048_updateui();        // 刷新数字与格子
+    lvgl_2048_cfg_t cfg;
+    lvgl_2048_cfg_init(&cfg);
+    cfg.seed = seed;
+    default_game = lvgl_2048_create(lv_scr_act(), &cfg); // 画棋盘和格子，随机数字2
+    if (default_game == NULL)
+        return;
+    lv_obj_center(lvgl_2048_get_obj(default_game));
+
+    // 创建胜负提示标签（初始为空）
+    lv_obj_t *msg_label = lv_label_create(lv_scr_act());
+    lv_obj_add_style(msg_label, &style_msg_label, 0); // 使用自定义样式
+    lv_obj_align(msg_label, LV_ALIGN_TOP_MID, 0, 5);
+    lv_label_set_text(msg_label, "");
+    lvgl_2048_set_msg_label(default_game, msg_label);
+
+    init_2048_btn(); // 画按钮
+}
+
+void lvgl_2048_cfg_init(lvgl_2048_cfg_t *cfg)
+{
+    cfg->n = 4;
+    cfg->size = 360;
+    cfg->gap = 10;
+    cfg->seed = 0;
+    cfg->animate = true;
+}
+
+/* 棋盘对象删除时释放实例（由lvgl_2048_delete或删除父对象触发） */
+static void board_delete_cb(lv_event_t *e)
+{
+    lvgl_2048_t *game = lv_event_get_user_data(e);
+    if (game->timeline != NULL)
+    {
+        lv_anim_del(game, NULL);
+        lv_anim_timeline_del(game->timeline); // 会删除以tile_refs为对象的动画
+    }
+    lvgl_2048_replay_free(&game->log);
+    if (hint_game == game)
+        hint_game = NULL;
+    if (default_game == game)
+        default_game = NULL;
+    lv_mem_free(game);
+}
+
+lvgl_2048_t *lvgl_2048_create(lv_obj_t *parent, const lvgl_2048_cfg_t *cfg)
+{
+    if (cfg->n < LVGL_2048_MIN_N || cfg->n > LVGL_2048_MAX_N)
+        return NULL;
+    lv_coord_t tile_size = (lv_coord_t)(cfg->size / cfg->n - cfg->gap);
+    if (tile_size <= 0)
+        return NULL;
+
+    lvgl_2048_t *game = lv_mem_alloc(sizeof(lvgl_2048_t));
+    LV_ASSERT_MALLOC(game);
+    if (game == NULL)
+        return NULL;
+    lv_memset_00(game, sizeof(lvgl_2048_t));
+    game->n = cfg->n;
+    game->animate = cfg->animate;
+
+    lvgl_2048_engine_init();                  // 预计算行移动表
+    lvgl_2048_rng_seed(&game->rng, cfg->seed); // 初始化随机数种子
+    lvgl_2048_replay_init(&game->log, cfg->seed);
+    init_2048_tile_styles(); // 生成所有样式
+
+    /* 棋盘：一个控件按格子数组画出所有格子，只有变化的格子会被重绘 */
+    game->board = lv_2048_board_create(parent);
+    lv_obj_remove_style_all(game->board);
+    lv_obj_add_style(game->board, &style_board, 0);
+    lv_obj_add_style(game->board, &style_tile, LV_PART_ITEMS);
+    lv_obj_set_style_pad_all(game->board, LV_MAX(cfg->gap / 2 - BOARD_BORDER, 0), 0); // 外圈留半个间隙
+    lv_obj_set_style_pad_gap(game->board, cfg->gap, 0);
+    lv_obj_set_size(game->board, cfg->size, cfg->size);
+    lv_2048_board_set_grid(game->board, cfg->n);
+    lv_2048_board_set_tile_dscs(game->board, tile_size < TILE_SMALL_SIZE ? tile_dscs_small : tile_dscs, TILE_DSC_CNT);
+    lv_obj_add_event_cb(game->board, board_delete_cb, LV_EVENT_DELETE, game);
+
+    for (int k = 0; k < cfg->n * cfg->n; k++)
+    {
+        game->tile_refs[k].game = game;
+        game->tile_refs[k].index = (uint8_t)k;
+    }
+    game_add_random(game);  // 随机数字2
+    game_add_random(game);  // 随机数字2
+    game_update_ui(game);   // 刷新数字与格子
+    return game;
+}
+
+void lvgl_2048_delete(lvgl_2048_t *game)
+{
+    lv_obj_del(game->board); // 实例在LV_EVENT_DELETE中释放
+}
+
+lv_obj_t *lvgl_2048_get_obj(lvgl_2048_t *game)
+{
+    return game->board;
+}
+
+lvgl_2048_t *lvgl_2048_get_default(void)
+{
+    return default_game;
+}
+
+void lvgl_2048_set_msg_label(lvgl_2048_t *game, lv_obj_t *label)
+{
+    game->msg_label = label;
+}
+
+int lvgl_2048_get_exp(const lvgl_2048_t *game, int row, int col)
+{
+    return game->cells[row * game->n + col];
+}
+
+const lvgl_2048_replay_t *lvgl_2048_get_replay(const lvgl_2048_t *game)
+{
+    return &game->log;
+}
+
+/* 载入对局记录：无界面快进后一次性刷新界面，之后可以接着玩
+ * return:1是成功，0是动画播放中、棋盘不是4×4或内存不足 */
+int lvgl_2048_load_replay(lvgl_2048_t *game, const lvgl_2048_replay_t *log, uint32_t move_cnt)
+{
+    if (game->timeline != NULL || game->n != 4)
+        return 0;
+
+    lvgl_2048_rng_t rng;
+    uint32_t applied;
+    lvgl_2048_board_t board = lvgl_2048_replay_run(log, move_cnt, &rng, &applied);
+
+    lvgl_2048_replay_t copy;
+    lvgl_2048_replay_init(&copy, log->seed);
+    for (uint32_t i = 0; i < applied; i++)
+    {
+        if (!lvgl_2048_replay_record(&copy, lvgl_2048_replay_get(log, i)))
+        {
+            lvgl_2048_replay_free(&copy);
+            return 0;
+        }
+    }
+    lvgl_2048_replay_free(&game->log);
+    game->log = copy;
+    game->rng = rng;
+    game->move_queue_cnt = 0;
+
+    lvgl_2048_board_to_grid(board, game->cells);
+    game_update_ui(game);
+    game_show_message(game, game_check_win(game) ? "win" : (game_is_over(game) ? "ending" : ""));
+    return 1;
 }
 /* init */
-void draw_2048_square(uint16_t big_square_side) // 画棋盘
-{
-    /* 整体画布 */
-    static lv_color_t canvas_buf[LV_CANVAS_BUF_SIZE_TRUE_COLOR(450, 450)];    // 200x150真彩色缓冲区
-    canvas = lv_canvas_create(lv_scr_act());                                  // 在屏幕创建画布
-    lv_canvas_set_buffer(canvas, canvas_buf, 400, 400, LV_IMG_CF_TRUE_COLOR); // 绑定缓冲区
-    lv_obj_center(canvas);
-
-    /* 棋盘 */
-    // 2. 初始化矩形绘制描述符（关键：必须先init）
-    lv_draw_rect_dsc_t rect_dsc;
-    lv_draw_rect_dsc_init(&rect_dsc);
-
-    // 3. 配置矩形样式（按需调整，以下为常用属性）
-    rect_dsc.radius = 8;                        // 圆角半径（0=直角）
-    rect_dsc.bg_color = lv_color_hex(0x03A9F4); // 背景色（青色）
-    rect_dsc.bg_opa = LV_OPA_80;                // 背景不透明度（80%，0=透明，255=完全不透明）
-    rect_dsc.border_width = 2;                  // 边框宽度（0=无边框）
-    rect_dsc.border_color = lv_color_white();   // 边框颜色（白色）
-    rect_dsc.shadow_width = 0;                  // 阴影宽度（0=无阴影）
-    rect_dsc.shadow_ofs_x = 0;                  // 阴影X轴偏移
-    rect_dsc.shadow_ofs_y = 0;                  // 阴影Y轴偏移
-
-    // 4. 绘制矩形（x=20, y=20：矩形左上角坐标（相对坐标canvas）；w=360, h=360：矩形宽高）
-    lv_canvas_draw_rect(canvas, 20, 20, big_square_side, big_square_side, &rect_dsc);
-
-    /* 棋盘上的线条 */
-    // 绘制3条竖线和3条横线，划分16个小正方形
-    lv_draw_line_dsc_t line_dsc;
-    lv_draw_line_dsc_init(&line_dsc);  // 初始化线条描述符
-    line_dsc.color = lv_color_white(); // 线条颜色（白色，与边框一致）
-    line_dsc.width = 2;                // 线条宽度
-    line_dsc.opa = LV_OPA_COVER;       // 完全不透明
-
-    // 定义矩形的边界（与外框矩形参数对应，方便计算）
-    int x0 = 20;                    // 矩形左上角x（相对画布）
-    int y0 = 20;                    // 矩形左上角y（相对画布）
-    int w = big_square_side;        // 矩形宽度
-    int h = big_square_side;        // 矩形高度
-    int step = big_square_side / 4; // 每等份的尺寸（360/4=90）
-
-    // 3条竖线：垂直方向贯穿矩形（x固定，y从y0到y0+h）
-    lv_point_t line_ver1[] = {{x0 + step * 1, y0}, {x0 + step * 1, y0 + h}}; // 第1条竖线
-    lv_point_t line_ver2[] = {{x0 + step * 2, y0}, {x0 + step * 2, y0 + h}}; // 第2条竖线
-    lv_point_t line_ver3[] = {{x0 + step * 3, y0}, {x0 + step * 3, y0 + h}}; // 第3条竖线
-
-    // 3条横线：水平方向贯穿矩形（y固定，x从x0到x0+w）
-    lv_point_t line_hor1[] = {{x0, y0 + step * 1}, {x0 + w, y0 + step * 1}}; // 第1条横线
-    lv_point_t line_hor2[] = {{x0, y0 + step * 2}, {x0 + w, y0 + step * 2}}; // 第2条横线
-    lv_point_t line_hor3[] = {{x0, y0 + step * 3}, {x0 + w, y0 + step * 3}}; // 第3条横线
-
-    // 绘制所有线条（每个线条由2个点组成，因此cnt=2）
-    lv_canvas_draw_line(canvas, line_ver1, 2, &line_dsc);
-    lv_canvas_draw_line(canvas, line_ver2, 2, &line_dsc);
-    lv_canvas_draw_line(canvas, line_ver3, 2, &line_dsc);
-    lv_canvas_draw_line(canvas, line_hor1, 2, &line_dsc);
-    lv_canvas_draw_line(canvas, line_hor2, 2, &line_dsc);
-    lv_canvas_draw_line(canvas, line_hor3, 2, &line_dsc);
+static void set_tile_dsc(int exp, lv_color_t bg_color, lv_color_t text_color, const lv_font_t *font)
+{
+    tile_dscs[exp].bg_color = bg_color;
+    tile_dscs[exp].text_color = text_color;
+    tile_dscs[exp].font = font;
+    tile_dscs_small[exp] = tile_dscs[exp];
+    tile_dscs_small[exp].font = &lv_font_montserrat_10; // 小格子（大棋盘或多棋盘布局）统一用小字体
 }
 void init_2048_tile_styles(void) // 生成所有样式
 {
+    if (styles_ready)
+        return;
+    styles_ready = 1;
+
     // 在 init_tile_styles 函数末尾添加
     // 初始化提示标签样式
     lv_style_init(&style_msg_label);
@@ -150,176 +303,292 @@ void init_2048_tile_styles(void) // 生成所有样式
     lv_style_set_text_color(&style_msg_label, lv_color_hex(0xFF9800)); // 红色文字（醒目）
     lv_style_set_bg_opa(&style_msg_label, LV_OPA_TRANSP);              // 透明背景
 
+    // 棋盘：半透明蓝色底，白色边框
+    lv_style_init(&style_board);
+    lv_style_set_radius(&style_board, 8);
+    lv_style_set_bg_color(&style_board, lv_color_hex(0x03A9F4));
+    lv_style_set_bg_opa(&style_board, LV_OPA_80);
+    lv_style_set_border_width(&style_board, BOARD_BORDER);
+    lv_style_set_border_color(&style_board, lv_color_white());
+
     // 格子基本样式
-    lv_style_init(&style_tile_base);
-    lv_style_set_size(&style_tile_base, 80);        // 固定尺寸在init_2048_tiles();中int tile_size = 80;
-    lv_style_set_radius(&style_tile_base, 4);       // 圆角（可选）
-    lv_style_set_border_width(&style_tile_base, 0); // 边框（可选，便于区分格子）
-    lv_style_set_pad_all(&style_tile_base, 6);
+    lv_style_init(&style_tile);
+    lv_style_set_radius(&style_tile, 4);       // 圆角（可选）
+    lv_style_set_border_width(&style_tile, 0); // 边框（可选，便于区分格子）
+    lv_style_set_bg_opa(&style_tile, LV_OPA_COVER);
 
-    // 空格子（数字0）：深灰色背景，无文字
-    lv_style_init(&style_tile_0);
-    lv_style_set_bg_color(&style_tile_0, lv_color_hex(0x03A9F4));
+    // 以上样式不再修改，冻结以加快属性查找
+    lv_style_freeze(&style_msg_label);
+    lv_style_freeze(&style_board);
+    lv_style_freeze(&style_tile);
 
+    // 空格子（数字0）：深灰色背景，无文字
+    set_tile_dsc(0, lv_color_hex(0x03A9F4), lv_color_white(), &lv_font_montserrat_18);
     // 数字2：浅灰色背景，深灰文字
-    lv_style_init(&style_tile_2);
-    lv_style_set_bg_color(&style_tile_2, lv_color_hex(0xeee4da));
-    lv_style_set_text_color(&style_tile_2, lv_color_hex(0x776e65));
-    lv_style_set_text_font(&style_tile_2, &lv_font_montserrat_18);
-
+    set_tile_dsc(1, lv_color_hex(0xeee4da), lv_color_hex(0x776e65), &lv_font_montserrat_18);
     // 数字4：米色背景，深灰文字
-    lv_style_init(&style_tile_4);
-    lv_style_set_bg_color(&style_tile_4, lv_color_hex(0x66BB6A));
-    lv_style_set_text_color(&style_tile_4, lv_color_hex(0x776e65));
-    lv_style_set_text_font(&style_tile_4, &lv_font_montserrat_18);
-
+    set_tile_dsc(2, lv_color_hex(0x66BB6A), lv_color_hex(0x776e65), &lv_font_montserrat_18);
     // 数字8：浅橙色背景，白色文字
-    lv_style_init(&style_tile_8);
-    lv_style_set_bg_color(&style_tile_8, lv_color_hex(0x4CAF50));
-    lv_style_set_text_color(&style_tile_8, lv_color_white());
-    lv_style_set_text_font(&style_tile_8, &lv_font_montserrat_18);
-
+    set_tile_dsc(3, lv_color_hex(0x4CAF50), lv_color_white(), &lv_font_montserrat_18);
     // 数字16：橙色背景，白色文字
-    lv_style_init(&style_tile_16);
-    lv_style_set_bg_color(&style_tile_16, lv_color_hex(0x4CAF50));
-    lv_style_set_text_color(&style_tile_16, lv_color_white());
-    lv_style_set_text_font(&style_tile_16, &lv_font_montserrat_18);
-
+    set_tile_dsc(4, lv_color_hex(0x4CAF50), lv_color_white(), &lv_font_montserrat_18);
     // 数字32：深橙色背景，白色文字
-    lv_style_init(&style_tile_32);
-    lv_style_set_bg_color(&style_tile_32, lv_color_hex(0xFF9800));
-    lv_style_set_text_color(&style_tile_32, lv_color_white());
-    lv_style_set_text_font(&style_tile_32, &lv_font_montserrat_18);
-
+    set_tile_dsc(5, lv_color_hex(0xFF9800), lv_color_white(), &lv_font_montserrat_18);
     // 数字64：红色背景，白色文字
-    lv_style_init(&style_tile_64);
-    lv_style_set_bg_color(&style_tile_64, lv_color_hex(0xFF9800));
-    lv_style_set_text_color(&style_tile_64, lv_color_white());
-    lv_style_set_text_font(&style_tile_64, &lv_font_montserrat_18);
-
+    set_tile_dsc(6, lv_color_hex(0xFF9800), lv_color_white(), &lv_font_montserrat_18);
     // 数字128：浅黄背景，白色文字
-    lv_style_init(&style_tile_128);
-    lv_style_set_bg_color(&style_tile_128, lv_color_hex(0xFF9800));
-    lv_style_set_text_color(&style_tile_128, lv_color_white());
-    lv_style_set_text_font(&style_tile_128, &lv_font_montserrat_16);
-
+    set_tile_dsc(7, lv_color_hex(0xFF9800), lv_color_white(), &lv_font_montserrat_16);
     // 数字256：浅黄背景，白色文字
-    lv_style_init(&style_tile_256);
-    lv_style_set_bg_color(&style_tile_256, lv_color_hex(0xE65100));
-    lv_style_set_text_color(&style_tile_256, lv_color_white());
-    lv_style_set_text_font(&style_tile_256, &lv_font_montserrat_16);
-
+    set_tile_dsc(8, lv_color_hex(0xE65100), lv_color_white(), &lv_font_montserrat_16);
     // 数字512：浅黄背景，白色文字
-    lv_style_init(&style_tile_512);
-    lv_style_set_bg_color(&style_tile_512, lv_color_hex(0xE65100));
-    lv_style_set_text_color(&style_tile_512, lv_color_white());
-    lv_style_set_text_font(&style_tile_512, &lv_font_montserrat_16);
-
+    set_tile_dsc(9, lv_color_hex(0xE65100), lv_color_white(), &lv_font_montserrat_16);
     // 数字1024：黄色背景，白色文字
-    lv_style_init(&style_tile_1024);
-    lv_style_set_bg_color(&style_tile_1024, lv_color_hex(0xE65100));
-    lv_style_set_text_color(&style_tile_1024, lv_color_white());
-    lv_style_set_text_font(&style_tile_1024, &lv_font_montserrat_14);
+    set_tile_dsc(10, lv_color_hex(0xE65100), lv_color_white(), &lv_font_montserrat_14);
+    // 数字2048：红色背景，白色文字（2048及以上共用）
+    set_tile_dsc(11, lv_color_hex(0xF44336), lv_color_white(), &lv_font_montserrat_14);
+}
+/* 动画回调：var为tile_ref_t，滑动只在提交前生效，缩放只在提交后生效 */
+static void tile_slide_x_cb(void *var, int32_t v)
+{
+    tile_ref_t *ref = var;
+    if (!ref->game->anim_committed)
+        lv_2048_board_set_tile_offset(ref->game->board, ref->index, (lv_coord_t)v, 0);
+}
 
-    // 数字2048：红色背景，白色文字
-    lv_style_init(&style_tile_2048);
-    lv_style_set_bg_color(&style_tile_2048, lv_color_hex(0xF44336));
-    lv_style_set_text_color(&style_tile_2048, lv_color_white());
-    lv_style_set_text_font(&style_tile_2048, &lv_font_montserrat_14);
+static void tile_slide_y_cb(void *var, int32_t v)
+{
+    tile_ref_t *ref = var;
+    if (!ref->game->anim_committed)
+        lv_2048_board_set_tile_offset(ref->game->board, ref->index, 0, (lv_coord_t)v);
 }
-void init_2048_tiles(void) // 初始化4×4格子，位置在棋盘内
+
+static void tile_zoom_cb(void *var, int32_t v)
 {
-    // int tile_size = 80;   // 每个格子的大小（需与棋盘线条布局匹配）
-    // int gap = 10;         // 格子之间的间隙
-    // int board_x = 20 + 5; // 棋盘在画布内的左上角x坐标
-    // int board_y = 20 + 5; // 棋盘在画布内的左上角y坐标
+    tile_ref_t *ref = var;
+    if (ref->game->anim_committed)
+        lv_2048_board_set_tile_zoom(ref->game->board, ref->index, (uint16_t)v);
+}
 
-    for (int i = 0; i < 4; i++)
+/* 合并弹跳：v从0到512，先放大到(256+ANIM_POP_EXTRA)再恢复 */
+static void tile_pop_cb(void *var, int32_t v)
+{
+    tile_ref_t *ref = var;
+    if (ref->game->anim_committed)
+        lv_2048_board_set_tile_zoom(ref->game->board, ref->index, (uint16_t)(256 + ANIM_POP_EXTRA * (v < 256 ? v : 512 - v) / 256));
+}
+
+/* 滑动结束：格子归位并按差异刷新数字，之后播放合并与生成动画 */
+static void move_anim_commit(lvgl_2048_t *game)
+{
+    for (int k = 0; k < game->trace.count; k++)
     {
-        for (int j = 0; j < 4; j++)
+        lvgl_2048_tile_move_t *mv = &game->trace.moves[k];
+        lv_2048_board_set_tile_offset(game->board, mv->from_row * game->n + mv->from_col, 0, 0);
+    }
+    game_apply_diff(game);
+    game->anim_committed = 1;
+}
+
+/* 整个时间轴只由这一个动画推进，var为所属棋盘 */
+static void move_anim_exec_cb(void *var, int32_t v)
+{
+    lvgl_2048_t *game = var;
+    if (!game->anim_committed && (uint32_t)v >= game->anim_commit_progress)
+        move_anim_commit(game);
+    lv_anim_timeline_set_progress(game->timeline, (uint16_t)v);
+}
+
+static void move_anim_ready_cb(lv_anim_t *a)
+{
+    lvgl_2048_t *game = a->var;
+    if (!game->anim_committed)
+        move_anim_commit(game);
+    lv_2048_board_reset_fx(game->board);
+    lv_anim_timeline_del(game->timeline);
+    game->timeline = NULL;
+
+    /* 动画期间积累的按键：除最后一个外直接生效，最后一个带动画 */
+    if (game->move_queue_cnt > 0)
+    {
+        int cnt = game->move_queue_cnt;
+        game->move_queue_cnt = 0;
+        for (int k = 0; k < cnt - 1; k++)
         {
-            // 在画布上创建格子对象
-            tiles[i][j] = lv_obj_create(canvas);
-            lv_obj_set_size(tiles[i][j], tile_size, tile_size);
-            // 计算格子在棋盘内的位置：board_x + j*(tile_size+gap), board_y + i*(tile_size+gap)
-            lv_obj_set_pos(tiles[i][j],
-                           board_x + j * (tile_size + gap),
-                           board_y + i * (tile_size + gap));
-            // 初始样式：数字0（空）
-            lv_obj_add_style(tiles[i][j], &style_tile_base, LV_STATE_DEFAULT);
-            lv_obj_add_style(tiles[i][j], &style_tile_0, 0);
-            // 2. 创建对应标签，保存指针到全局数组
-            tile_labels[i][j] = lv_label_create(tiles[i][j]); // 标签父对象为当前格子
-            lv_obj_center(tile_labels[i][j]);                 // 标签居中（一次性设置，后续无需重复）
-            lv_label_set_text(tile_labels[i][j], "");         // 初始为空文字
+            game_do_move(game, game->move_queue[k], 0);
         }
+        game_do_move(game, game->move_queue[cnt - 1], 1);
     }
-    // 创建胜负提示标签（初始隐藏）
-    msg_label = lv_label_create(lv_scr_act());
-    lv_obj_add_style(msg_label, &style_msg_label, 0); // 使用自定义样式
-    lv_obj_align(msg_label, LV_ALIGN_TOP_MID, 0, 5);
-    lv_label_set_text(msg_label, "");
 }
-/* 按钮事件回调（修改：触发移动并更新界面） */
+
+/* 把本次移动的滑动、合并、生成动画组成一个时间轴并开始播放 */
+static void start_move_anim(lvgl_2048_t *game)
+{
+    lv_anim_t a;
+    lv_coord_t step = lv_2048_board_get_cell_step(game->board);
+    game->timeline = lv_anim_timeline_create();
+    game->anim_committed = 0;
+
+    for (int k = 0; k < game->trace.count; k++)
+    {
+        lvgl_2048_tile_move_t *mv = &game->trace.moves[k];
+        if (mv->from_row == mv->to_row && mv->from_col == mv->to_col)
+            continue;
+        // 滑动的格子由控件画在其他格子上面
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &game->tile_refs[mv->from_row * game->n + mv->from_col]);
+        lv_anim_set_time(&a, ANIM_SLIDE_TIME);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+        if (mv->from_row != mv->to_row)
+        {
+            lv_anim_set_exec_cb(&a, tile_slide_y_cb);
+            lv_anim_set_values(&a, 0, (mv->to_row - mv->from_row) * step);
+        }
+        else
+        {
+            lv_anim_set_exec_cb(&a, tile_slide_x_cb);
+            lv_anim_set_values(&a, 0, (mv->to_col - mv->from_col) * step);
+        }
+        lv_anim_timeline_add(game->timeline, 0, &a);
+    }
+
+    for (int k = 0; k < game->diff_cnt; k++)
+    {
+        tile_change_t *change = &game->diff[k];
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &game->tile_refs[change->row * game->n + change->col]);
+        if (change->type == TILE_CHANGE_MERGE)
+        {
+            lv_anim_set_exec_cb(&a, tile_pop_cb);
+            lv_anim_set_values(&a, 0, 512);
+            lv_anim_set_time(&a, ANIM_POP_TIME);
+        }
+        else if (change->type == TILE_CHANGE_SPAWN)
+        {
+            lv_anim_set_exec_cb(&a, tile_zoom_cb);
+            lv_anim_set_values(&a, ANIM_SPAWN_ZOOM_MIN, 256);
+            lv_anim_set_time(&a, ANIM_SPAWN_TIME);
+            lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+        }
+        else
+        {
+            continue;
+        }
+        lv_anim_timeline_add(game->timeline, ANIM_SLIDE_TIME, &a);
+    }
+
+    uint32_t playtime = lv_anim_timeline_get_playtime(game->timeline);
+    game->anim_commit_progress = ANIM_SLIDE_TIME * 0xFFFF / playtime;
+
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, game);
+    lv_anim_set_exec_cb(&a, move_anim_exec_cb);
+    lv_anim_set_values(&a, 0, 0xFFFF);
+    lv_anim_set_time(&a, playtime);
+    lv_anim_set_ready_cb(&a, move_anim_ready_cb);
+    lv_anim_start(&a);
+}
+
+/* 执行一次移动：生成新数字、刷新界面（可选动画）并更新提示 */
+static void game_do_move(lvgl_2048_t *game, lvgl_2048_dir_t dir, int animate)
+{
+    if (game_move(game, dir, animate ? &game->trace : NULL)) // 不播放动画时无需轨迹
+    {
+        lvgl_2048_replay_record(&game->log, dir); // 只记录有效移动
+        game_add_random(game);
+        if (animate)
+            start_move_anim(game);
+        else
+            game_apply_diff(game); // 只刷新变化的格子
+        // 检查胜负
+        if (game_check_win(game))
+        {
+            game_show_message(game, "win");
+        }
+        else if (game_is_over(game))
+        {
+            game_show_message(game, "ending");
+        }
+        else
+        {
+            game_show_message(game, ""); // 清除提示
+        }
+    }
+    else
+    {
+        if (game_is_over(game))
+        {
+            game_show_message(game, "ending");
+        }
+        else
+        {
+            game_show_message(game, "change direction"); // 提示换个方向
+        }
+    }
+}
+
+/* 动画播放中的按键先排队，动画结束后再处理；队列满时用新按键覆盖最后一个 */
+void lvgl_2048_request_move(lvgl_2048_t *game, lvgl_2048_dir_t dir)
+{
+    if (game->timeline == NULL)
+    {
+        game_do_move(game, dir, game->animate);
+        return;
+    }
+    if (game->move_queue_cnt < ANIM_QUEUE_SIZE)
+        game->move_queue_cnt++;
+    game->move_queue[game->move_queue_cnt - 1] = dir;
+}
+
+/* 按钮事件回调（修改：触发移动并更新界面），事件user_data为按钮控制的棋盘 */
 static void event_handler(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     lv_obj_t *btn = lv_event_get_target(e);
-    if (code == LV_EVENT_CLICKED)
+    lvgl_2048_t *game = lv_event_get_user_data(e);
+    if (game == NULL)
+        game = default_game;
+    if (code == LV_EVENT_CLICKED && game != NULL)
     {
         const char *btn_name = lv_obj_get_user_data(btn);
         LV_LOG_USER("%s was clicked", btn_name);
-        int moved = 0;
+
+        // 提示按钮：后台线程搜索最佳方向，不阻塞界面（求解器只支持4×4）
+        if (strcmp(btn_name, "Hint") == 0)
+        {
+            if (game->n != 4)
+                return;
+            lvgl_2048_solver_cfg_t cfg;
+            lvgl_2048_solver_cfg_init(&cfg);
+            cfg.max_depth = 6;
+            cfg.time_ms = 300;
+            if (lvgl_2048_solver_request(lvgl_2048_grid_to_board(game->cells), &cfg, hint_ready_cb, game))
+            {
+                hint_game = game;
+                game_show_message(game, "thinking...");
+            }
+            return;
+        }
 
         // 根据按钮名称触发对应移动
         if (strcmp(btn_name, "Up") == 0)
         {
-            moved = moveUp();
+            lvgl_2048_request_move(game, LVGL_2048_DIR_UP);
         }
         else if (strcmp(btn_name, "Down") == 0)
         {
-            moved = moveDown();
+            lvgl_2048_request_move(game, LVGL_2048_DIR_DOWN);
         }
         else if (strcmp(btn_name, "Left") == 0)
         {
-            moved = moveLeft();
+            lvgl_2048_request_move(game, LVGL_2048_DIR_LEFT);
         }
         else if (strcmp(btn_name, "Right") == 0)
         {
-            moved = moveRight();
-        }
-        // 移动后更新界面并生成新数字
-        if (moved)
-        {
-            addRandomMatrix();
-            lvgl_2048_updateui();
-            // 检查胜负
-            if (checkWin())
-            {
-                show_message("win");
-            }
-            else if (isGameOver())
-            {
-                show_message("ending");
-            }
-            else
-            {
-                show_message(""); // 清除提示
-            }
-        }
-        else
-        {
-            if (isGameOver())
-            {
-                show_message("ending");
-            }
-            else
-            {
-                show_message("change direction"); // 提示换个方向
-            }
+            lvgl_2048_request_move(game, LVGL_2048_DIR_RIGHT);
         }
     }
 }
+
 void init_2048_btn(void) // 画按钮
 {
     lv_obj_t *label;
@@ -363,338 +632,195 @@ void init_2048_btn(void) // 画按钮
     label = lv_label_create(btn4);
     lv_label_set_text(label, "Down");
     lv_obj_center(label);
+
+    // Hint按钮
+    lv_obj_t *btn5 = lv_btn_create(lv_scr_act());
+    lv_obj_add_event_cb(btn5, event_handler, LV_EVENT_ALL, NULL);
+    lv_obj_align(btn5, LV_ALIGN_CENTER, 300, 170);
+    lv_obj_set_user_data(btn5, "Hint"); // 绑定标识"Hint"
+
+    label = lv_label_create(btn5);
+    lv_label_set_text(label, "Hint");
+    lv_obj_center(label);
 }
 /*
  * return:1是生成成功，0是失败
  */
-int addRandomMatrix(void) // 随机matrix赋值2，等待界面同步
+static int game_add_random(lvgl_2048_t *game)
 {
-    int emptyCells = 0; // 剩余空格子数量
-    for (int i = 0; i < 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (matrix[i][j] == 0)
-                emptyCells++;
-        }
-    }
-    if (emptyCells == 0)
+    int index = lvgl_2048_grid_add_random(game->cells, game->n, &game->rng); // 与回放使用同一规则
+    if (index < 0)
     {
         LV_LOG_USER("test empty was end");
         return 0;
     }
+    LV_LOG_USER("test %d , %d was created", index / game->n, index % game->n);
+    game_diff_add(game, index / game->n, index % game->n, TILE_CHANGE_SPAWN);
+    return 1;
+}
 
-    int randomIndex = rand() % emptyCells;
-    LV_LOG_USER("test %d was created", randomIndex);
-    int count = 0;
-    for (int i = 0; i < 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (matrix[i][j] == 0)
-            {
-                if (count == randomIndex)
-                {
-                    matrix[i][j] = 2;
-                    // lv_obj_add_style(tiles[i][j], &style_tile_2, 0);
-                    // lv_label_create(tiles[i][j]);
-                    // char c_number[2];
-                    // c_number[0] = '0' + matrix[i][j];
-                    // lv_label_set_text(lv_obj_get_child(tiles[i][j], 0), c_number);
-                    // lv_obj_center(lv_obj_get_child(tiles[i][j], 0));
-                    return 1;
-                }
-                count++;
-            }
-        }
-    }
-    return 0;
+int addRandomMatrix(void) // 默认棋盘随机赋值2，等待界面同步
+{
+    return default_game ? game_add_random(default_game) : 0;
+}
+
+/* 同步单个格子：控件只在数字变化时重绘该格子 */
+static void sync_tile(lvgl_2048_t *game, int k)
+{
+    lv_2048_board_set_cell(game->board, (uint32_t)k, game->cells[k]);
 }
 
-/* 获取当前数字对应的样式 */
-lv_style_t *lvgl_2048_get_style(int value)
+/* 全量同步界面与棋盘数据（初始化时使用，未变化的格子会被跳过） */
+static void game_update_ui(lvgl_2048_t *game)
 {
-    lv_style_t *style;
-    switch (value)
+    for (int k = 0; k < game->n * game->n; k++)
     {
-    case 0:
-        style = &style_tile_0;
-        break;
-    case 2:
-        style = &style_tile_2;
-        break;
-    case 4:
-        style = &style_tile_4;
-        break;
-    case 8:
-        style = &style_tile_8;
-        break;
-    case 16:
-        style = &style_tile_16;
-        break;
-    case 32:
-        style = &style_tile_32;
-        break;
-    case 64:
-        style = &style_tile_64;
-        break;
-    case 128:
-        style = &style_tile_128;
-        break;
-    case 256:
-        style = &style_tile_256;
-        break;
-    case 512:
-        style = &style_tile_512;
-        break;
-    case 1024:
-        style = &style_tile_1024;
-        break;
-    case 2048:
-        style = &style_tile_2048;
-        break;
+        sync_tile(game, k);
     }
-    return style;
+    game->diff_cnt = 0;
 }
+
 void lvgl_2048_updateui(void)
 {
-    // 遍历4x4网格，同步matrix数据到UI
-    for (int i = 0; i < 4; i++)
+    if (default_game)
+        game_update_ui(default_game);
+}
+
+/* 记录一个变化的格子，同一格子多次变化时保留最后的类型（生成/合并优先于滑动） */
+static void game_diff_add(lvgl_2048_t *game, int row, int col, tile_change_type_t type)
+{
+    for (int k = 0; k < game->diff_cnt; k++)
     {
-        for (int j = 0; j < 4; j++)
+        if (game->diff[k].row == row && game->diff[k].col == col)
         {
-            int current_value = matrix[i][j];            // 当前格子的数值
-            lv_obj_t *current_tile = tiles[i][j];        // 当前格子对象
-            lv_obj_t *current_label = tile_labels[i][j]; // 当前格子的标签（预初始化的指针）
-            lv_style_t *current_style = lvgl_2048_get_style(current_value);
-            // 1. 清理当前状态的旧样式（避免累积）
-            lv_obj_remove_style(current_tile, current_style, LV_STATE_ANY | LV_STATE_ANY);
-            // 2. 根据数值应用对应样式，并更新标签文字
-            switch (current_value)
-            {
-            case 0:
-                // 空格子：应用空样式，清空文字
-                lv_obj_add_style(current_tile, &style_tile_0, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "");
-                break;
-
-            case 2:
-                lv_obj_add_style(current_tile, &style_tile_2, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "2");
-                break;
-
-            case 4:
-                lv_obj_add_style(current_tile, &style_tile_4, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "4");
-                break;
-
-            case 8:
-                lv_obj_add_style(current_tile, &style_tile_8, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "8");
-                break;
-
-            case 16:
-                lv_obj_add_style(current_tile, &style_tile_16, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "16");
-                break;
-
-            case 32:
-                lv_obj_add_style(current_tile, &style_tile_32, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "32");
-                break;
-
-            case 64:
-                lv_obj_add_style(current_tile, &style_tile_64, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "64");
-                break;
-
-            case 128:
-                lv_obj_add_style(current_tile, &style_tile_128, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "128");
-                break;
-
-            case 256:
-                lv_obj_add_style(current_tile, &style_tile_256, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "256");
-                break;
-
-            case 512: // 补充512（若需要）
-                lv_obj_add_style(current_tile, &style_tile_512, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "512");
-                break;
-
-            case 1024:
-                lv_obj_add_style(current_tile, &style_tile_1024, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "1024");
-                break;
-
-            case 2048:
-                lv_obj_add_style(current_tile, &style_tile_2048, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "2048");
-                break;
-
-            default:
-                // 未知数值：按空格子处理
-                lv_obj_add_style(current_tile, &style_tile_0, LV_STATE_DEFAULT);
-                lv_label_set_text(current_label, "");
-                LV_LOG_WARN("unknow %d,empty", current_value);
-                break;
-            }
+            if (type != TILE_CHANGE_SLIDE)
+                game->diff[k].type = (uint8_t)type;
+            return;
         }
     }
+    game->diff[game->diff_cnt].row = (uint8_t)row;
+    game->diff[game->diff_cnt].col = (uint8_t)col;
+    game->diff[game->diff_cnt].type = (uint8_t)type;
+    game->diff_cnt++;
 }
 
-/* 左移逻辑（复用控制台逻辑） */
-int moveLeft(void)
+/* 增量同步：只处理本次移动与生成产生的差异 */
+static void game_apply_diff(lvgl_2048_t *game)
 {
-    int moved = 0;
-    for (int i = 0; i < 4; i++)
+    for (int k = 0; k < game->diff_cnt; k++)
     {
-        for (int j = 1; j < 4; j++)
-        {
-            int k = j;
-            // 移动到最左非空位置
-            while (k > 0 && matrix[i][k - 1] == 0)
-            {
-                matrix[i][k - 1] = matrix[i][k];
-                matrix[i][k] = 0;
-                k--;
-                moved = 1;
-            }
-            // 合并相同数字
-            if (k > 0 && matrix[i][k - 1] == matrix[i][k])
-            {
-                matrix[i][k - 1] *= 2;
-                matrix[i][k] = 0;
-                moved = 1;
-            }
-        }
+        sync_tile(game, game->diff[k].row * game->n + game->diff[k].col);
     }
-    return moved;
+    game->diff_cnt = 0;
 }
 
-/* 右移逻辑 */
-int moveRight(void)
+void lvgl_2048_apply_diff(void)
 {
-    int moved = 0;
-    for (int i = 0; i < 4; i++)
+    if (default_game)
+        game_apply_diff(default_game);
+}
+
+/*
+ * 按方向移动，移动成功返回1，并把变化追加到差异列表（界面同步后清空）
+ * trace为NULL时不记录轨迹，也不区分合并的格子，只供不播放动画的移动使用
+ */
+static int game_move(lvgl_2048_t *game, lvgl_2048_dir_t dir, lvgl_2048_move_trace_t *trace)
+{
+    int n = game->n;
+    uint8_t before[LVGL_2048_MAX_CELLS];
+    lv_memcpy_small(before, game->cells, (uint32_t)(n * n));
+    if (!lvgl_2048_grid_move(game->cells, n, dir, trace))
+        return 0;
+
+    for (int k = 0; k < n * n; k++)
     {
-        for (int j = 2; j >= 0; j--)
-        {
-            int k = j;
-            while (k < 3 && matrix[i][k + 1] == 0)
-            {
-                matrix[i][k + 1] = matrix[i][k];
-                matrix[i][k] = 0;
-                k++;
-                moved = 1;
-            }
-            if (k < 3 && matrix[i][k + 1] == matrix[i][k])
-            {
-                matrix[i][k + 1] *= 2;
-                matrix[i][k] = 0;
-                moved = 1;
-            }
-        }
+        if (before[k] != game->cells[k])
+            game_diff_add(game, k / n, k % n, TILE_CHANGE_SLIDE);
+    }
+    for (int k = 0; trace && k < trace->count; k++)
+    {
+        if (trace->moves[k].merged)
+            game_diff_add(game, trace->moves[k].to_row, trace->moves[k].to_col, TILE_CHANGE_MERGE);
     }
-    return moved;
+    return 1;
+}
+
+/* 左移逻辑 */
+int moveLeft(void)
+{
+    return default_game ? game_move(default_game, LVGL_2048_DIR_LEFT, NULL) : 0;
+}
+
+/* 右移逻辑 */
+int moveRight(void)
+{
+    return default_game ? game_move(default_game, LVGL_2048_DIR_RIGHT, NULL) : 0;
 }
 
 /* 上移逻辑 */
 int moveUp(void)
 {
-    int moved = 0;
-    for (int j = 0; j < 4; j++)
-    {
-        for (int i = 1; i < 4; i++)
-        {
-            int k = i;
-            while (k > 0 && matrix[k - 1][j] == 0)
-            {
-                matrix[k - 1][j] = matrix[k][j];
-                matrix[k][j] = 0;
-                k--;
-                moved = 1;
-            }
-            if (k > 0 && matrix[k - 1][j] == matrix[k][j])
-            {
-                matrix[k - 1][j] *= 2;
-                matrix[k][j] = 0;
-                moved = 1;
-            }
-        }
-    }
-    return moved;
+    return default_game ? game_move(default_game, LVGL_2048_DIR_UP, NULL) : 0;
 }
 
 /* 下移逻辑 */
 int moveDown(void)
 {
-    int moved = 0;
-    for (int j = 0; j < 4; j++)
-    {
-        for (int i = 2; i >= 0; i--)
-        {
-            int k = i;
-            while (k < 3 && matrix[k + 1][j] == 0)
-            {
-                matrix[k + 1][j] = matrix[k][j];
-                matrix[k][j] = 0;
-                k++;
-                moved = 1;
-            }
-            if (k < 3 && matrix[k + 1][j] == matrix[k][j])
-            {
-                matrix[k + 1][j] *= 2;
-                matrix[k][j] = 0;
-                moved = 1;
-            }
-        }
-    }
-    return moved;
+    return default_game ? game_move(default_game, LVGL_2048_DIR_DOWN, NULL) : 0;
+}
+
+/* 判断游戏结束：四个方向都无法移动 */
+static int game_is_over(const lvgl_2048_t *game)
+{
+    return !lvgl_2048_grid_can_move(game->cells, game->n);
 }
-/* 判断游戏结束 */
+
 int isGameOver(void)
 {
-    // 有空位则未结束
-    for (int i = 0; i < 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (matrix[i][j] == 0)
-                return 0;
-        }
-    }
-    // 有相邻相同数字则未结束
-    for (int i = 0; i < 4; i++)
-    {
-        for (int j = 0; j < 4; j++)
-        {
-            if (i < 3 && matrix[i][j] == matrix[i + 1][j])
-                return 0;
-            if (j < 3 && matrix[i][j] == matrix[i][j + 1])
-                return 0;
-        }
-    }
-    return 1;
+    return default_game ? game_is_over(default_game) : 0;
 }
 
 /* 判断胜利（出现2048） */
-int checkWin(void)
+static int game_check_win(const lvgl_2048_t *game)
 {
-    for (int i = 0; i < 4; i++)
+    for (int k = 0; k < game->n * game->n; k++)
     {
-        for (int j = 0; j < 4; j++)
-        {
-            if (matrix[i][j] == 2048)
-                return 1;
-        }
+        if (game->cells[k] >= LVGL_2048_WIN_EXP)
+            return 1;
     }
     return 0;
 }
 
+int checkWin(void)
+{
+    return default_game ? game_check_win(default_game) : 0;
+}
+
+/* 提示搜索完成（LVGL线程中执行），棋盘已删除或已变化则结果作废 */
+static void hint_ready_cb(lvgl_2048_board_t board, int dir, void *user_data)
+{
+    static const char *dir_names[] = {"hint: Up", "hint: Down", "hint: Left", "hint: Right"};
+    lvgl_2048_t *game = user_data;
+    if (game != hint_game)
+        return;
+    hint_game = NULL;
+    if (board != lvgl_2048_grid_to_board(game->cells))
+        return;
+    game_show_message(game, dir < 0 ? "ending" : dir_names[dir]);
+}
+
 /* 显示胜负提示 */
+static void game_show_message(lvgl_2048_t *game, const char *msg)
+{
+    if (game->msg_label == NULL)
+        return;
+    if (strcmp(lv_label_get_text(game->msg_label), msg) == 0) // 内容相同则不重绘
+        return;
+    lv_label_set_text(game->msg_label, msg);
+}
+
 void show_message(const char *msg)
 {
-    lv_label_set_text(msg_label, msg);
-}
\ No newline at end of file
+    if (default_game)
+        game_show_message(default_game, msg);
+}
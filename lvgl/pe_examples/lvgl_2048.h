@@ -2,6 +2,34 @@
 #define __LVGL_2048_H
 
 #include "lvgl/lvgl.h"
-void lvgl_2048_start(void);
+#include "lvgl_2048_engine.h"
+#include "lvgl_2048_replay.h"
+
+/* 一个棋盘实例：自己的对象树（棋盘+格子）和游戏状态，同一屏幕上可以放多个 */
+typedef struct _lvgl_2048_t lvgl_2048_t;
+
+typedef struct
+{
+    uint8_t n;       // 棋盘边长（格子数），LVGL_2048_MIN_N..LVGL_2048_MAX_N
+    lv_coord_t size; // 棋盘像素边长（含边框）
+    lv_coord_t gap;  // 格子之间的间隙
+    uint32_t seed;   // 随机数种子，种子和操作相同则对局完全相同
+    bool animate;    // 移动时是否播放动画
+} lvgl_2048_cfg_t;
+
+void lvgl_2048_start(void);               // 在当前屏幕创建默认的4×4棋盘、按钮和提示标签
+void lvgl_2048_start_seed(uint32_t seed); // 指定种子开局
+
+void lvgl_2048_cfg_init(lvgl_2048_cfg_t *cfg);                               // 默认配置：4×4，360像素，间隙10
+lvgl_2048_t *lvgl_2048_create(lv_obj_t *parent, const lvgl_2048_cfg_t *cfg); // 创建棋盘，失败返回NULL
+void lvgl_2048_delete(lvgl_2048_t *game);                                    // 删除棋盘对象并释放状态
+lv_obj_t *lvgl_2048_get_obj(lvgl_2048_t *game);                              // 棋盘对象，用于布局
+lvgl_2048_t *lvgl_2048_get_default(void);                                    // lvgl_2048_start创建的棋盘
+void lvgl_2048_set_msg_label(lvgl_2048_t *game, lv_obj_t *label);            // 胜负提示显示到label，NULL为不显示
+void lvgl_2048_request_move(lvgl_2048_t *game, lvgl_2048_dir_t dir);         // 移动一步，动画期间会排队
+int lvgl_2048_get_exp(const lvgl_2048_t *game, int row, int col);            // 格子上数字的指数，0为空
+
+const lvgl_2048_replay_t *lvgl_2048_get_replay(const lvgl_2048_t *game);                    // 当前对局记录（种子+每步方向），用于复现问题
+int lvgl_2048_load_replay(lvgl_2048_t *game, const lvgl_2048_replay_t *log, uint32_t move_cnt); // 无界面快进到第move_cnt步后再显示，仅支持4×4
 
 #endif
@@ -0,0 +1,438 @@
+#include "lvgl_2048_engine.h"
+#include <stddef.h>
+
+/* 行移动表：以一行的16位打包值为下标，查得左移/右移后的结果 */
+static uint16_t row_left_table[65536];
+static uint16_t row_right_table[65536];
+/* 行轨迹表：以一行左移前的16位打包值为下标，每4位描述一个起点格：低2位为终点列，
+ * ROW_TRACE_MERGED表示参与合并，ROW_TRACE_RECORD表示需要记入轨迹（位置变化或参与合并） */
+static uint16_t row_trace_table[65536];
+#define ROW_TRACE_MERGED 0x4
+#define ROW_TRACE_RECORD 0x8
+static int engine_ready = 0;
+
+/* 单行左移（生成表时使用）：先压缩非空格，再合并相邻相同数字，每个数字一次移动只合并一次 */
+static uint16_t row_slide_left(uint16_t row)
+{
+    int line[4];
+    int out[4] = {0};
+    int pos = 0;
+    int merged = 0; // out[pos-1]是否已由合并得到
+
+    for (int j = 0; j < 4; j++)
+    {
+        line[j] = (row >> (j * 4)) & 0xF;
+    }
+    for (int j = 0; j < 4; j++)
+    {
+        if (line[j] == 0)
+            continue;
+        if (pos > 0 && !merged && out[pos - 1] == line[j])
+        {
+            if (out[pos - 1] < 15) // 4位上限为2^15，超过则饱和
+                out[pos - 1]++;
+            merged = 1;
+        }
+        else
+        {
+            out[pos++] = line[j];
+            merged = 0;
+        }
+    }
+    return (uint16_t)(out[0] | (out[1] << 4) | (out[2] << 8) | (out[3] << 12));
+}
+
+/* 单行左移的轨迹（生成表时使用），规则与row_slide_left相同 */
+static uint16_t row_trace_left(uint16_t row)
+{
+    int out[4] = {0};
+    int out_first[4] = {0}; // 最先落到out[pos]的起点列
+    int to[4] = {0};
+    int merged_flag[4] = {0};
+    int pos = 0;
+    int merged = 0;
+
+    for (int j = 0; j < 4; j++)
+    {
+        int exp = (row >> (j * 4)) & 0xF;
+        if (exp == 0)
+            continue;
+        if (pos > 0 && !merged && out[pos - 1] == exp)
+        {
+            merged = 1;
+            to[j] = pos - 1;
+            merged_flag[j] = 1;
+            merged_flag[out_first[pos - 1]] = 1;
+        }
+        else
+        {
+            out_first[pos] = j;
+            out[pos] = exp;
+            to[j] = pos++;
+            merged = 0;
+        }
+    }
+
+    uint16_t trace = 0;
+    for (int j = 0; j < 4; j++)
+    {
+        if (((row >> (j * 4)) & 0xF) == 0 || (to[j] == j && !merged_flag[j]))
+            continue;
+        trace |= (uint16_t)((to[j] | (merged_flag[j] ? ROW_TRACE_MERGED : 0) | ROW_TRACE_RECORD) << (j * 4));
+    }
+    return trace;
+}
+
+/* 单行左右翻转 */
+static uint16_t row_reverse(uint16_t row)
+{
+    return (uint16_t)((row >> 12) | ((row >> 4) & 0x00F0) | ((row << 4) & 0x0F00) | (row << 12));
+}
+
+void lvgl_2048_engine_init(void)
+{
+    if (engine_ready)
+        return;
+    for (uint32_t row = 0; row < 65536; row++)
+    {
+        row_left_table[row] = row_slide_left((uint16_t)row);
+        row_trace_table[row] = row_trace_left((uint16_t)row);
+    }
+    for (uint32_t row = 0; row < 65536; row++)
+    {
+        uint16_t rev = row_reverse((uint16_t)row);
+        row_right_table[row] = row_reverse(row_left_table[rev]);
+    }
+    engine_ready = 1;
+}
+
+/* 4行分别查表 */
+static lvgl_2048_board_t board_move_rows(lvgl_2048_board_t board, const uint16_t *table)
+{
+    return (lvgl_2048_board_t)table[board & 0xFFFF] |
+           ((lvgl_2048_board_t)table[(board >> 16) & 0xFFFF] << 16) |
+           ((lvgl_2048_board_t)table[(board >> 32) & 0xFFFF] << 32) |
+           ((lvgl_2048_board_t)table[(board >> 48) & 0xFFFF] << 48);
+}
+
+lvgl_2048_board_t lvgl_2048_board_transpose(lvgl_2048_board_t x)
+{
+    lvgl_2048_board_t a1 = x & 0xF0F00F0FF0F00F0FULL;
+    lvgl_2048_board_t a2 = x & 0x0000F0F00000F0F0ULL;
+    lvgl_2048_board_t a3 = x & 0x0F0F00000F0F0000ULL;
+    lvgl_2048_board_t a = a1 | (a2 << 12) | (a3 >> 12);
+    lvgl_2048_board_t b1 = a & 0xFF00FF0000FF00FFULL;
+    lvgl_2048_board_t b2 = a & 0x00FF00FF00000000ULL;
+    lvgl_2048_board_t b3 = a & 0x00000000FF00FF00ULL;
+    return b1 | (b2 >> 24) | (b3 << 24);
+}
+
+lvgl_2048_board_t lvgl_2048_board_move(lvgl_2048_board_t board, lvgl_2048_dir_t dir)
+{
+    switch (dir)
+    {
+    case LVGL_2048_DIR_LEFT:
+        return board_move_rows(board, row_left_table);
+    case LVGL_2048_DIR_RIGHT:
+        return board_move_rows(board, row_right_table);
+    case LVGL_2048_DIR_UP: // 转置后上移即为左移
+        return lvgl_2048_board_transpose(board_move_rows(lvgl_2048_board_transpose(board), row_left_table));
+    case LVGL_2048_DIR_DOWN:
+        return lvgl_2048_board_transpose(board_move_rows(lvgl_2048_board_transpose(board), row_right_table));
+    }
+    return board;
+}
+
+/* 第line条线上沿移动方向第k个格子的坐标（k=0为移动的终点一侧） */
+static void line_cell(lvgl_2048_dir_t dir, int n, int line, int k, int *row, int *col)
+{
+    switch (dir)
+    {
+    case LVGL_2048_DIR_LEFT:
+        *row = line;
+        *col = k;
+        break;
+    case LVGL_2048_DIR_RIGHT:
+        *row = line;
+        *col = n - 1 - k;
+        break;
+    case LVGL_2048_DIR_UP:
+        *row = k;
+        *col = line;
+        break;
+    default:
+        *row = n - 1 - k;
+        *col = line;
+        break;
+    }
+}
+
+/* 按行轨迹表记录4×4整盘移动的轨迹，顺序与grid_move_slow相同 */
+static void board_trace(lvgl_2048_board_t board, lvgl_2048_dir_t dir, lvgl_2048_move_trace_t *trace)
+{
+    /* 沿移动方向取出每条线，使第k格位于第k个4位，即可统一按左移查表 */
+    lvgl_2048_board_t lines = dir == LVGL_2048_DIR_UP || dir == LVGL_2048_DIR_DOWN ? lvgl_2048_board_transpose(board) : board;
+    int reverse = dir == LVGL_2048_DIR_RIGHT || dir == LVGL_2048_DIR_DOWN;
+
+    trace->count = 0;
+    for (int line = 0; line < 4; line++)
+    {
+        uint16_t row = (uint16_t)(lines >> (line * 16));
+        uint16_t row_trace = row_trace_table[reverse ? row_reverse(row) : row];
+        for (int k = 0; k < 4 && row_trace != 0; k++, row_trace >>= 4)
+        {
+            if ((row_trace & ROW_TRACE_RECORD) == 0)
+                continue;
+            int from_row, from_col, to_row, to_col;
+            line_cell(dir, 4, line, k, &from_row, &from_col);
+            line_cell(dir, 4, line, row_trace & 0x3, &to_row, &to_col);
+            lvgl_2048_tile_move_t *mv = &trace->moves[trace->count++];
+            mv->from_row = (uint8_t)from_row;
+            mv->from_col = (uint8_t)from_col;
+            mv->to_row = (uint8_t)to_row;
+            mv->to_col = (uint8_t)to_col;
+            mv->merged = (row_trace & ROW_TRACE_MERGED) ? 1 : 0;
+        }
+    }
+}
+
+/* 逐格移动（与查表结果一致），trace可为NULL */
+static int grid_move_slow(uint8_t *cells, int n, lvgl_2048_dir_t dir, lvgl_2048_move_trace_t *trace)
+{
+    int changed = 0;
+    if (trace)
+        trace->count = 0;
+
+    for (int line = 0; line < n; line++)
+    {
+        int out[LVGL_2048_MAX_N] = {0};
+        int out_first[LVGL_2048_MAX_N] = {0}; // 最先落到out[pos]的数字块序号
+        int from[LVGL_2048_MAX_N];            // 以下按数字块序号记录：起点、终点、是否合并
+        int to[LVGL_2048_MAX_N];
+        int merged_flag[LVGL_2048_MAX_N];
+        int pos = 0;
+        int merged = 0;
+        int cnt = 0;
+
+        for (int k = 0; k < n; k++)
+        {
+            int row, col;
+            line_cell(dir, n, line, k, &row, &col);
+            int exp = cells[row * n + col];
+            if (exp == 0)
+                continue;
+            if (pos > 0 && !merged && out[pos - 1] == exp)
+            {
+                if (out[pos - 1] < 15)
+                    out[pos - 1]++;
+                merged = 1;
+                to[cnt] = pos - 1;
+                merged_flag[cnt] = 1;
+                merged_flag[out_first[pos - 1]] = 1; // 被合并的那块即使没动也要记录
+            }
+            else
+            {
+                out_first[pos] = cnt;
+                out[pos] = exp;
+                to[cnt] = pos++;
+                merged_flag[cnt] = 0;
+                merged = 0;
+            }
+            from[cnt++] = k;
+        }
+
+        for (int t = 0; t < cnt; t++)
+        {
+            if (from[t] == to[t] && !merged_flag[t])
+                continue;
+            changed = 1;
+            if (trace == NULL)
+                continue;
+            int from_row, from_col, to_row, to_col;
+            line_cell(dir, n, line, from[t], &from_row, &from_col);
+            line_cell(dir, n, line, to[t], &to_row, &to_col);
+            lvgl_2048_tile_move_t *mv = &trace->moves[trace->count++];
+            mv->from_row = (uint8_t)from_row;
+            mv->from_col = (uint8_t)from_col;
+            mv->to_row = (uint8_t)to_row;
+            mv->to_col = (uint8_t)to_col;
+            mv->merged = (uint8_t)merged_flag[t];
+        }
+        for (int k = 0; k < n; k++)
+        {
+            int row, col;
+            line_cell(dir, n, line, k, &row, &col);
+            cells[row * n + col] = (uint8_t)(k < pos ? out[k] : 0);
+        }
+    }
+    return changed;
+}
+
+lvgl_2048_board_t lvgl_2048_grid_to_board(const uint8_t *cells)
+{
+    lvgl_2048_board_t board = 0;
+    for (int i = 15; i >= 0; i--)
+    {
+        board = (board << 4) | (cells[i] & 0xF);
+    }
+    return board;
+}
+
+void lvgl_2048_board_to_grid(lvgl_2048_board_t board, uint8_t *cells)
+{
+    for (int i = 0; i < 16; i++)
+    {
+        cells[i] = (uint8_t)(board & 0xF);
+        board >>= 4;
+    }
+}
+
+int lvgl_2048_grid_move(uint8_t *cells, int n, lvgl_2048_dir_t dir, lvgl_2048_move_trace_t *trace)
+{
+    if (n == 4)
+    {
+        lvgl_2048_board_t board = lvgl_2048_grid_to_board(cells);
+        lvgl_2048_board_t moved = lvgl_2048_board_move(board, dir);
+        if (trace)
+            board_trace(board, dir, trace);
+        lvgl_2048_board_to_grid(moved, cells);
+        return moved != board;
+    }
+    return grid_move_slow(cells, n, dir, trace);
+}
+
+int lvgl_2048_grid_can_move(const uint8_t *cells, int n)
+{
+    if (n == 4)
+        return lvgl_2048_board_can_move(lvgl_2048_grid_to_board(cells));
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            int exp = cells[i * n + j];
+            if (exp == 0)
+                return 1;
+            if (j + 1 < n && cells[i * n + j + 1] == exp)
+                return 1;
+            if (i + 1 < n && cells[(i + 1) * n + j] == exp)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+int lvgl_2048_grid_add_random(uint8_t *cells, int n, lvgl_2048_rng_t *rng)
+{
+    int empty = 0;
+    for (int i = 0; i < n * n; i++)
+    {
+        if (cells[i] == 0)
+            empty++;
+    }
+    if (empty == 0)
+        return -1;
+
+    /* 与lvgl_2048_board_add_random取同一个随机数、同样按行序数空格 */
+    int index = (int)(lvgl_2048_rng_next(rng) % (uint32_t)empty);
+    for (int i = 0; i < n * n; i++)
+    {
+        if (cells[i] == 0 && index-- == 0)
+        {
+            cells[i] = 1;
+            return i;
+        }
+    }
+    return -1;
+}
+
+lvgl_2048_board_t lvgl_2048_board_move_trace(lvgl_2048_board_t board, lvgl_2048_dir_t dir,
+                                             lvgl_2048_move_trace_t *trace)
+{
+    board_trace(board, dir, trace);
+    return lvgl_2048_board_move(board, dir);
+}
+
+int lvgl_2048_board_count_empty(lvgl_2048_board_t board)
+{
+    int count = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        if ((board & 0xF) == 0)
+            count++;
+        board >>= 4;
+    }
+    return count;
+}
+
+lvgl_2048_board_t lvgl_2048_board_spawn(lvgl_2048_board_t board, int index, int exp)
+{
+    for (int shift = 0; shift < 64; shift += 4)
+    {
+        if (((board >> shift) & 0xF) == 0)
+        {
+            if (index == 0)
+                return board | ((lvgl_2048_board_t)(exp & 0xF) << shift);
+            index--;
+        }
+    }
+    return board;
+}
+
+void lvgl_2048_rng_seed(lvgl_2048_rng_t *rng, uint32_t seed)
+{
+    /* 打散种子，避免相邻种子开局相同；xorshift状态不能为0 */
+    uint32_t x = seed * 0x9E3779B9u + 0x6D2B79F5u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    rng->state = x ? x : 1;
+}
+
+uint32_t lvgl_2048_rng_next(lvgl_2048_rng_t *rng)
+{
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+lvgl_2048_board_t lvgl_2048_board_add_random(lvgl_2048_board_t board, lvgl_2048_rng_t *rng)
+{
+    int empty = lvgl_2048_board_count_empty(board);
+    if (empty == 0)
+        return board;
+    return lvgl_2048_board_spawn(board, (int)(lvgl_2048_rng_next(rng) % (uint32_t)empty), 1);
+}
+
+int lvgl_2048_board_can_move(lvgl_2048_board_t board)
+{
+    return lvgl_2048_board_move(board, LVGL_2048_DIR_LEFT) != board ||
+           lvgl_2048_board_move(board, LVGL_2048_DIR_RIGHT) != board ||
+           lvgl_2048_board_move(board, LVGL_2048_DIR_UP) != board ||
+           lvgl_2048_board_move(board, LVGL_2048_DIR_DOWN) != board;
+}
+
+int lvgl_2048_board_max_exp(lvgl_2048_board_t board)
+{
+    int max = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        if ((int)(board & 0xF) > max)
+            max = (int)(board & 0xF);
+        board >>= 4;
+    }
+    return max;
+}
+
+int lvgl_2048_value_to_exp(int value)
+{
+    int exp = 0;
+    while (value > 1)
+    {
+        value >>= 1;
+        exp++;
+    }
+    return exp;
+}
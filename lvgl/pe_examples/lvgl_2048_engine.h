@@ -0,0 +1,94 @@
+#ifndef __LVGL_2048_ENGINE_H
+#define __LVGL_2048_ENGINE_H
+
+#include <stdint.h>
+
+/*
+ * 2048 位棋盘引擎（不依赖LVGL，可无界面运行，用于回放与AI评估）
+ * 棋盘打包为64位整数：每格4位，存放数字的指数（0表示空，1表示2，2表示4 ... 11表示2048）
+ * 第i行第j列位于第 (i*16 + j*4) 位，即每16位为一行，行内低位为左侧
+ */
+typedef uint64_t lvgl_2048_board_t;
+
+/* 移动方向，取值与按键无关，仅用于引擎内部与回放日志（2位即可编码） */
+typedef enum
+{
+    LVGL_2048_DIR_UP = 0,
+    LVGL_2048_DIR_DOWN,
+    LVGL_2048_DIR_LEFT,
+    LVGL_2048_DIR_RIGHT,
+} lvgl_2048_dir_t;
+
+#define LVGL_2048_WIN_EXP 11 // 2048 = 2^11
+#define LVGL_2048_MIN_N 3    // 通用棋盘边长范围
+#define LVGL_2048_MAX_N 8
+#define LVGL_2048_MAX_CELLS (LVGL_2048_MAX_N * LVGL_2048_MAX_N)
+
+void lvgl_2048_engine_init(void);                                                      // 预计算行移动表（可重复调用）
+lvgl_2048_board_t lvgl_2048_board_move(lvgl_2048_board_t board, lvgl_2048_dir_t dir); // 整盘移动：4次查表+转置
+lvgl_2048_board_t lvgl_2048_board_transpose(lvgl_2048_board_t board);                 // 行列转置
+int lvgl_2048_board_count_empty(lvgl_2048_board_t board);                             // 空格数量
+lvgl_2048_board_t lvgl_2048_board_spawn(lvgl_2048_board_t board, int index, int exp);  // 在第index个空格放入指数exp
+int lvgl_2048_board_can_move(lvgl_2048_board_t board);                                // 任一方向可移动返回1
+int lvgl_2048_board_max_exp(lvgl_2048_board_t board);                                 // 最大数字的指数
+
+/* 可复现的随机数发生器（xorshift32），同一种子生成的数字位置完全相同 */
+typedef struct
+{
+    uint32_t state;
+} lvgl_2048_rng_t;
+
+void lvgl_2048_rng_seed(lvgl_2048_rng_t *rng, uint32_t seed);
+uint32_t lvgl_2048_rng_next(lvgl_2048_rng_t *rng);
+lvgl_2048_board_t lvgl_2048_board_add_random(lvgl_2048_board_t board, lvgl_2048_rng_t *rng); // 随机空格放入2
+
+/* 单块数字一次移动的轨迹（界面差异/动画使用；4×4按行轨迹表查得，其余逐格计算） */
+typedef struct
+{
+    uint8_t from_row;
+    uint8_t from_col;
+    uint8_t to_row;
+    uint8_t to_col;
+    uint8_t merged; // 1表示到达后与另一块合并
+} lvgl_2048_tile_move_t;
+
+typedef struct
+{
+    lvgl_2048_tile_move_t moves[LVGL_2048_MAX_CELLS]; // 只记录位置变化或参与合并的数字块
+    int count;
+} lvgl_2048_move_trace_t;
+
+/* 与lvgl_2048_board_move结果相同，并额外记录每块数字的去向 */
+lvgl_2048_board_t lvgl_2048_board_move_trace(lvgl_2048_board_t board, lvgl_2048_dir_t dir,
+                                             lvgl_2048_move_trace_t *trace);
+
+/*
+ * 通用N×N棋盘（N为3..8）：cells按行存放每格的指数，共N*N个
+ * N为4时走位棋盘查表（含轨迹），其余逐格计算，规则与位棋盘完全相同
+ */
+int lvgl_2048_grid_move(uint8_t *cells, int n, lvgl_2048_dir_t dir, lvgl_2048_move_trace_t *trace); // 移动成功返回1，trace可为NULL
+int lvgl_2048_grid_can_move(const uint8_t *cells, int n);                                          // 任一方向可移动返回1
+int lvgl_2048_grid_add_random(uint8_t *cells, int n, lvgl_2048_rng_t *rng);                        // 随机空格放入2，返回格子序号，没有空格返回-1
+lvgl_2048_board_t lvgl_2048_grid_to_board(const uint8_t *cells);                                   // 4×4格子数组与位棋盘互转
+void lvgl_2048_board_to_grid(lvgl_2048_board_t board, uint8_t *cells);
+
+/* 读写单个格子的指数 */
+static inline int lvgl_2048_board_get(lvgl_2048_board_t board, int row, int col)
+{
+    return (int)((board >> (row * 16 + col * 4)) & 0xF);
+}
+
+static inline lvgl_2048_board_t lvgl_2048_board_set(lvgl_2048_board_t board, int row, int col, int exp)
+{
+    int shift = row * 16 + col * 4;
+    return (board & ~((lvgl_2048_board_t)0xF << shift)) | ((lvgl_2048_board_t)(exp & 0xF) << shift);
+}
+
+/* 数值与指数互转：0 <-> 0，2 <-> 1，4 <-> 2 ... */
+int lvgl_2048_value_to_exp(int value);
+static inline int lvgl_2048_exp_to_value(int exp)
+{
+    return exp == 0 ? 0 : (1 << exp);
+}
+
+#endif
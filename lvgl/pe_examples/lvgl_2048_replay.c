@@ -0,0 +1,128 @@
+#include "lvgl_2048_replay.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void put_u32(uint8_t *buf, uint32_t v)
+{
+    buf[0] = (uint8_t)v;
+    buf[1] = (uint8_t)(v >> 8);
+    buf[2] = (uint8_t)(v >> 16);
+    buf[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+void lvgl_2048_replay_init(lvgl_2048_replay_t *log, uint32_t seed)
+{
+    memset(log, 0, sizeof(*log));
+    log->seed = seed;
+}
+
+void lvgl_2048_replay_free(lvgl_2048_replay_t *log)
+{
+    free(log->moves);
+    log->moves = NULL;
+    log->capacity = 0;
+    log->move_cnt = 0;
+}
+
+int lvgl_2048_replay_record(lvgl_2048_replay_t *log, lvgl_2048_dir_t dir)
+{
+    if (log->move_cnt >= log->capacity)
+    {
+        if (log->move_cnt >= LVGL_2048_REPLAY_MAX_MOVES)
+            return 0;
+        /* 容量始终是4的倍数，翻倍会超过上限时直接取上限 */
+        uint32_t capacity = LVGL_2048_REPLAY_MAX_MOVES;
+        if (log->capacity == 0)
+            capacity = 1024;
+        else if (log->capacity <= LVGL_2048_REPLAY_MAX_MOVES / 2)
+            capacity = log->capacity * 2;
+        uint8_t *moves = realloc(log->moves, capacity / 4);
+        if (moves == NULL)
+            return 0;
+        memset(moves + log->capacity / 4, 0, (capacity - log->capacity) / 4);
+        log->moves = moves;
+        log->capacity = capacity;
+    }
+    log->moves[log->move_cnt >> 2] |= (uint8_t)((dir & 3) << ((log->move_cnt & 3) * 2));
+    log->move_cnt++;
+    return 1;
+}
+
+lvgl_2048_dir_t lvgl_2048_replay_get(const lvgl_2048_replay_t *log, uint32_t index)
+{
+    return (lvgl_2048_dir_t)((log->moves[index >> 2] >> ((index & 3) * 2)) & 3);
+}
+
+size_t lvgl_2048_replay_save(const lvgl_2048_replay_t *log, uint8_t *buf, size_t size)
+{
+    size_t data_size = (log->move_cnt + 3) / 4;
+    size_t need = LVGL_2048_REPLAY_HEADER_SIZE + data_size;
+    if (buf == NULL || size < need)
+        return need;
+    put_u32(buf, log->seed);
+    put_u32(buf + 4, log->move_cnt);
+    if (data_size)
+        memcpy(buf + LVGL_2048_REPLAY_HEADER_SIZE, log->moves, data_size);
+    return need;
+}
+
+int lvgl_2048_replay_load(lvgl_2048_replay_t *log, const uint8_t *buf, size_t size)
+{
+    if (size < LVGL_2048_REPLAY_HEADER_SIZE)
+        return 0;
+    uint32_t move_cnt = get_u32(buf + 4);
+    if (move_cnt > LVGL_2048_REPLAY_MAX_MOVES)
+        return 0;
+    size_t data_size = ((size_t)move_cnt + 3) / 4;
+    if (size - LVGL_2048_REPLAY_HEADER_SIZE < data_size)
+        return 0;
+
+    lvgl_2048_replay_init(log, get_u32(buf));
+    if (move_cnt == 0)
+        return 1;
+    uint32_t capacity = (move_cnt + 3) & ~3u;
+    log->moves = malloc(capacity / 4);
+    if (log->moves == NULL)
+        return 0;
+    memcpy(log->moves, buf + LVGL_2048_REPLAY_HEADER_SIZE, data_size);
+    log->capacity = capacity;
+    log->move_cnt = move_cnt;
+    return 1;
+}
+
+lvgl_2048_board_t lvgl_2048_replay_start_board(uint32_t seed, lvgl_2048_rng_t *rng)
+{
+    lvgl_2048_engine_init();
+    lvgl_2048_rng_seed(rng, seed);
+    lvgl_2048_board_t board = lvgl_2048_board_add_random(0, rng);
+    return lvgl_2048_board_add_random(board, rng);
+}
+
+lvgl_2048_board_t lvgl_2048_replay_run(const lvgl_2048_replay_t *log, uint32_t move_cnt,
+                                       lvgl_2048_rng_t *rng, uint32_t *applied)
+{
+    lvgl_2048_rng_t local_rng;
+    if (rng == NULL)
+        rng = &local_rng;
+    if (move_cnt > log->move_cnt)
+        move_cnt = log->move_cnt;
+
+    lvgl_2048_board_t board = lvgl_2048_replay_start_board(log->seed, rng);
+    uint32_t i;
+    for (i = 0; i < move_cnt; i++)
+    {
+        lvgl_2048_dir_t dir = (lvgl_2048_dir_t)((log->moves[i >> 2] >> ((i & 3) * 2)) & 3);
+        lvgl_2048_board_t moved = lvgl_2048_board_move(board, dir);
+        if (moved == board) // 记录里只有有效移动，出现无效移动说明记录与引擎不一致
+            break;
+        board = lvgl_2048_board_add_random(moved, rng);
+    }
+    if (applied)
+        *applied = i;
+    return board;
+}
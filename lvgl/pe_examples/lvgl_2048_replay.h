@@ -0,0 +1,42 @@
+#ifndef __LVGL_2048_REPLAY_H
+#define __LVGL_2048_REPLAY_H
+
+#include "lvgl_2048_engine.h"
+#include <stddef.h>
+
+/*
+ * 2048 对局记录与回放（不依赖LVGL）
+ * 一局由种子和有效移动序列唯一确定：开局用种子生成两个2，之后每次有效移动后生成一个2
+ * 二进制格式（小端）：种子4字节 + 移动步数4字节 + 每步2位（每字节4步，低位在前）
+ */
+
+#define LVGL_2048_REPLAY_HEADER_SIZE 8
+#define LVGL_2048_REPLAY_MAX_MOVES (UINT32_MAX & ~3u) // 步数上限，按4步对齐的容量不会回绕
+
+typedef struct
+{
+    uint32_t seed;
+    uint32_t move_cnt;
+    uint32_t capacity; // moves缓冲区可容纳的步数
+    uint8_t *moves;    // 每步2位（lvgl_2048_dir_t）
+} lvgl_2048_replay_t;
+
+void lvgl_2048_replay_init(lvgl_2048_replay_t *log, uint32_t seed); // 开始新记录
+void lvgl_2048_replay_free(lvgl_2048_replay_t *log);                // 释放缓冲区
+int lvgl_2048_replay_record(lvgl_2048_replay_t *log, lvgl_2048_dir_t dir); // 追加一步，内存不足或达到步数上限返回0
+lvgl_2048_dir_t lvgl_2048_replay_get(const lvgl_2048_replay_t *log, uint32_t index);
+
+/* 序列化：返回所需字节数，buf为NULL或空间不足时只返回长度不写入 */
+size_t lvgl_2048_replay_save(const lvgl_2048_replay_t *log, uint8_t *buf, size_t size);
+/* 反序列化到log（会先调用lvgl_2048_replay_init），数据不完整或步数超过上限返回0 */
+int lvgl_2048_replay_load(lvgl_2048_replay_t *log, const uint8_t *buf, size_t size);
+
+/* 开局棋盘：用种子生成两个2，rng返回后续状态 */
+lvgl_2048_board_t lvgl_2048_replay_start_board(uint32_t seed, lvgl_2048_rng_t *rng);
+
+/* 无界面快进：从开局执行前move_cnt步（超过记录长度按全部计算），返回最终棋盘
+ * rng非NULL时返回结束时的随机数状态，可据此继续游戏；遇到无效移动时返回已执行的步数到*applied */
+lvgl_2048_board_t lvgl_2048_replay_run(const lvgl_2048_replay_t *log, uint32_t move_cnt,
+                                       lvgl_2048_rng_t *rng, uint32_t *applied);
+
+#endif
@@ -0,0 +1,721 @@
+#include "lvgl_2048_solver.h"
+#include "lvgl/lvgl.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* 启发函数参数（每行独立计算后查表累加） */
+#define HEUR_LOST_PENALTY 200000.0f // 基础分，保证评估值为正
+#define HEUR_MONO_WEIGHT 47.0f      // 单调性权重
+#define HEUR_SUM_WEIGHT 11.0f       // 大数分散惩罚
+#define HEUR_MERGES_WEIGHT 700.0f   // 可合并奖励
+#define HEUR_EMPTY_WEIGHT 270.0f    // 空格奖励
+
+#define CPROB_THRESHOLD 0.0001f // 概率低于此值的分支直接估值
+#define TT_BITS 18              // 置换表大小 2^18 项
+#define ABORT_CHECK_MASK 1023   // 每1024个节点检查一次时间
+#define MC_BATCH 8              // 蒙特卡洛：每个任务包含的模拟局数
+#define MC_MAX_STEPS 4096       // 单局模拟最多步数
+#define MC_MAX_THREADS 32
+
+/* 每行的启发值与得分表 */
+static float row_heur_table[65536];
+static uint32_t row_score_table[65536];
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t request_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t request_cond = PTHREAD_COND_INITIALIZER;
+static int request_busy = 0; // 以下受request_mutex保护
+static int solver_thread_started = 0;
+static struct solver_job_s *pending_job = NULL;
+static void (*lvgl_lock_cb)(void) = NULL; // 由应用层通过lvgl_2048_solver_set_port()传入
+static void (*lvgl_unlock_cb)(void) = NULL;
+static void (*wake_cb)(void) = NULL;
+
+/* 置换表只分配一次，各次搜索共用；同步接口可能与后台线程并发调用，故整个搜索期间加锁 */
+static pthread_mutex_t tt_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************
+ *  公共工具
+ **********************/
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void init_tables(void)
+{
+    lvgl_2048_engine_init();
+    for (uint32_t row = 0; row < 65536; row++)
+    {
+        int line[4];
+        for (int j = 0; j < 4; j++)
+        {
+            line[j] = (row >> (j * 4)) & 0xF;
+        }
+
+        /* 得分：合成2^e累计获得 (e-1)*2^e 分 */
+        uint32_t score = 0;
+        float sum = 0;
+        int empty = 0;
+        int merges = 0;
+        int prev = 0;
+        int counter = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            int rank = line[j];
+            if (rank >= 2)
+                score += (uint32_t)(rank - 1) * (1u << rank);
+            sum += (float)(rank * rank * rank);
+            if (rank == 0)
+            {
+                empty++;
+            }
+            else
+            {
+                if (prev == rank)
+                {
+                    counter++;
+                }
+                else if (counter > 0)
+                {
+                    merges += 1 + counter;
+                    counter = 0;
+                }
+                prev = rank;
+            }
+        }
+        if (counter > 0)
+            merges += 1 + counter;
+
+        /* 单调性：向左、向右递减的代价取小者 */
+        float mono_left = 0;
+        float mono_right = 0;
+        for (int j = 1; j < 4; j++)
+        {
+            float a = (float)(line[j - 1] * line[j - 1] * line[j - 1] * line[j - 1]);
+            float b = (float)(line[j] * line[j] * line[j] * line[j]);
+            if (line[j - 1] > line[j])
+                mono_left += a - b;
+            else
+                mono_right += b - a;
+        }
+
+        row_score_table[row] = score;
+        row_heur_table[row] = HEUR_LOST_PENALTY +
+                              HEUR_EMPTY_WEIGHT * (float)empty +
+                              HEUR_MERGES_WEIGHT * (float)merges -
+                              HEUR_MONO_WEIGHT * (mono_left < mono_right ? mono_left : mono_right) -
+                              HEUR_SUM_WEIGHT * sum;
+    }
+}
+
+static float board_heuristic(lvgl_2048_board_t board)
+{
+    lvgl_2048_board_t t = lvgl_2048_board_transpose(board);
+    return row_heur_table[board & 0xFFFF] + row_heur_table[(board >> 16) & 0xFFFF] +
+           row_heur_table[(board >> 32) & 0xFFFF] + row_heur_table[(board >> 48) & 0xFFFF] +
+           row_heur_table[t & 0xFFFF] + row_heur_table[(t >> 16) & 0xFFFF] +
+           row_heur_table[(t >> 32) & 0xFFFF] + row_heur_table[(t >> 48) & 0xFFFF];
+}
+
+static uint32_t board_score(lvgl_2048_board_t board)
+{
+    return row_score_table[board & 0xFFFF] + row_score_table[(board >> 16) & 0xFFFF] +
+           row_score_table[(board >> 32) & 0xFFFF] + row_score_table[(board >> 48) & 0xFFFF];
+}
+
+void lvgl_2048_solver_cfg_init(lvgl_2048_solver_cfg_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->mode = LVGL_2048_SOLVER_EXPECTIMAX;
+    cfg->max_depth = 3;
+    cfg->time_ms = 0;
+    cfg->rollouts = 200;
+    cfg->threads = 0;
+}
+
+/**********************
+ *  Expectimax
+ **********************/
+
+/* 置换表项：gen区分每一轮迭代加深，depth为写入时距根的深度（越浅搜索越深） */
+typedef struct
+{
+    lvgl_2048_board_t board;
+    float score;
+    uint16_t depth;
+    uint16_t gen;
+} tt_entry_t;
+
+typedef struct
+{
+    tt_entry_t *tt;
+    uint16_t gen;
+    int depth_limit;
+    uint64_t deadline; // 0表示不限时
+    uint32_t nodes;
+    int aborted;
+} expectimax_state_t;
+
+static float expectimax_max_node(expectimax_state_t *st, lvgl_2048_board_t board, float cprob, int depth);
+
+static float expectimax_chance_node(expectimax_state_t *st, lvgl_2048_board_t board, float cprob, int depth)
+{
+    if (cprob < CPROB_THRESHOLD || depth >= st->depth_limit)
+        return board_heuristic(board);
+
+    if (st->deadline && (++st->nodes & ABORT_CHECK_MASK) == 0 && now_ms() >= st->deadline)
+        st->aborted = 1;
+    if (st->aborted)
+        return 0;
+
+    /* 置换表只在浅层使用，深层节点数多且复用率低 */
+    tt_entry_t *entry = NULL;
+    if (depth < st->depth_limit - 1)
+    {
+        uint64_t h = board * 0x9E3779B97F4A7C15ULL;
+        entry = &st->tt[h >> (64 - TT_BITS)];
+        if (entry->gen == st->gen && entry->board == board && entry->depth <= depth)
+            return entry->score;
+    }
+
+    int num_empty = lvgl_2048_board_count_empty(board);
+    cprob /= (float)num_empty;
+
+    float res = 0;
+    lvgl_2048_board_t tmp = board;
+    lvgl_2048_board_t tile_2 = 1;
+    while (tile_2)
+    {
+        if ((tmp & 0xF) == 0)
+        {
+            res += expectimax_max_node(st, board | tile_2, cprob * 0.9f, depth) * 0.9f;
+            res += expectimax_max_node(st, board | (tile_2 << 1), cprob * 0.1f, depth) * 0.1f;
+        }
+        tmp >>= 4;
+        tile_2 <<= 4;
+    }
+    res /= (float)num_empty;
+
+    if (entry && !st->aborted)
+    {
+        entry->board = board;
+        entry->score = res;
+        entry->depth = (uint16_t)depth;
+        entry->gen = st->gen;
+    }
+    return res;
+}
+
+static float expectimax_max_node(expectimax_state_t *st, lvgl_2048_board_t board, float cprob, int depth)
+{
+    float best = 0;
+    for (int dir = 0; dir < 4; dir++)
+    {
+        lvgl_2048_board_t moved = lvgl_2048_board_move(board, (lvgl_2048_dir_t)dir);
+        if (moved == board)
+            continue;
+        float score = expectimax_chance_node(st, moved, cprob, depth + 1);
+        if (score > best)
+            best = score;
+    }
+    return best;
+}
+
+static int expectimax_best_move(lvgl_2048_board_t board, const lvgl_2048_solver_cfg_t *cfg)
+{
+    static tt_entry_t *tt = NULL;
+    static uint16_t tt_gen = 0;
+
+    pthread_mutex_lock(&tt_mutex);
+    if (tt == NULL)
+    {
+        tt = calloc((size_t)1 << TT_BITS, sizeof(tt_entry_t));
+        if (tt == NULL)
+        {
+            pthread_mutex_unlock(&tt_mutex);
+            return -1;
+        }
+    }
+
+    /* gen延续上一次搜索，旧表项自然失效；仅在gen回绕时清空整张表 */
+    int max_depth = cfg->max_depth > 0 ? cfg->max_depth : 1;
+    if ((uint32_t)tt_gen + (uint32_t)max_depth > UINT16_MAX)
+    {
+        memset(tt, 0, sizeof(tt_entry_t) << TT_BITS);
+        tt_gen = 0;
+    }
+
+    expectimax_state_t st;
+    memset(&st, 0, sizeof(st));
+    st.tt = tt;
+    st.gen = tt_gen;
+    if (cfg->time_ms)
+        st.deadline = now_ms() + cfg->time_ms;
+
+    int best_dir = -1;
+
+    /* 限时则迭代加深，超时丢弃未完成的一轮；不限时直接搜到最大深度 */
+    for (int limit = cfg->time_ms ? 1 : max_depth; limit <= max_depth; limit++)
+    {
+        float best = -1;
+        int dir_found = -1;
+        st.depth_limit = limit;
+        st.gen++;
+        for (int dir = 0; dir < 4; dir++)
+        {
+            lvgl_2048_board_t moved = lvgl_2048_board_move(board, (lvgl_2048_dir_t)dir);
+            if (moved == board)
+                continue;
+            float score = expectimax_chance_node(&st, moved, 1.0f, 0);
+            if (score > best)
+            {
+                best = score;
+                dir_found = dir;
+            }
+        }
+        if (st.aborted)
+            break;
+        best_dir = dir_found;
+    }
+
+    /* 第一轮就超时：至少给出一个可走的方向 */
+    if (best_dir < 0)
+    {
+        for (int dir = 0; dir < 4 && best_dir < 0; dir++)
+        {
+            if (lvgl_2048_board_move(board, (lvgl_2048_dir_t)dir) != board)
+                best_dir = dir;
+        }
+    }
+    tt_gen = st.gen;
+    pthread_mutex_unlock(&tt_mutex);
+    return best_dir;
+}
+
+/**********************
+ *  Monte-Carlo（常驻工作窃取线程池）
+ **********************/
+
+/* 任务：对某一首步方向做MC_BATCH局随机模拟 */
+typedef struct
+{
+    uint8_t dir;
+} mc_task_t;
+
+/* 每个工作线程一个双端队列：自己从尾部取，其他线程从头部窃取 */
+typedef struct
+{
+    pthread_mutex_t mutex;
+    mc_task_t *tasks;
+    int cap; // tasks已分配的个数，只增不减，各次搜索复用
+    int head;
+    int tail;
+} mc_deque_t;
+
+typedef struct mc_pool_s mc_pool_t;
+
+typedef struct
+{
+    mc_pool_t *pool;
+    int id;
+    uint32_t round; // 常驻线程已处理到的轮次
+    uint64_t rng;
+    uint64_t sum[4];   // 每个首步方向的累计得分
+    uint32_t count[4]; // 每个首步方向的模拟局数
+} mc_worker_t;
+
+struct mc_pool_s
+{
+    lvgl_2048_board_t root[4]; // 每个方向走完首步后的棋盘
+    mc_deque_t deques[MC_MAX_THREADS];
+    mc_worker_t workers[MC_MAX_THREADS];
+    int worker_cnt; // 本次搜索参与的线程数（含发起搜索的线程）
+    uint64_t deadline;
+
+    /* 常驻线程（编号1..helper_cnt）按需创建后一直保留，每次搜索只唤醒，不再创建和回收 */
+    pthread_mutex_t mutex;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    int helper_cnt;
+    uint32_t round; // 每开始一次搜索加1
+    int running;    // 本轮尚未完成的常驻线程数
+};
+
+static mc_pool_t mc_pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .start_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+};
+static pthread_once_t mc_pool_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t mc_search_mutex = PTHREAD_MUTEX_INITIALIZER; // 线程池同一时间只服务一次搜索
+
+static uint64_t mc_rand(uint64_t *state)
+{
+    /* xorshift64* */
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static lvgl_2048_board_t mc_spawn(lvgl_2048_board_t board, uint64_t *rng)
+{
+    int empty = lvgl_2048_board_count_empty(board);
+    if (empty == 0)
+        return board;
+    uint64_t r = mc_rand(rng);
+    return lvgl_2048_board_spawn(board, (int)((r >> 32) % (uint32_t)empty), (r & 0xFFFF) < 6554 ? 2 : 1);
+}
+
+/* 随机走到无路可走，返回最终得分 */
+static uint32_t mc_rollout(lvgl_2048_board_t board, uint64_t *rng)
+{
+    board = mc_spawn(board, rng);
+    for (int step = 0; step < MC_MAX_STEPS; step++)
+    {
+        int first = (int)(mc_rand(rng) >> 62);
+        lvgl_2048_board_t moved = board;
+        for (int k = 0; k < 4 && moved == board; k++)
+        {
+            moved = lvgl_2048_board_move(board, (lvgl_2048_dir_t)((first + k) & 3));
+        }
+        if (moved == board)
+            break;
+        board = mc_spawn(moved, rng);
+    }
+    return board_score(board);
+}
+
+static int mc_pop(mc_deque_t *dq, int steal, mc_task_t *task)
+{
+    int ok = 0;
+    pthread_mutex_lock(&dq->mutex);
+    if (dq->head < dq->tail)
+    {
+        *task = steal ? dq->tasks[dq->head++] : dq->tasks[--dq->tail];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&dq->mutex);
+    return ok;
+}
+
+static void mc_worker_run(mc_worker_t *w)
+{
+    mc_pool_t *pool = w->pool;
+    mc_task_t task;
+
+    while (1)
+    {
+        if (pool->deadline && now_ms() >= pool->deadline)
+            break;
+
+        int found = mc_pop(&pool->deques[w->id], 0, &task);
+        for (int k = 1; !found && k < pool->worker_cnt; k++)
+        {
+            found = mc_pop(&pool->deques[(w->id + k) % pool->worker_cnt], 1, &task);
+        }
+        if (!found) // 所有队列均为空，任务不会再增加
+            break;
+
+        for (int i = 0; i < MC_BATCH; i++)
+        {
+            w->sum[task.dir] += mc_rollout(pool->root[task.dir], &w->rng);
+            w->count[task.dir]++;
+        }
+    }
+}
+
+/* 常驻线程：等待新一轮搜索，参与本轮则取任务直到队列为空，再通知发起搜索的线程 */
+static void *mc_helper_main(void *arg)
+{
+    mc_worker_t *w = arg;
+    mc_pool_t *pool = w->pool;
+
+    while (1)
+    {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->round == w->round)
+        {
+            pthread_cond_wait(&pool->start_cond, &pool->mutex);
+        }
+        w->round = pool->round;
+        int active = w->id < pool->worker_cnt;
+        pthread_mutex_unlock(&pool->mutex);
+        if (!active)
+            continue;
+
+        mc_worker_run(w);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->running == 0)
+            pthread_cond_signal(&pool->done_cond);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    return NULL;
+}
+
+static void mc_pool_init(void)
+{
+    for (int t = 0; t < MC_MAX_THREADS; t++)
+    {
+        pthread_mutex_init(&mc_pool.deques[t].mutex, NULL);
+        mc_pool.workers[t].pool = &mc_pool;
+        mc_pool.workers[t].id = t;
+    }
+}
+
+static int cpu_count(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n > 0)
+        return (int)n;
+#endif
+    return 4;
+}
+
+static int monte_carlo_best_move(lvgl_2048_board_t board, const lvgl_2048_solver_cfg_t *cfg)
+{
+    mc_pool_t *pool = &mc_pool;
+    pthread_once(&mc_pool_once, mc_pool_init);
+    pthread_mutex_lock(&mc_search_mutex);
+
+    int legal[4];
+    int legal_cnt = 0;
+    for (int dir = 0; dir < 4; dir++)
+    {
+        pool->root[dir] = lvgl_2048_board_move(board, (lvgl_2048_dir_t)dir);
+        if (pool->root[dir] != board)
+            legal[legal_cnt++] = dir;
+    }
+    if (legal_cnt == 0)
+    {
+        pthread_mutex_unlock(&mc_search_mutex);
+        return -1;
+    }
+
+    int threads = cfg->threads > 0 ? cfg->threads : cpu_count();
+    if (threads > MC_MAX_THREADS)
+        threads = MC_MAX_THREADS;
+
+    /* 补齐本次需要的常驻线程，创建失败就只用已有的线程 */
+    while (pool->helper_cnt < threads - 1)
+    {
+        mc_worker_t *w = &pool->workers[pool->helper_cnt + 1];
+        pthread_t tid;
+        w->round = pool->round;
+        if (pthread_create(&tid, NULL, mc_helper_main, w) != 0)
+            break;
+        pthread_detach(tid);
+        pool->helper_cnt++;
+    }
+    if (threads > pool->helper_cnt + 1)
+        threads = pool->helper_cnt + 1;
+    pool->deadline = cfg->time_ms ? now_ms() + cfg->time_ms : 0;
+
+    /* 按方向轮流把任务平均分给各线程的队列 */
+    int rollouts = cfg->rollouts > 0 ? cfg->rollouts : 1;
+    int batches = (rollouts + MC_BATCH - 1) / MC_BATCH;
+    int total = batches * legal_cnt;
+    int per_worker = (total + threads - 1) / threads;
+    uint64_t seed = now_ms() ^ board;
+    for (int t = 0; t < threads; t++)
+    {
+        mc_deque_t *dq = &pool->deques[t];
+        if (dq->cap < per_worker)
+        {
+            mc_task_t *tasks = realloc(dq->tasks, sizeof(mc_task_t) * (size_t)per_worker);
+            /* 任一队列分配失败则整个搜索失败，避免悄悄少做一部分模拟 */
+            if (tasks == NULL)
+            {
+                pthread_mutex_unlock(&mc_search_mutex);
+                return -1;
+            }
+            dq->tasks = tasks;
+            dq->cap = per_worker;
+        }
+        dq->head = 0;
+        dq->tail = 0;
+        memset(pool->workers[t].sum, 0, sizeof(pool->workers[t].sum));
+        memset(pool->workers[t].count, 0, sizeof(pool->workers[t].count));
+        pool->workers[t].rng = (seed + (uint64_t)(t + 1) * 0x9E3779B97F4A7C15ULL) | 1;
+    }
+    for (int i = 0; i < total; i++)
+    {
+        mc_deque_t *dq = &pool->deques[i % threads];
+        dq->tasks[dq->tail++].dir = (uint8_t)legal[i % legal_cnt];
+    }
+
+    /* 唤醒常驻线程开始新一轮，当前线程也参与计算，最后等所有参与的线程做完 */
+    pthread_mutex_lock(&pool->mutex);
+    pool->worker_cnt = threads;
+    pool->running = threads - 1;
+    pool->round++;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    mc_worker_run(&pool->workers[0]);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->running > 0)
+    {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    /* 汇总：选平均得分最高的方向 */
+    int best_dir = legal[0];
+    double best = -1;
+    for (int k = 0; k < legal_cnt; k++)
+    {
+        int dir = legal[k];
+        uint64_t sum = 0;
+        uint32_t count = 0;
+        for (int t = 0; t < threads; t++)
+        {
+            sum += pool->workers[t].sum[dir];
+            count += pool->workers[t].count[dir];
+        }
+        double avg = count ? (double)sum / count : 0;
+        if (avg > best)
+        {
+            best = avg;
+            best_dir = dir;
+        }
+    }
+
+    pthread_mutex_unlock(&mc_search_mutex);
+    return best_dir;
+}
+
+int lvgl_2048_solver_best_move(lvgl_2048_board_t board, const lvgl_2048_solver_cfg_t *cfg)
+{
+    lvgl_2048_solver_cfg_t def_cfg;
+    if (cfg == NULL)
+    {
+        lvgl_2048_solver_cfg_init(&def_cfg);
+        cfg = &def_cfg;
+    }
+    pthread_once(&tables_once, init_tables);
+
+    if (cfg->mode == LVGL_2048_SOLVER_MONTE_CARLO)
+        return monte_carlo_best_move(board, cfg);
+    return expectimax_best_move(board, cfg);
+}
+
+/**********************
+ *  异步搜索
+ **********************/
+
+typedef struct solver_job_s
+{
+    lvgl_2048_board_t board;
+    lvgl_2048_solver_cfg_t cfg;
+    lvgl_2048_solver_cb_t cb;
+    void *user_data;
+    int dir;
+} solver_job_t;
+
+/* 在LVGL线程中执行 */
+static void solver_deliver(void *arg)
+{
+    solver_job_t *job = arg;
+    job->cb(job->board, job->dir, job->user_data);
+    free(job);
+}
+
+/* 常驻搜索线程：首次请求时创建，之后等待pending_job，避免每次提示都新建线程 */
+static void *solver_thread_main(void *arg)
+{
+    (void)arg;
+    while (1)
+    {
+        pthread_mutex_lock(&request_mutex);
+        while (pending_job == NULL)
+        {
+            pthread_cond_wait(&request_cond, &request_mutex);
+        }
+        solver_job_t *job = pending_job;
+        pending_job = NULL;
+        void (*lock)(void) = lvgl_lock_cb;
+        void (*unlock)(void) = lvgl_unlock_cb;
+        void (*wake)(void) = wake_cb;
+        pthread_mutex_unlock(&request_mutex);
+
+        job->dir = lvgl_2048_solver_best_move(job->board, &job->cfg);
+
+        pthread_mutex_lock(&request_mutex);
+        request_busy = 0;
+        pthread_mutex_unlock(&request_mutex);
+
+        lock();
+        if (lv_async_call(solver_deliver, job) != LV_RES_OK)
+            free(job);
+        else if (wake)
+            wake(); // LVGL线程可能正在休眠等待事件
+        unlock();
+    }
+    return NULL;
+}
+
+int lvgl_2048_solver_request(lvgl_2048_board_t board, const lvgl_2048_solver_cfg_t *cfg,
+                             lvgl_2048_solver_cb_t cb, void *user_data)
+{
+    pthread_mutex_lock(&request_mutex);
+    if (request_busy || lvgl_lock_cb == NULL || lvgl_unlock_cb == NULL)
+    {
+        pthread_mutex_unlock(&request_mutex);
+        return 0;
+    }
+
+    if (!solver_thread_started)
+    {
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, solver_thread_main, NULL) != 0)
+        {
+            pthread_mutex_unlock(&request_mutex);
+            return 0;
+        }
+        pthread_detach(tid);
+        solver_thread_started = 1;
+    }
+
+    solver_job_t *job = malloc(sizeof(solver_job_t));
+    if (job == NULL)
+    {
+        pthread_mutex_unlock(&request_mutex);
+        return 0;
+    }
+    job->board = board;
+    job->cb = cb;
+    job->user_data = user_data;
+    job->dir = -1;
+    if (cfg)
+        job->cfg = *cfg;
+    else
+        lvgl_2048_solver_cfg_init(&job->cfg);
+
+    request_busy = 1;
+    pending_job = job;
+    pthread_cond_signal(&request_cond);
+    pthread_mutex_unlock(&request_mutex);
+    return 1;
+}
+
+void lvgl_2048_solver_set_port(void (*lock)(void), void (*unlock)(void), void (*wake)(void))
+{
+    pthread_mutex_lock(&request_mutex);
+    lvgl_lock_cb = lock;
+    lvgl_unlock_cb = unlock;
+    wake_cb = wake;
+    pthread_mutex_unlock(&request_mutex);
+}
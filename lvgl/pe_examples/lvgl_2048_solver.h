@@ -0,0 +1,48 @@
+#ifndef __LVGL_2048_SOLVER_H
+#define __LVGL_2048_SOLVER_H
+
+#include "lvgl_2048_engine.h"
+
+/*
+ * 2048 求解器：根据当前棋盘给出最佳方向
+ * 同步接口可无界面调用（回放、AI评估）；异步接口在后台线程搜索，结果通过lv_async_call送回LVGL线程
+ */
+
+/* 搜索模式 */
+typedef enum
+{
+    LVGL_2048_SOLVER_EXPECTIMAX = 0, // 期望最大搜索 + 置换表
+    LVGL_2048_SOLVER_MONTE_CARLO,    // 多线程蒙特卡洛随机模拟
+} lvgl_2048_solver_mode_t;
+
+/* 搜索配置，先用lvgl_2048_solver_cfg_init()填默认值 */
+typedef struct
+{
+    lvgl_2048_solver_mode_t mode;
+    int max_depth;    // expectimax最大搜索深度（玩家移动步数）
+    uint32_t time_ms; // 时间预算(ms)，0表示只受深度/模拟次数限制
+    int rollouts;     // 蒙特卡洛：每个方向的模拟局数
+    int threads;      // 蒙特卡洛：工作线程数，0表示按CPU核数
+} lvgl_2048_solver_cfg_t;
+
+/* 异步搜索完成回调（在LVGL线程中执行）；dir<0表示无路可走 */
+typedef void (*lvgl_2048_solver_cb_t)(lvgl_2048_board_t board, int dir, void *user_data);
+
+void lvgl_2048_solver_cfg_init(lvgl_2048_solver_cfg_t *cfg);
+
+/* 同步搜索：返回最佳方向(lvgl_2048_dir_t)，无路可走返回-1 */
+int lvgl_2048_solver_best_move(lvgl_2048_board_t board, const lvgl_2048_solver_cfg_t *cfg);
+
+/* 异步搜索：交给常驻后台线程搜索，完成后用lv_async_call在LVGL线程调用cb
+ * return:1是已开始，0是上一次搜索尚未结束、未设置LVGL锁或线程创建失败 */
+int lvgl_2048_solver_request(lvgl_2048_board_t board, const lvgl_2048_solver_cfg_t *cfg,
+                             lvgl_2048_solver_cb_t cb, void *user_data);
+
+/*
+ * 设置移植层接口，需在异步搜索前调用
+ * lock/unlock：应用层的LVGL锁（lv_timer_handler()在加锁状态下调用），后台线程借此安全地调用lv_async_call
+ * wake：结果送回后在后台线程调用，用于唤醒正在休眠等待事件的LVGL线程，例如SDL驱动的sdl_wake_up()；NULL表示不需要唤醒
+ */
+void lvgl_2048_solver_set_port(void (*lock)(void), void (*unlock)(void), void (*wake)(void));
+
+#endif
@@ -2,6 +2,7 @@ CSRCS += lv_disp.c
 CSRCS += lv_group.c
 CSRCS += lv_indev.c
 CSRCS += lv_indev_scroll.c
+CSRCS += lv_indev_hit_grid.c
 CSRCS += lv_obj.c
 CSRCS += lv_obj_class.c
 CSRCS += lv_obj_draw.c
@@ -10,6 +10,7 @@
 #include "lv_disp.h"
 #include "lv_obj.h"
 #include "lv_indev_scroll.h"
+#include "lv_indev_hit_grid.h"
 #include "lv_group.h"
 #include "lv_refr.h"
 
@@ -313,6 +314,15 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
         int32_t i;
         uint32_t child_cnt = lv_obj_get_child_cnt(obj);
 
+#if LV_INDEV_HIT_GRID_MIN
+        /*With many children check only the ones around the point*/
+        if(child_cnt >= LV_INDEV_HIT_GRID_MIN) {
+            found_p = _lv_indev_hit_grid_search(obj, &p_trans);
+            if(found_p) return found_p;
+            child_cnt = 0;  /*The children are checked already*/
+        }
+#endif
+
         /*If a child matches use it*/
         for(i = child_cnt - 1; i >= 0; i--) {
             lv_obj_t * child = obj->spec_attr->children[i];
@@ -0,0 +1,331 @@
+/**
+ * @file lv_indev_hit_grid.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_indev.h"
+#include "lv_indev_hit_grid.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CELL_CNT_MAX    256     /*Max. number of columns and rows*/
+#define SPAN_CELL_MAX   16      /*Children covering more cells than this are checked for every point*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_INDEV_HIT_GRID_MIN
+typedef struct _lv_hit_grid_t {
+    lv_area_t area;         /*The area covered by the cells relative to the scrolled content of the parent*/
+    lv_coord_t cell_w;
+    lv_coord_t cell_h;
+    uint32_t col_cnt;
+    uint32_t row_cnt;
+    uint32_t * cell_start;  /*Index of the first item of each cell in `items`. The last element is the item count.*/
+    uint32_t * items;       /*Index of the children on each cell in increasing order*/
+    uint32_t * always;      /*Index of the children to check for every point in increasing order*/
+    uint32_t always_cnt;
+    size_t alloc_size;
+    uint8_t valid : 1;
+} _lv_hit_grid_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static _lv_hit_grid_t * grid_update(lv_obj_t * obj);
+static bool get_child_area(const lv_obj_t * obj, const lv_obj_t * child, lv_area_t * area);
+static bool get_cell_range(const _lv_hit_grid_t * grid, const lv_area_t * child_area, lv_area_t * range);
+static lv_obj_t * search_all(lv_obj_t * obj, lv_point_t * point);
+#endif /*LV_INDEV_HIT_GRID_MIN*/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * _lv_indev_hit_grid_search(lv_obj_t * obj, lv_point_t * point)
+{
+#if LV_INDEV_HIT_GRID_MIN
+    _lv_hit_grid_t * grid = obj->spec_attr->hit_grid;
+    if(grid == NULL || !grid->valid) grid = grid_update(obj);
+    if(grid == NULL) return search_all(obj, point);
+
+    /*Get the children around the point*/
+    const uint32_t * items = NULL;
+    uint32_t item_cnt = 0;
+    lv_point_t p_rel;
+    p_rel.x = point->x - obj->coords.x1 - obj->spec_attr->scroll.x;
+    p_rel.y = point->y - obj->coords.y1 - obj->spec_attr->scroll.y;
+    if(_lv_area_is_point_on(&grid->area, &p_rel, 0)) {
+        uint32_t col = (p_rel.x - grid->area.x1) / grid->cell_w;
+        uint32_t row = (p_rel.y - grid->area.y1) / grid->cell_h;
+        uint32_t cell = row * grid->col_cnt + col;
+        items = &grid->items[grid->cell_start[cell]];
+        item_cnt = grid->cell_start[cell + 1] - grid->cell_start[cell];
+    }
+
+    /*Check them and the children which can be anywhere from the top most child*/
+    uint32_t i = item_cnt;
+    uint32_t j = grid->always_cnt;
+    while(i > 0 || j > 0) {
+        uint32_t id;
+        if(j == 0 || (i > 0 && items[i - 1] > grid->always[j - 1])) {
+            i--;
+            id = items[i];
+        }
+        else {
+            j--;
+            id = grid->always[j];
+        }
+
+        lv_obj_t * found_p = lv_indev_search_obj(obj->spec_attr->children[id], point);
+        if(found_p) return found_p;
+
+        /*The children were changed in an event so the indices are not valid anymore*/
+        if(!grid->valid) break;
+    }
+
+    return NULL;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(point);
+    return NULL;
+#endif
+}
+
+void _lv_indev_hit_grid_invalidate(lv_obj_t * obj)
+{
+#if LV_INDEV_HIT_GRID_MIN
+    if(obj == NULL || obj->spec_attr == NULL) return;
+    if(obj->spec_attr->hit_grid) obj->spec_attr->hit_grid->valid = 0;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+void _lv_indev_hit_grid_free(lv_obj_t * obj)
+{
+#if LV_INDEV_HIT_GRID_MIN
+    if(obj->spec_attr == NULL || obj->spec_attr->hit_grid == NULL) return;
+    lv_mem_free(obj->spec_attr->hit_grid);
+    obj->spec_attr->hit_grid = NULL;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_INDEV_HIT_GRID_MIN
+
+/**
+ * Create the grid of an object's children again, reusing the memory of the previous grid
+ * @param obj       pointer to an object with children
+ * @return          pointer to the grid or NULL if it couldn't be allocated
+ */
+static _lv_hit_grid_t * grid_update(lv_obj_t * obj)
+{
+    uint32_t child_cnt = obj->spec_attr->child_cnt;
+    uint32_t i;
+
+    /*Find the area covered by the children which can be placed on the cells*/
+    lv_area_t area;
+    area.x1 = LV_COORD_MAX;
+    area.y1 = LV_COORD_MAX;
+    area.x2 = LV_COORD_MIN;
+    area.y2 = LV_COORD_MIN;
+    uint32_t area_child_cnt = 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_area_t a;
+        if(!get_child_area(obj, obj->spec_attr->children[i], &a)) continue;
+        if(a.x2 < a.x1 || a.y2 < a.y1) continue;
+        area.x1 = LV_MIN(area.x1, a.x1);
+        area.y1 = LV_MIN(area.y1, a.y1);
+        area.x2 = LV_MAX(area.x2, a.x2);
+        area.y2 = LV_MAX(area.y2, a.y2);
+        area_child_cnt++;
+    }
+
+    /*Have about one cell per child with cells of similar width and height*/
+    _lv_hit_grid_t tmp;
+    lv_memset_00(&tmp, sizeof(tmp));
+    tmp.area = area;
+    tmp.col_cnt = 1;
+    tmp.row_cnt = 1;
+    tmp.cell_w = 1;
+    tmp.cell_h = 1;
+    if(area_child_cnt > 0) {
+        uint64_t w = lv_area_get_width(&area);
+        uint64_t h = lv_area_get_height(&area);
+        uint32_t col_cnt = 1;
+        while(col_cnt < CELL_CNT_MAX && (uint64_t)col_cnt * col_cnt * h < area_child_cnt * w) col_cnt++;
+        uint32_t row_cnt = LV_CLAMP(1, (area_child_cnt + col_cnt - 1) / col_cnt, CELL_CNT_MAX);
+
+        tmp.cell_w = (lv_coord_t)((w + col_cnt - 1) / col_cnt);
+        tmp.cell_h = (lv_coord_t)((h + row_cnt - 1) / row_cnt);
+        tmp.col_cnt = (uint32_t)((w + tmp.cell_w - 1) / tmp.cell_w);
+        tmp.row_cnt = (uint32_t)((h + tmp.cell_h - 1) / tmp.cell_h);
+    }
+
+    /*Count the items of the cells and the children to check always*/
+    uint32_t item_cnt = 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_area_t a;
+        lv_area_t range;
+        if(!get_child_area(obj, obj->spec_attr->children[i], &a)) tmp.always_cnt++;
+        else if(get_cell_range(&tmp, &a, &range)) {
+            uint32_t span = lv_area_get_size(&range);
+            if(span > SPAN_CELL_MAX) tmp.always_cnt++;
+            else item_cnt += span;
+        }
+    }
+
+    uint32_t cell_cnt = tmp.col_cnt * tmp.row_cnt;
+    size_t size = sizeof(_lv_hit_grid_t) + (cell_cnt + 1 + item_cnt + tmp.always_cnt) * sizeof(uint32_t);
+
+    _lv_hit_grid_t * grid = obj->spec_attr->hit_grid;
+    if(grid == NULL || grid->alloc_size < size) {
+        if(grid) lv_mem_free(grid);
+        grid = lv_mem_alloc(size);
+        obj->spec_attr->hit_grid = grid;
+        LV_ASSERT_MALLOC(grid);
+        if(grid == NULL) return NULL;
+        tmp.alloc_size = size;
+    }
+    else {
+        tmp.alloc_size = grid->alloc_size;
+    }
+
+    tmp.cell_start = (uint32_t *)(grid + 1);
+    tmp.items = tmp.cell_start + cell_cnt + 1;
+    tmp.always = tmp.items + item_cnt;
+    tmp.valid = 1;
+    *grid = tmp;
+
+    /*Count the children of each cell. `cell_start[c + 1]` counts the children of the c-th cell.*/
+    lv_memset_00(grid->cell_start, (cell_cnt + 1) * sizeof(uint32_t));
+    uint32_t always_cnt = 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_area_t a;
+        lv_area_t range;
+        if(!get_child_area(obj, obj->spec_attr->children[i], &a)) {
+            grid->always[always_cnt] = i;
+            always_cnt++;
+        }
+        else if(get_cell_range(grid, &a, &range)) {
+            if(lv_area_get_size(&range) > SPAN_CELL_MAX) {
+                grid->always[always_cnt] = i;
+                always_cnt++;
+                continue;
+            }
+
+            lv_coord_t row;
+            lv_coord_t col;
+            for(row = range.y1; row <= range.y2; row++) {
+                for(col = range.x1; col <= range.x2; col++) {
+                    grid->cell_start[row * grid->col_cnt + col + 1]++;
+                }
+            }
+        }
+    }
+
+    /*`cell_start[c]` is the start of the c-th cell*/
+    for(i = 1; i <= cell_cnt; i++) grid->cell_start[i] += grid->cell_start[i - 1];
+
+    /*Fill the cells. `cell_start[c]` is moved to the start of the next cell meanwhile.*/
+    for(i = 0; i < child_cnt; i++) {
+        lv_area_t a;
+        lv_area_t range;
+        if(!get_child_area(obj, obj->spec_attr->children[i], &a)) continue;
+        if(!get_cell_range(grid, &a, &range)) continue;
+        if(lv_area_get_size(&range) > SPAN_CELL_MAX) continue;
+
+        lv_coord_t row;
+        lv_coord_t col;
+        for(row = range.y1; row <= range.y2; row++) {
+            for(col = range.x1; col <= range.x2; col++) {
+                uint32_t cell = row * grid->col_cnt + col;
+                grid->items[grid->cell_start[cell]] = i;
+                grid->cell_start[cell]++;
+            }
+        }
+    }
+
+    for(i = cell_cnt; i > 0; i--) grid->cell_start[i] = grid->cell_start[i - 1];
+    grid->cell_start[0] = 0;
+
+    return grid;
+}
+
+/**
+ * Get the area where a child can be found. It includes the extended click area.
+ * @param obj       pointer to the parent
+ * @param child     pointer to a child of `obj`
+ * @param area      store the area relative to the scrolled content of `obj` here
+ * @return          false: the child might be found outside of its area, so it should be checked for every point
+ */
+static bool get_child_area(const lv_obj_t * obj, const lv_obj_t * child, lv_area_t * area)
+{
+    /*Floating children don't move with the scrolled content. The others can be hit anywhere.*/
+    if(lv_obj_has_flag_any(child, LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+    if(_lv_obj_get_layer_type(child) == LV_LAYER_TYPE_TRANSFORM) return false;
+
+    lv_coord_t ext = child->spec_attr ? LV_MAX(child->spec_attr->ext_click_pad, 0) : 0;
+    lv_coord_t ofs_x = obj->coords.x1 + obj->spec_attr->scroll.x;
+    lv_coord_t ofs_y = obj->coords.y1 + obj->spec_attr->scroll.y;
+    area->x1 = child->coords.x1 - ext - ofs_x;
+    area->y1 = child->coords.y1 - ext - ofs_y;
+    area->x2 = child->coords.x2 + ext - ofs_x;
+    area->y2 = child->coords.y2 + ext - ofs_y;
+    return true;
+}
+
+/**
+ * Get the columns and rows of the cells covered by an area
+ * @param grid          pointer to a grid
+ * @param child_area    area of a child returned by `get_child_area`
+ * @param range         store the first and last column in `x1`/`x2` and the first and last row in `y1`/`y2`
+ * @return              false: the area is empty so it's not on any cell
+ */
+static bool get_cell_range(const _lv_hit_grid_t * grid, const lv_area_t * child_area, lv_area_t * range)
+{
+    if(child_area->x2 < child_area->x1 || child_area->y2 < child_area->y1) return false;
+
+    range->x1 = (child_area->x1 - grid->area.x1) / grid->cell_w;
+    range->y1 = (child_area->y1 - grid->area.y1) / grid->cell_h;
+    range->x2 = (child_area->x2 - grid->area.x1) / grid->cell_w;
+    range->y2 = (child_area->y2 - grid->area.y1) / grid->cell_h;
+    return true;
+}
+
+/**
+ * Check all the children of an object like `lv_indev_search_obj` does without a grid
+ * @param obj       pointer to an object
+ * @param point     the point to find the child on
+ * @return          the found object or NULL if nothing was found
+ */
+static lv_obj_t * search_all(lv_obj_t * obj, lv_point_t * point)
+{
+    int32_t i;
+    for(i = lv_obj_get_child_cnt(obj) - 1; i >= 0; i--) {
+        lv_obj_t * found_p = lv_indev_search_obj(obj->spec_attr->children[i], point);
+        if(found_p) return found_p;
+    }
+
+    return NULL;
+}
+
+#endif /*LV_INDEV_HIT_GRID_MIN*/
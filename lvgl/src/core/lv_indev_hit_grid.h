@@ -0,0 +1,61 @@
+/**
+ * @file lv_indev_hit_grid.h
+ *
+ */
+
+#ifndef LV_INDEV_HIT_GRID_H
+#define LV_INDEV_HIT_GRID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Search the children of an object for the one on a point using a grid of the children's position.
+ * The grid is created when it's used first and after the children were changed.
+ * Called by `lv_indev_search_obj` if the object has at least `LV_INDEV_HIT_GRID_MIN` children.
+ * @param obj       pointer to an object whose children should be checked
+ * @param point     the point to find the child on (already transformed by `obj`)
+ * @return          the found object (the child or one of its descendants) or NULL if nothing was found
+ */
+lv_obj_t * _lv_indev_hit_grid_search(lv_obj_t * obj, lv_point_t * point);
+
+/**
+ * Mark the grid of an object's children as invalid because a child was moved, resized, added, removed, etc.
+ * The grid will be created again on the next search.
+ * @param obj       pointer to an object whose children were changed. Can be NULL.
+ */
+void _lv_indev_hit_grid_invalidate(lv_obj_t * obj);
+
+/**
+ * Free the grid of an object's children
+ * @param obj       pointer to an object
+ */
+void _lv_indev_hit_grid_free(lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_INDEV_HIT_GRID_H*/
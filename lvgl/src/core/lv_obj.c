@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "lv_indev_hit_grid.h"
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "lv_disp.h"
@@ -196,6 +197,11 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+    _lv_refr_deinit();
+    lv_draw_deinit();
+    _lv_font_clean_up_fmt_txt();
+    _lv_font_fmt_txt_cache_free();
+    _lv_font_fmt_txt_free_all_fast_lookup();
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -261,6 +267,10 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &hor_area);
         lv_obj_invalidate_area(obj, &ver_area);
     }
+
+    if(f & (LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        _lv_indev_hit_grid_invalidate(lv_obj_get_parent(obj));
+    }
 }
 
 void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
@@ -289,6 +299,9 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+    if(f & (LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        _lv_indev_hit_grid_invalidate(lv_obj_get_parent(obj));
+    }
 }
 
 void lv_obj_add_state(lv_obj_t * obj, lv_state_t state)
@@ -474,6 +487,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+        _lv_indev_hit_grid_free(obj);
 
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
@@ -893,6 +907,9 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
 
+    /*The properties of the object and the inherited ones of its children might differ in the new state*/
+    _lv_obj_style_cache_invalidate(obj, LV_STYLE_PROP_ANY);
+
     _lv_obj_style_transition_dsc_t * ts = lv_mem_buf_get(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     lv_memset_00(ts, sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
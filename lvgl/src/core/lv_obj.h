@@ -161,6 +161,9 @@ extern "C"
         struct _lv_obj_t **children; /**< Store the pointer of the children in an array.*/
         uint32_t child_cnt;          /**< Number of children*/
         lv_group_t *group_p;
+#if LV_INDEV_HIT_GRID_MIN
+        struct _lv_hit_grid_t *hit_grid; /**< Grid of the children's position to find the pressed child faster*/
+#endif
 
         struct _lv_event_dsc_t *event_dsc; /**< Dynamically allocated event callback and user data array*/
         lv_point_t scroll;                 /**< The current X/Y scroll offset*/
@@ -190,8 +193,12 @@ extern "C"
 #endif
         lv_area_t coords;
         lv_obj_flag_t flags;
+#if LV_OBJ_STYLE_CACHE_SIZE
+        uint32_t style_cache_stamp; /**< Changes when the resolved style properties of the object might change*/
+#endif
         lv_state_t state;
         uint16_t layout_inv : 1;
+        uint16_t child_layout_inv : 1; /**< A descendant has an invalid layout or needs its scroll readjusted*/
         uint16_t readjust_scroll_after_layout : 1;
         uint16_t scr_layout_inv : 1;
         uint16_t skip_trans : 1;
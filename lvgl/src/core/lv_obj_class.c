@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_theme.h"
+#include "lv_indev_hit_grid.h"
 
 /*********************
  *      DEFINES
@@ -49,6 +50,8 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
     lv_memset_00(obj, s);
     obj->class_p = class_p;
     obj->parent = parent;
+    /*Don't use the cached style properties of a deleted object created at the same address*/
+    _lv_obj_style_cache_invalidate(obj, LV_STYLE_PROP_ANY);
 
     /*Create a screen*/
     if(parent == NULL) {
@@ -96,6 +99,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
                                                          sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
             parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
         }
+        _lv_indev_hit_grid_invalidate(parent);
     }
 
     return obj;
@@ -9,6 +9,7 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "lv_refr.h"
+#include "lv_indev_hit_grid.h"
 #include "../misc/lv_gc.h"
 
 /*********************
@@ -26,6 +27,7 @@
 static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static lv_obj_t * mark_parents_child_layout_inv(lv_obj_t * obj);
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
 
 /**********************
@@ -190,6 +192,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    _lv_indev_hit_grid_invalidate(parent);
 
     /*Call the ancestor's event handler to the object with its new coordinates*/
     lv_event_send(obj, LV_EVENT_SIZE_CHANGED, &ori);
@@ -201,6 +204,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_parents_child_layout_inv(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -289,8 +293,10 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
+    /*Mark the parents to find this object without checking the not changed parts of the screen*/
+    lv_obj_t * scr = mark_parents_child_layout_inv(obj);
+
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -760,6 +766,7 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y1 += diff.y;
     obj->coords.x2 += diff.x;
     obj->coords.y2 += diff.y;
+    _lv_indev_hit_grid_invalidate(parent);
 
     lv_obj_move_children_by(obj, diff.x, diff.y, false);
 
@@ -933,6 +940,7 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t size)
 
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->ext_click_pad = size;
+    _lv_indev_hit_grid_invalidate(lv_obj_get_parent(obj));
 }
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
@@ -1123,11 +1131,17 @@ static lv_coord_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
-    uint32_t i;
-    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+    /*Visit only the children which or whose descendants have something to do*/
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->child_layout_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1135,11 +1149,14 @@ static void layout_update_core(lv_obj_t * obj)
         lv_obj_refr_size(obj);
         lv_obj_refr_pos(obj);
 
-        if(child_cnt > 0) {
+        if(lv_obj_get_child_cnt(obj) > 0) {
             uint32_t layout_id = lv_obj_get_style_layout(obj, LV_PART_MAIN);
             if(layout_id > 0 && layout_id <= layout_cnt) {
                 void  * user_data = LV_GC_ROOT(_lv_layout_list)[layout_id - 1].user_data;
                 LV_GC_ROOT(_lv_layout_list)[layout_id - 1].cb(obj, user_data);
+
+                /*The layouts move the children directly*/
+                _lv_indev_hit_grid_invalidate(obj);
             }
         }
     }
@@ -1150,6 +1167,21 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark all parents of an object to tell that they have a descendant to visit when updating the layouts
+ * @param obj       pointer to an object
+ * @return          the screen of the object
+ */
+static lv_obj_t * mark_parents_child_layout_inv(lv_obj_t * obj)
+{
+    while(obj->parent) {
+        obj = obj->parent;
+        obj->child_layout_inv = 1;
+    }
+
+    return obj;
+}
+
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv)
 {
     int16_t angle = lv_obj_get_style_transform_angle(obj, 0);
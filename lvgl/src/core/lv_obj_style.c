@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_disp.h"
+#include "lv_indev_hit_grid.h"
 #include "../misc/lv_gc.h"
 
 /*********************
@@ -49,6 +50,8 @@ static _lv_obj_style_t *get_trans_style(lv_obj_t *obj, uint32_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t *v);
 static void report_style_change_core(void *style, lv_obj_t *obj);
 static void refresh_children_style(lv_obj_t *obj);
+static void obj_style_set_prop(lv_obj_t *obj, lv_style_t *style, lv_style_prop_t prop, lv_style_value_t value);
+static bool obj_style_remove_prop(lv_obj_t *obj, lv_style_t *style, lv_style_prop_t prop);
 static bool trans_del(lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop, trans_t *tr_limit);
 static void trans_anim_cb(void *_tr, int32_t v);
 static void trans_anim_start_cb(lv_anim_t *a);
@@ -56,11 +59,18 @@ static void trans_anim_ready_cb(lv_anim_t *a);
 static lv_layer_type_t calculate_layer_type(lv_obj_t *obj);
 static void fade_anim_cb(void *obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t *a);
+#if LV_OBJ_STYLE_CACHE_SIZE
+static bool style_cache_get(const lv_obj_t *obj, uint32_t key, lv_style_value_t *v);
+static void style_cache_set(const lv_obj_t *obj, uint32_t key, lv_style_value_t v);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_OBJ_STYLE_CACHE_SIZE
+static uint32_t style_cache_stamp_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -143,7 +153,10 @@ void lv_obj_remove_style(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t s
 
         if (obj->styles[i].is_local || obj->styles[i].is_trans)
         {
+            /*Only this object used the style. It's refreshed below if it had any properties.*/
+            _lv_style_enable_version_inc(false);
             lv_style_reset(obj->styles[i].style);
+            _lv_style_enable_version_inc(true);
             lv_mem_free(obj->styles[i].style);
             obj->styles[i].style = NULL;
         }
@@ -189,6 +202,9 @@ void lv_obj_refresh_style(lv_obj_t *obj, lv_style_selector_t selector, lv_style_
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The styles or their properties have changed*/
+    _lv_obj_style_cache_invalidate(obj, prop);
+
     if (!style_refr)
         return;
 
@@ -223,6 +239,9 @@ void lv_obj_refresh_style(lv_obj_t *obj, lv_style_selector_t selector, lv_style_
     if ((part == LV_PART_ANY || part == LV_PART_MAIN) && is_layer_refr)
     {
         lv_layer_type_t layer_type = calculate_layer_type(obj);
+        /*Transformed children are not placed on the hit grid of the parent*/
+        if ((layer_type == LV_LAYER_TYPE_TRANSFORM) != (_lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM))
+            _lv_indev_hit_grid_invalidate(lv_obj_get_parent(obj));
         if (obj->spec_attr)
             obj->spec_attr->layer_type = layer_type;
         else if (layer_type != LV_LAYER_TYPE_NONE)
@@ -255,6 +274,15 @@ void lv_obj_enable_style_refresh(bool en)
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop)
 {
     lv_style_value_t value_act;
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*Widgets drawing their parts in other states than the object's (e.g. table cells) skip the transitions meanwhile.
+     *Don't mix these values with the ones of the object's real state.*/
+    const lv_obj_t *cache_obj = obj->skip_trans ? NULL : obj;
+    uint32_t cache_key = part | prop;
+    if (cache_obj && style_cache_get(cache_obj, cache_key, &value_act))
+        return value_act;
+#endif
+
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
     while (obj)
@@ -274,6 +302,10 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_s
 
         /*Check the parent too.*/
         obj = lv_obj_get_parent(obj);
+#if LV_OBJ_STYLE_CACHE_SIZE
+        if (obj && obj->skip_trans)
+            cache_obj = NULL;
+#endif
     }
 
     if (found != LV_STYLE_RES_FOUND)
@@ -310,6 +342,12 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_s
             value_act = lv_style_prop_get_default(prop);
         }
     }
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+    if (cache_obj)
+        style_cache_set(cache_obj, cache_key, value_act);
+#endif
+
     return value_act;
 }
 
@@ -317,7 +355,7 @@ void lv_obj_set_local_style_prop(lv_obj_t *obj, lv_style_prop_t prop, lv_style_v
                                  lv_style_selector_t selector)
 {
     lv_style_t *style = get_local_style(obj, selector);
-    lv_style_set_prop(style, prop, value);
+    obj_style_set_prop(obj, style, prop, value);
     lv_obj_refresh_style(obj, selector, prop);
 }
 
@@ -325,7 +363,9 @@ void lv_obj_set_local_style_prop_meta(lv_obj_t *obj, lv_style_prop_t prop, uint1
                                       lv_style_selector_t selector)
 {
     lv_style_t *style = get_local_style(obj, selector);
+    _lv_style_enable_version_inc(false);
     lv_style_set_prop_meta(style, prop, meta);
+    _lv_style_enable_version_inc(true);
     lv_obj_refresh_style(obj, selector, prop);
 }
 
@@ -364,7 +404,7 @@ bool lv_obj_remove_local_style_prop(lv_obj_t *obj, lv_style_prop_t prop, lv_styl
     if (i == obj->style_cnt)
         return false;
 
-    lv_res_t res = lv_style_remove_prop(obj->styles[i].style, prop);
+    lv_res_t res = obj_style_remove_prop(obj, obj->styles[i].style, prop);
     if (res == LV_RES_OK)
     {
         lv_obj_refresh_style(obj, selector, prop);
@@ -391,9 +431,11 @@ void _lv_obj_style_create_transition(lv_obj_t *obj, lv_part_t part, lv_state_t p
     obj->state = prev_state;
     v1 = lv_obj_get_style_prop(obj, part, tr_dsc->prop);
     obj->state = new_state;
+    /*The value of the previous state was cached as if it were in the current state*/
+    _lv_obj_style_cache_invalidate(obj, tr_dsc->prop);
 
     _lv_obj_style_t *style_trans = get_trans_style(obj, part);
-    lv_style_set_prop(style_trans->style, tr_dsc->prop, v1); /*Be sure `trans_style` has a valid value*/
+    obj_style_set_prop(obj, style_trans->style, tr_dsc->prop, v1); /*Be sure `trans_style` has a valid value*/
 
     if (tr_dsc->prop == LV_STYLE_RADIUS)
     {
@@ -547,6 +589,28 @@ _lv_style_state_cmp_t _lv_obj_style_state_compare(lv_obj_t *obj, lv_state_t stat
     return res;
 }
 
+void _lv_obj_style_cache_invalidate(lv_obj_t *obj, lv_style_prop_t prop)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*Every stamp is new so the entries of a deleted object can't match a new object created at the same address*/
+    obj->style_cache_stamp = ++style_cache_stamp_cnt;
+
+    if (prop != LV_STYLE_PROP_ANY && !lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT))
+        return;
+    if (obj->spec_attr == NULL)
+        return;
+
+    uint32_t i;
+    for (i = 0; i < obj->spec_attr->child_cnt; i++)
+    {
+        _lv_obj_style_cache_invalidate(obj->spec_attr->children[i], prop);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(prop);
+#endif
+}
+
 void lv_obj_fade_in(lv_obj_t *obj, uint32_t time, uint32_t delay)
 {
     lv_anim_t a;
@@ -841,6 +905,40 @@ static void refresh_children_style(lv_obj_t *obj)
     }
 }
 
+/**
+ * Set a property in the local or transition style of an object.
+ * Only `obj` uses these styles so only its cached properties are marked as outdated.
+ * @param obj   pointer to an object
+ * @param style the local or a transition style of `obj`
+ * @param prop  the property to set
+ * @param value the new value
+ */
+static void obj_style_set_prop(lv_obj_t *obj, lv_style_t *style, lv_style_prop_t prop, lv_style_value_t value)
+{
+    _lv_style_enable_version_inc(false);
+    lv_style_set_prop(style, prop, value);
+    _lv_style_enable_version_inc(true);
+    _lv_obj_style_cache_invalidate(obj, prop);
+}
+
+/**
+ * Remove a property from the local or transition style of an object.
+ * Only `obj` uses these styles so only its cached properties are marked as outdated.
+ * @param obj   pointer to an object
+ * @param style the local or a transition style of `obj`
+ * @param prop  the property to remove
+ * @return      true: the property was found and removed
+ */
+static bool obj_style_remove_prop(lv_obj_t *obj, lv_style_t *style, lv_style_prop_t prop)
+{
+    _lv_style_enable_version_inc(false);
+    bool removed = lv_style_remove_prop(style, prop);
+    _lv_style_enable_version_inc(true);
+    if (removed)
+        _lv_obj_style_cache_invalidate(obj, prop);
+    return removed;
+}
+
 /**
  * Remove the transition from object's part's property.
  * - Remove the transition from `_lv_obj_style_trans_ll` and free it
@@ -873,7 +971,7 @@ static bool trans_del(lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop, trans
             {
                 if (obj->styles[i].is_trans && (part == LV_PART_ANY || obj->styles[i].selector == part))
                 {
-                    lv_style_remove_prop(obj->styles[i].style, tr->prop);
+                    obj_style_remove_prop(obj, obj->styles[i].style, tr->prop);
                 }
             }
 
@@ -963,9 +1061,12 @@ static void trans_anim_cb(void *_tr, int32_t v)
                 refr = false;
             }
         }
-        lv_style_set_prop(obj->styles[i].style, tr->prop, value_final);
+        /*The value is already set if it hasn't changed*/
         if (refr)
+        {
+            obj_style_set_prop(obj, obj->styles[i].style, tr->prop, value_final);
             lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
+        }
         break;
     }
 }
@@ -987,7 +1088,7 @@ static void trans_anim_start_cb(lv_anim_t *a)
     tr->prop = prop_tmp;
 
     _lv_obj_style_t *style_trans = get_trans_style(tr->obj, tr->selector);
-    lv_style_set_prop(style_trans->style, tr->prop, tr->start_value); /*Be sure `trans_style` has a valid value*/
+    obj_style_set_prop(tr->obj, style_trans->style, tr->prop, tr->start_value); /*Be sure `trans_style` has a valid value*/
 }
 
 static void trans_anim_ready_cb(lv_anim_t *a)
@@ -1021,7 +1122,7 @@ static void trans_anim_ready_cb(lv_anim_t *a)
                 lv_mem_free(tr);
 
                 _lv_obj_style_t *obj_style = &obj->styles[i];
-                lv_style_remove_prop(obj_style->style, prop);
+                obj_style_remove_prop(obj, obj_style->style, prop);
 
                 if (lv_style_is_empty(obj->styles[i].style))
                 {
@@ -1057,3 +1158,62 @@ static void fade_in_anim_ready(lv_anim_t *a)
 {
     lv_obj_remove_local_style_prop(a->var, LV_STYLE_OPA, 0);
 }
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+/**
+ * Get a number which changes when anything affecting the resolved style properties of an object changes
+ * @param obj   pointer to an object
+ * @return      the current stamp of the object
+ */
+static inline uint32_t get_cache_stamp(const lv_obj_t *obj)
+{
+    /*Both counters only increase so their sum changes if any of them does.
+     *A new object's stamp is larger than the stamps of the deleted ones.*/
+    return obj->style_cache_stamp + _lv_style_get_version();
+}
+
+/**
+ * Get the entry of an object's property in the cache. The properties of an object are placed next to each other.
+ * @param obj   pointer to an object
+ * @param key   `part | prop`
+ * @return      pointer to the entry
+ */
+static inline _lv_obj_style_cache_entry_t *get_cache_entry(const lv_obj_t *obj, uint32_t key)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 3) * 0x9E3779B1;
+    uint32_t id = (h ^ (h >> 16)) + (key & 0xFFFF) + (key >> 16) * 7;
+    return &LV_GC_ROOT(_lv_obj_style_cache).entries[id % LV_OBJ_STYLE_CACHE_SIZE];
+}
+
+/**
+ * Get a property of an object from the cache
+ * @param obj   pointer to an object
+ * @param key   `part | prop`
+ * @param v     store the cached value here
+ * @return      true: the value was cached; false: the property should be resolved
+ */
+static bool style_cache_get(const lv_obj_t *obj, uint32_t key, lv_style_value_t *v)
+{
+    const _lv_obj_style_cache_entry_t *entry = get_cache_entry(obj, key);
+    if (entry->obj != obj || entry->key != key || entry->stamp != get_cache_stamp(obj))
+        return false;
+
+    *v = entry->value;
+    return true;
+}
+
+/**
+ * Save a resolved property of an object in the cache. It replaces the other property cached at the same place.
+ * @param obj   pointer to an object
+ * @param key   `part | prop`
+ * @param v     the resolved value
+ */
+static void style_cache_set(const lv_obj_t *obj, uint32_t key, lv_style_value_t v)
+{
+    _lv_obj_style_cache_entry_t *entry = get_cache_entry(obj, key);
+    entry->obj = obj;
+    entry->key = key;
+    entry->stamp = get_cache_stamp(obj);
+    entry->value = v;
+}
+#endif /*LV_OBJ_STYLE_CACHE_SIZE*/
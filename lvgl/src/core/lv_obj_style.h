@@ -43,6 +43,19 @@ typedef struct {
     uint32_t is_trans : 1;
 } _lv_obj_style_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+typedef struct {
+    const struct _lv_obj_t * obj;
+    uint32_t key;               /*`part | prop`*/
+    uint32_t stamp;             /*The value is valid only if it was resolved with the current stamp*/
+    lv_style_value_t value;
+} _lv_obj_style_cache_entry_t;
+
+typedef struct {
+    _lv_obj_style_cache_entry_t entries[LV_OBJ_STYLE_CACHE_SIZE];
+} _lv_obj_style_cache_t;
+#endif
+
 typedef struct {
     uint16_t time;
     uint16_t delay;
@@ -180,6 +193,15 @@ void _lv_obj_style_create_transition(struct _lv_obj_t * obj, lv_part_t part, lv_
  */
 _lv_style_state_cmp_t _lv_obj_style_state_compare(struct _lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+/**
+ * Used internally to mark the cached style properties of an object as outdated.
+ * The children are marked too if they might inherit the property.
+ * E.g. the styles, the state or the parent of the object have changed.
+ * @param obj   pointer to an object
+ * @param prop  the changed property or `LV_STYLE_PROP_ANY`
+ */
+void _lv_obj_style_cache_invalidate(struct _lv_obj_t * obj, lv_style_prop_t prop);
+
 /**
  * Fade in an an object and all its children.
  * @param obj       the object to fade in
@@ -10,6 +10,7 @@
 
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "lv_indev_hit_grid.h"
 #include "../misc/lv_anim.h"
 #include "../misc/lv_gc.h"
 #include "../misc/lv_async.h"
@@ -167,6 +168,12 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     obj->parent = parent;
 
+    /*The inherited style properties come from the new parent*/
+    _lv_obj_style_cache_invalidate(obj, LV_STYLE_PROP_ANY);
+
+    _lv_indev_hit_grid_invalidate(old_parent);
+    _lv_indev_hit_grid_invalidate(parent);
+
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
     lv_event_send(old_parent, LV_EVENT_CHILD_CHANGED, obj);
@@ -212,6 +219,7 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+    _lv_indev_hit_grid_invalidate(parent);
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -232,6 +240,8 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent->spec_attr->children[index1] = obj2;
     parent2->spec_attr->children[index2] = obj1;
+    _lv_indev_hit_grid_invalidate(parent);
+    _lv_indev_hit_grid_invalidate(parent2);
 
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_event_send(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -410,6 +420,7 @@ static void obj_del_core(lv_obj_t * obj)
         obj->parent->spec_attr->child_cnt--;
         obj->parent->spec_attr->children = lv_mem_realloc(obj->parent->spec_attr->children,
                                                           obj->parent->spec_attr->child_cnt * sizeof(lv_obj_t *));
+        _lv_indev_hit_grid_invalidate(obj->parent);
     }
 
     /*Free the object itself*/
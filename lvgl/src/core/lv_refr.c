@@ -23,6 +23,21 @@
     #include "../widgets/lv_label.h"
 #endif
 
+#if LV_USE_PERF_MONITOR && LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    #include "../draw/sw/lv_draw_sw.h"
+#endif
+
+#if LV_USE_REFR_THREADS
+    #include <pthread.h>
+    #include "../draw/sw/lv_draw_sw.h"
+    #include "../widgets/lv_bar.h"
+    #include "../widgets/lv_btnmatrix.h"
+    #include "../widgets/lv_dropdown.h"
+    #include "../widgets/lv_img.h"
+    #include "../widgets/lv_table.h"
+    #include "../extra/libs/tiny_ttf/lv_tiny_ttf.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -36,6 +51,10 @@ typedef struct {
     uint32_t    frame_cnt;
     uint32_t    fps_sum_cnt;
     uint32_t    fps_sum_all;
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    uint32_t    sh_cache_hit_last;      /*Counters of the shadow cache at the previous update*/
+    uint32_t    sh_cache_miss_last;
+#endif
 #if LV_USE_LABEL
     lv_obj_t  * perf_label;
 #endif
@@ -48,6 +67,22 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_USE_REFR_THREADS
+/*An area part rendered in horizontal bands by several threads*/
+typedef struct {
+    lv_disp_t * disp;
+    lv_draw_ctx_t * draw_ctx;       /*Each band is drawn by a copy of it clipped to the band*/
+    lv_obj_t * top_act_scr;
+    lv_obj_t * top_prev_scr;
+    lv_area_t bands[LV_REFR_THREAD_CNT * 2];
+    uint32_t band_cnt;
+    uint32_t band_next;             /*Index of the next band to render*/
+    uint32_t band_done;             /*Number of rendered bands*/
+    uint32_t id;                    /*Incremented for every job to wake up the threads*/
+    bool quit;                      /*Set by `_lv_refr_deinit()` to stop the threads*/
+} refr_job_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -56,13 +91,32 @@ static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_area_content(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+static void refr_obj_core(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 
+#if LV_INV_TILE_SIZE
+    static bool inv_tiles_start(lv_disp_t * disp);
+    static void inv_tiles_add(lv_disp_t * disp, const lv_area_t * area);
+    static void inv_tiles_to_areas(lv_disp_t * disp);
+    static void inv_tiles_add_run(lv_disp_t * disp, lv_coord_t col1, lv_coord_t col2, lv_coord_t row);
+#endif
+
+#if LV_USE_REFR_THREADS
+    static bool refr_area_part_threaded(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+    static bool refr_threads_init(void);
+    static void * refr_thread_main(void * arg);
+    static void refr_thread_clean_up(void);
+    static void refr_job_run_bands(void);
+    static void refr_band(const lv_area_t * band);
+    static bool refr_obj_is_exclusive(const lv_obj_t * obj);
+#endif
+
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
 #endif
@@ -74,7 +128,18 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
-static lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_THREAD_LOCAL lv_disp_t * disp_refr; /*Display being refreshed*/
+
+#if LV_USE_REFR_THREADS
+    static uint32_t refr_thread_cnt;    /*Started threads, the caller of `lv_timer_handler` is not counted*/
+    static bool refr_threads_inited;
+    static pthread_t refr_threads[LV_REFR_THREAD_CNT];
+    static pthread_mutex_t refr_job_mutex = PTHREAD_MUTEX_INITIALIZER;
+    static pthread_cond_t refr_job_start_cond = PTHREAD_COND_INITIALIZER;
+    static pthread_cond_t refr_job_done_cond = PTHREAD_COND_INITIALIZER;
+    static refr_job_t refr_job;
+    static pthread_mutex_t refr_obj_mutex;  /*Recursive, held while an exclusive widget is drawn*/
+#endif
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -110,6 +175,31 @@ void _lv_refr_init(void)
 #endif
 }
 
+/**
+ * Stop the rendering threads and free what they have allocated
+ */
+void _lv_refr_deinit(void)
+{
+#if LV_USE_REFR_THREADS
+    if(!refr_threads_inited) return;
+
+    pthread_mutex_lock(&refr_job_mutex);
+    refr_job.quit = true;
+    pthread_cond_broadcast(&refr_job_start_cond);
+    pthread_mutex_unlock(&refr_job_mutex);
+
+    uint32_t i;
+    for(i = 0; i < refr_thread_cnt; i++) {
+        pthread_join(refr_threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&refr_obj_mutex);
+    refr_job.quit = false;
+    refr_thread_cnt = 0;
+    refr_threads_inited = false;
+#endif
+}
+
 void lv_refr_now(lv_disp_t * disp)
 {
     lv_anim_refr_now();
@@ -216,6 +306,9 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+#if LV_INV_TILE_SIZE
+        disp->inv_tiles_act = 0;
+#endif
         return;
     }
 
@@ -241,6 +334,15 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 
     if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
 
+#if LV_INV_TILE_SIZE
+    /*If there are too many areas just mark the tiles of the new ones*/
+    if(disp->inv_tiles_act) {
+        inv_tiles_add(disp, &com_area);
+        if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+        return;
+    }
+#endif
+
     /*Save only if this area is not in one of the saved areas*/
     uint16_t i;
     for(i = 0; i < disp->inv_p; i++) {
@@ -250,12 +352,18 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Save the area*/
     if(disp->inv_p < LV_INV_BUF_SIZE) {
         lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
     }
+#if LV_INV_TILE_SIZE
+    /*If no place for the area continue on a tile grid*/
+    else if(inv_tiles_start(disp)) {
+        inv_tiles_add(disp, &com_area);
+    }
+#endif
     else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+        lv_area_copy(&disp->inv_areas[0], &scr_area);
+        disp->inv_p = 1;
     }
-    disp->inv_p++;
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
@@ -292,13 +400,13 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     if(tmr) {
         disp_refr = tmr->user_data;
-#if LV_USE_PERF_MONITOR == 0 && LV_USE_MEM_MONITOR == 0
         /**
          * Ensure the timer does not run again automatically.
          * This is done before refreshing in case refreshing invalidates something else.
+         * `_lv_inv_area()` resumes it. The monitors are updated only when something else is redrawn
+         * so an idle display doesn't wake up the timer handler.
          */
         lv_timer_pause(tmr);
-#endif
     }
     else {
         disp_refr = lv_disp_get_default();
@@ -314,11 +422,18 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+#if LV_INV_TILE_SIZE
+        disp_refr->inv_tiles_act = 0;
+#endif
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
         return;
     }
 
+#if LV_INV_TILE_SIZE
+    if(disp_refr->inv_tiles_act) inv_tiles_to_areas(disp_refr);
+#endif
+
     lv_refr_join_area();
     refr_sync_areas();
     refr_invalid_areas();
@@ -354,6 +469,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
+#if LV_USE_REFR_THREADS && LV_USE_TINY_TTF
+    _lv_tiny_ttf_clean_up();
+#endif
 
 #if LV_DRAW_COMPLEX
     _lv_draw_mask_cleanup();
@@ -412,7 +530,23 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.fps_sum_all += fps;
         perf_monitor.fps_sum_cnt ++;
         uint32_t cpu = 100 - lv_timer_get_idle();
-        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU", fps, cpu);
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+        /*Hit rate of the shadow cache since the previous update if shadows were drawn on this thread*/
+        lv_draw_sw_shadow_cache_stats_t sh_stats;
+        lv_draw_sw_shadow_cache_get_stats(&sh_stats);
+        uint32_t sh_hit = sh_stats.hit_cnt - perf_monitor.sh_cache_hit_last;
+        uint32_t sh_lookup = sh_hit + sh_stats.miss_cnt - perf_monitor.sh_cache_miss_last;
+        perf_monitor.sh_cache_hit_last = sh_stats.hit_cnt;
+        perf_monitor.sh_cache_miss_last = sh_stats.miss_cnt;
+        if(sh_lookup) {
+            lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU\n%"LV_PRIu32"%% shadow hit",
+                                  fps, cpu, (sh_hit * 100) / sh_lookup);
+        }
+        else
+#endif
+        {
+            lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU", fps, cpu);
+        }
     }
 #endif
 
@@ -732,6 +866,24 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
         top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
     }
 
+#if LV_USE_REFR_THREADS
+    bool rendered = refr_area_part_threaded(draw_ctx, top_act_scr, top_prev_scr);
+#else
+    bool rendered = false;
+#endif
+    if(!rendered) refr_area_content(draw_ctx, top_act_scr, top_prev_scr);
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the display background, the screens and the layers on the clip area of a draw context
+ * @param draw_ctx      draw context to use
+ * @param top_act_scr   the most top object of the active screen which covers the area or NULL
+ * @param top_prev_scr  the most top object of the previous screen which covers the area or NULL
+ */
+static void refr_area_content(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         lv_area_t a;
@@ -792,8 +944,6 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
-
-    draw_buf_flush(disp_refr);
 }
 
 /**
@@ -961,7 +1111,22 @@ static void layer_alpha_test(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_l
     lv_draw_layer_adjust(draw_ctx, layer_ctx, has_alpha ? LV_DRAW_LAYER_FLAG_HAS_ALPHA : LV_DRAW_LAYER_FLAG_NONE);
 }
 
-void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+#if LV_USE_REFR_THREADS
+    /*Some widgets change their state, coordinates or other fields while drawing.
+     *No other thread may draw them (or their children) meanwhile.*/
+    if(refr_thread_cnt > 0 && refr_obj_is_exclusive(obj)) {
+        pthread_mutex_lock(&refr_obj_mutex);
+        refr_obj_core(draw_ctx, obj);
+        pthread_mutex_unlock(&refr_obj_mutex);
+        return;
+    }
+#endif
+    refr_obj_core(draw_ctx, obj);
+}
+
+static void refr_obj_core(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
@@ -1322,6 +1487,365 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
     drv->flush_cb(drv, &offset_area, color_p);
 }
 
+#if LV_USE_REFR_THREADS
+/**
+ * Render the current area part in horizontal bands on several threads and wait for all of them.
+ * @param draw_ctx      draw context of the display, its clip area is split into bands
+ * @param top_act_scr   the most top object of the active screen which covers the area or NULL
+ * @param top_prev_scr  the most top object of the previous screen which covers the area or NULL
+ * @return              true: rendered; false: the area should be rendered on this thread instead
+ */
+static bool refr_area_part_threaded(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
+    /*GPUs have their own state, only the software renderer can draw on several threads*/
+    if(disp_refr->driver->draw_ctx_init != lv_draw_sw_init_ctx) return false;
+
+    const lv_area_t * clip_area = draw_ctx->clip_area;
+    lv_coord_t h = lv_area_get_height(clip_area);
+    uint32_t band_cnt = h / LV_REFR_THREAD_MIN_BAND;
+    if(band_cnt < 2) return false;
+    if(!refr_threads_init()) return false;
+
+    /*Make a few more bands than threads so the threads finishing early can help the others*/
+    uint32_t band_max = (refr_thread_cnt + 1) * 2;
+    if(band_cnt > band_max) band_cnt = band_max;
+
+    pthread_mutex_lock(&refr_job_mutex);
+    refr_job.disp = disp_refr;
+    refr_job.draw_ctx = draw_ctx;
+    refr_job.top_act_scr = top_act_scr;
+    refr_job.top_prev_scr = top_prev_scr;
+
+    uint32_t i;
+    lv_coord_t y = clip_area->y1;
+    for(i = 0; i < band_cnt; i++) {
+        lv_area_t * band = &refr_job.bands[i];
+        band->x1 = clip_area->x1;
+        band->x2 = clip_area->x2;
+        band->y1 = y;
+        band->y2 = clip_area->y1 + (lv_coord_t)((h * (i + 1)) / band_cnt) - 1;
+        y = band->y2 + 1;
+    }
+    refr_job.band_cnt = band_cnt;
+    refr_job.band_next = 0;
+    refr_job.band_done = 0;
+    refr_job.id++;
+    pthread_cond_broadcast(&refr_job_start_cond);
+
+    /*Render bands here too, then wait for the bands taken by the other threads*/
+    refr_job_run_bands();
+    while(refr_job.band_done < refr_job.band_cnt) {
+        pthread_cond_wait(&refr_job_done_cond, &refr_job_mutex);
+    }
+    pthread_mutex_unlock(&refr_job_mutex);
+
+    return true;
+}
+
+/**
+ * Start the rendering threads on the first use
+ * @return true: at least one thread is running
+ */
+static bool refr_threads_init(void)
+{
+    if(refr_threads_inited) return refr_thread_cnt > 0;
+    refr_threads_inited = true;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&refr_obj_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    uint32_t i;
+    for(i = 0; i < LV_REFR_THREAD_CNT - 1; i++) {
+        if(pthread_create(&refr_threads[i], NULL, refr_thread_main, NULL) != 0) {
+            LV_LOG_WARN("couldn't start a rendering thread, using %d", (int)refr_thread_cnt);
+            break;
+        }
+        refr_thread_cnt++;
+    }
+
+    return refr_thread_cnt > 0;
+}
+
+static void * refr_thread_main(void * arg)
+{
+    LV_UNUSED(arg);
+
+    _lv_draw_sw_thread_init();
+
+    uint32_t job_id = 0;
+    pthread_mutex_lock(&refr_job_mutex);
+    while(1) {
+        while(refr_job.id == job_id && !refr_job.quit) {
+            pthread_cond_wait(&refr_job_start_cond, &refr_job_mutex);
+        }
+        if(refr_job.quit) break;
+
+        job_id = refr_job.id;
+        refr_job_run_bands();
+
+        /*Free the buffers of this thread as the display refresh does it for the caller's*/
+        pthread_mutex_unlock(&refr_job_mutex);
+        refr_thread_clean_up();
+        pthread_mutex_lock(&refr_job_mutex);
+    }
+    pthread_mutex_unlock(&refr_job_mutex);
+
+    refr_thread_clean_up();
+    _lv_font_fmt_txt_cache_free();
+    lv_draw_deinit();
+
+    return NULL;
+}
+
+/**
+ * Free the temporary buffers the calling rendering thread allocated for a job
+ */
+static void refr_thread_clean_up(void)
+{
+    lv_mem_buf_free_all();
+    _lv_font_clean_up_fmt_txt();
+#if LV_USE_TINY_TTF
+    _lv_tiny_ttf_clean_up();
+#endif
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_cleanup();
+#endif
+}
+
+/**
+ * Render the bands of the current job until none is left.
+ * Called with `refr_job_mutex` locked which is released while a band is rendered.
+ */
+static void refr_job_run_bands(void)
+{
+    while(refr_job.band_next < refr_job.band_cnt) {
+        const lv_area_t * band = &refr_job.bands[refr_job.band_next];
+        refr_job.band_next++;
+
+        pthread_mutex_unlock(&refr_job_mutex);
+        refr_band(band);
+        pthread_mutex_lock(&refr_job_mutex);
+
+        refr_job.band_done++;
+        if(refr_job.band_done == refr_job.band_cnt) pthread_cond_signal(&refr_job_done_cond);
+    }
+}
+
+/**
+ * Render one band of the current job
+ * @param band  the area to render, a horizontal slice of the job's clip area
+ */
+static void refr_band(const lv_area_t * band)
+{
+    /*Layers redirect the draw context and change `screen_transp` of the driver while drawing,
+     *so every band uses its own copy of them*/
+    lv_disp_t * disp_ori = disp_refr;
+    lv_disp_drv_t driver = *refr_job.disp->driver;
+    lv_disp_t disp = *refr_job.disp;
+    disp.driver = &driver;
+    disp_refr = &disp;
+
+    lv_draw_ctx_t * draw_ctx = lv_mem_buf_get(driver.draw_ctx_size);
+    lv_memcpy(draw_ctx, refr_job.draw_ctx, driver.draw_ctx_size);
+    draw_ctx->clip_area = band;
+
+    refr_area_content(draw_ctx, refr_job.top_act_scr, refr_job.top_prev_scr);
+    lv_draw_wait_for_finish(draw_ctx);
+
+    lv_mem_buf_release(draw_ctx);
+    disp_refr = disp_ori;
+}
+
+/**
+ * Tell if a widget writes its own fields (e.g. state, coordinates) while drawing
+ * @param obj   pointer to an object
+ * @return      true: only one thread at a time may draw it
+ */
+static bool refr_obj_is_exclusive(const lv_obj_t * obj)
+{
+#if LV_USE_BAR
+    if(lv_obj_has_class(obj, &lv_bar_class)) return true;
+#endif
+#if LV_USE_BTNMATRIX
+    if(lv_obj_has_class(obj, &lv_btnmatrix_class)) return true;
+#endif
+#if LV_USE_DROPDOWN
+    if(lv_obj_has_class(obj, &lv_dropdownlist_class)) return true;
+#endif
+#if LV_USE_IMG
+    if(lv_obj_has_class(obj, &lv_img_class)) return true;
+#endif
+#if LV_USE_TABLE
+    if(lv_obj_has_class(obj, &lv_table_class)) return true;
+#endif
+    LV_UNUSED(obj);
+    return false;
+}
+#endif /*LV_USE_REFR_THREADS*/
+
+#if LV_INV_TILE_SIZE
+/**
+ * Move the invalidated areas to the tile grid of the display.
+ * The grid is (re)allocated if it doesn't exist or the resolution has changed.
+ * @param disp  pointer to a display
+ * @return      true: the tiles are used from now; false: out of memory
+ */
+static bool inv_tiles_start(lv_disp_t * disp)
+{
+    uint32_t cols = (lv_disp_get_hor_res(disp) + LV_INV_TILE_SIZE - 1) / LV_INV_TILE_SIZE;
+    uint32_t rows = (lv_disp_get_ver_res(disp) + LV_INV_TILE_SIZE - 1) / LV_INV_TILE_SIZE;
+    uint32_t size = ((cols + 31) / 32) * rows * sizeof(uint32_t);
+
+    if(disp->inv_tiles == NULL || disp->inv_tile_cols != cols || disp->inv_tile_rows != rows) {
+        lv_mem_free(disp->inv_tiles);
+        disp->inv_tiles = lv_mem_alloc(size);
+        LV_ASSERT_MALLOC(disp->inv_tiles);
+        if(disp->inv_tiles == NULL) {
+            disp->inv_tile_cols = 0;
+            disp->inv_tile_rows = 0;
+            return false;
+        }
+        disp->inv_tile_cols = cols;
+        disp->inv_tile_rows = rows;
+    }
+
+    lv_memset_00(disp->inv_tiles, size);
+    disp->inv_tiles_act = 1;
+
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        inv_tiles_add(disp, &disp->inv_areas[i]);
+    }
+    disp->inv_p = 0;
+
+    return true;
+}
+
+/**
+ * Mark the tiles touched by an area
+ * @param disp  pointer to a display
+ * @param area  the area in screen coordinates
+ */
+static void inv_tiles_add(lv_disp_t * disp, const lv_area_t * area)
+{
+    int32_t col1 = LV_MAX(area->x1, 0) / LV_INV_TILE_SIZE;
+    int32_t row1 = LV_MAX(area->y1, 0) / LV_INV_TILE_SIZE;
+    int32_t col2 = LV_MIN(area->x2 / LV_INV_TILE_SIZE, disp->inv_tile_cols - 1);
+    int32_t row2 = LV_MIN(area->y2 / LV_INV_TILE_SIZE, disp->inv_tile_rows - 1);
+    if(col1 > col2 || row1 > row2) return;
+
+    uint32_t words = (disp->inv_tile_cols + 31) / 32;
+    uint32_t word1 = col1 / 32;
+    uint32_t word2 = col2 / 32;
+    int32_t row;
+    for(row = row1; row <= row2; row++) {
+        uint32_t * row_tiles = &disp->inv_tiles[row * words];
+        uint32_t w;
+        for(w = word1; w <= word2; w++) {
+            uint32_t bit1 = w == word1 ? col1 % 32 : 0;
+            uint32_t bit2 = w == word2 ? col2 % 32 : 31;
+            row_tiles[w] |= (0xFFFFFFFF << bit1) & (0xFFFFFFFF >> (31 - bit2));
+        }
+    }
+}
+
+/**
+ * Replace the tile grid with the rectangles covering the marked tiles.
+ * The runs of marked tiles in a row continue the rectangle of the same run in the previous row.
+ * @param disp  pointer to a display
+ */
+static void inv_tiles_to_areas(lv_disp_t * disp)
+{
+    uint32_t words = (disp->inv_tile_cols + 31) / 32;
+    disp->inv_p = 0;
+
+    lv_coord_t row;
+    for(row = 0; row < disp->inv_tile_rows; row++) {
+        const uint32_t * row_tiles = &disp->inv_tiles[row * words];
+        lv_coord_t run_start = -1;
+        lv_coord_t col = 0;
+        while(col < disp->inv_tile_cols) {
+            /*Skip the empty words at once*/
+            if(run_start < 0 && col % 32 == 0 && row_tiles[col / 32] == 0) {
+                col += 32;
+                continue;
+            }
+
+            bool marked = (row_tiles[col / 32] >> (col % 32)) & 0x1;
+            if(marked && run_start < 0) run_start = col;
+            else if(!marked && run_start >= 0) {
+                inv_tiles_add_run(disp, run_start, col - 1, row);
+                run_start = -1;
+            }
+            col++;
+        }
+        if(run_start >= 0) inv_tiles_add_run(disp, run_start, disp->inv_tile_cols - 1, row);
+    }
+
+    disp->inv_tiles_act = 0;
+
+    /*Convert the tile coordinates to pixels*/
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    lv_coord_t ver_res = lv_disp_get_ver_res(disp);
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t * a = &disp->inv_areas[i];
+        a->x1 = a->x1 * LV_INV_TILE_SIZE;
+        a->y1 = a->y1 * LV_INV_TILE_SIZE;
+        a->x2 = LV_MIN((a->x2 + 1) * LV_INV_TILE_SIZE, hor_res) - 1;
+        a->y2 = LV_MIN((a->y2 + 1) * LV_INV_TILE_SIZE, ver_res) - 1;
+        if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, a);
+    }
+}
+
+/**
+ * Add a run of marked tiles to the invalidated areas (in tile coordinates)
+ * @param disp  pointer to a display
+ * @param col1  first column of the run
+ * @param col2  last column of the run
+ * @param row   row of the run
+ */
+static void inv_tiles_add_run(lv_disp_t * disp, lv_coord_t col1, lv_coord_t col2, lv_coord_t row)
+{
+    /*Extend the rectangle of the same run in the previous row*/
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t * a = &disp->inv_areas[i];
+        if(a->y2 == row - 1 && a->x1 == col1 && a->x2 == col2) {
+            a->y2 = row;
+            return;
+        }
+    }
+
+    lv_area_t run;
+    lv_area_set(&run, col1, row, col2, row);
+
+    if(disp->inv_p < LV_INV_BUF_SIZE) {
+        disp->inv_areas[disp->inv_p] = run;
+        disp->inv_p++;
+        return;
+    }
+
+    /*No more space: join the run to the rectangle which grows the least*/
+    uint32_t best_i = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t joined;
+        _lv_area_join(&joined, &disp->inv_areas[i], &run);
+        uint32_t growth = lv_area_get_size(&joined) - lv_area_get_size(&disp->inv_areas[i]);
+        if(growth < best_growth) {
+            best_growth = growth;
+            best_i = i;
+        }
+    }
+
+    _lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &run);
+}
+#endif /*LV_INV_TILE_SIZE*/
+
 #if LV_USE_PERF_MONITOR
 static void perf_monitor_init(perf_monitor_t * _perf_monitor)
 {
@@ -1331,6 +1855,10 @@ static void perf_monitor_init(perf_monitor_t * _perf_monitor)
     _perf_monitor->fps_sum_cnt = 0;
     _perf_monitor->frame_cnt = 0;
     _perf_monitor->perf_last_time = 0;
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    _perf_monitor->sh_cache_hit_last = 0;
+    _perf_monitor->sh_cache_miss_last = 0;
+#endif
     _perf_monitor->perf_label = NULL;
 }
 #endif
@@ -47,6 +47,11 @@ extern "C" {
  */
 void _lv_refr_init(void);
 
+/**
+ * Deinitialize the screen refresh subsystem: stop the rendering threads if they were started
+ */
+void _lv_refr_deinit(void);
+
 /**
  * Redraw the invalidated areas now.
  * Normally the redrawing is periodically executed in `lv_timer_handler` but a long blocking process
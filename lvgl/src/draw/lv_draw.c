@@ -39,7 +39,15 @@
 
 void lv_draw_init(void)
 {
-    /*Nothing to init now*/
+    lv_draw_sw_init();
+}
+
+void lv_draw_deinit(void)
+{
+    lv_draw_sw_deinit();
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_corner_cache_free();
+#endif
 }
 
 void lv_draw_wait_for_finish(lv_draw_ctx_t * draw_ctx)
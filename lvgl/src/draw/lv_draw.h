@@ -194,6 +194,11 @@ typedef struct _lv_draw_ctx_t  {
 
 void lv_draw_init(void);
 
+/**
+ * Free the caches of the renderers used by the calling thread
+ */
+void lv_draw_deinit(void);
+
 void lv_draw_wait_for_finish(lv_draw_ctx_t * draw_ctx);
 
 /**********************
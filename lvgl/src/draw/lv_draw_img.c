@@ -77,7 +77,10 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
     }
 
     if(res != LV_RES_OK) {
+        /*The cache entry of the image is used until the image is drawn*/
+        _lv_img_cache_lock();
         res = decode_and_draw(draw_ctx, dsc, coords, src);
+        _lv_img_cache_unlock();
     }
 
     if(res != LV_RES_OK) {
@@ -13,12 +13,14 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LAYOUT_LINES_STACK_NUM  32   /*Lines collected on the stack while building a layout*/
 
 /**********************
  *      TYPEDEFS
@@ -35,6 +37,10 @@ typedef uint8_t cmd_state_t;
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static void get_lines_size(const lv_draw_label_line_t * lines, uint32_t line_cnt, const char * txt,
+                           const lv_font_t * font, lv_coord_t line_space, lv_point_t * size_res);
+static bool layout_is_valid(const lv_draw_label_layout_t * layout, const lv_draw_label_dsc_t * dsc,
+                            const lv_area_t * coords, const char * txt, lv_base_dir_t base_dir);
 
 /**********************
  *  STATIC VARIABLES
@@ -106,7 +112,15 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     lv_bidi_calculate_align(&align, &base_dir, txt);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
+    /*Use the lines measured earlier if they were made for this text*/
+    const lv_draw_label_layout_t * layout = dsc->layout;
+    if(layout && !layout_is_valid(layout, dsc, coords, txt, base_dir)) layout = NULL;
+
+    if(layout) {
+        /*The lines are not wrapped again*/
+        w = layout->max_w;
+    }
+    else if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
@@ -134,10 +148,25 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end;
+    uint32_t line_i         = 0;    /*Index of the line in the layout*/
     int32_t last_line_start = -1;
 
+    if(layout) {
+        /*Jump to the first visible line*/
+        int32_t skip_h = draw_ctx->clip_area->y1 - (pos.y + line_height_font);
+        if(skip_h > 0) {
+            if(line_height <= 0) return;
+            line_i = (skip_h + line_height - 1) / line_height;
+        }
+        if(line_i >= layout->line_cnt) return;
+
+        line_start = layout->lines[line_i].start;
+        line_end = layout->lines[line_i + 1].start;
+        pos.y += line_i * line_height;
+    }
     /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
+    else if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             hint->line_start = -1;
@@ -151,10 +180,11 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    if(!layout) line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL,
+                                                                  dsc->flag);
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
+    while(!layout && pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
@@ -170,17 +200,14 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         if(txt[line_start] == '\0') return;
     }
 
-    /*Align to middle*/
-    if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+    if(align == LV_TEXT_ALIGN_CENTER || align == LV_TEXT_ALIGN_RIGHT) {
+        if(layout) line_width = layout->lines[line_i].width;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
-        pos.x += (lv_area_get_width(coords) - line_width) / 2;
-
-    }
-    /*Align to the right*/
-    else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
-        pos.x += lv_area_get_width(coords) - line_width;
+        /*Align to middle*/
+        if(align == LV_TEXT_ALIGN_CENTER) pos.x += (lv_area_get_width(coords) - line_width) / 2;
+        /*Align to the right*/
+        else pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
     uint32_t sel_end = dsc->sel_end;
@@ -219,8 +246,16 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         cmd_state = CMD_STATE_WAIT;
         i         = 0;
 #if LV_USE_BIDI
-        char * bidi_txt = lv_mem_buf_get(line_end - line_start + 1);
-        _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, base_dir, NULL, 0);
+        char * bidi_buf = NULL;
+        const char * bidi_txt;
+        if(layout) {
+            bidi_txt = layout->bidi_txt ? &layout->bidi_txt[line_start + line_i] : &txt[line_start];
+        }
+        else {
+            bidi_buf = lv_mem_buf_get(line_end - line_start + 1);
+            _lv_bidi_process_paragraph(txt + line_start, bidi_buf, line_end - line_start, base_dir, NULL, 0);
+            bidi_txt = bidi_buf;
+        }
 #else
         const char * bidi_txt = txt + line_start;
 #endif
@@ -240,6 +275,10 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             uint32_t letter;
             uint32_t letter_next;
             _lv_txt_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &i);
+#if LV_USE_BIDI
+            /*The processed lines end with '\0', so there is no next letter at the end of the line*/
+            if(i >= line_end - line_start) letter_next = 0;
+#endif
             /*Handle the re-color command*/
             if((dsc->flag & LV_TEXT_FLAG_RECOLOR) != 0) {
                 if(letter == (uint32_t)LV_TXT_COLOR_CMD[0]) {
@@ -329,27 +368,29 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         }
 
 #if LV_USE_BIDI
-        lv_mem_buf_release(bidi_txt);
-        bidi_txt = NULL;
+        if(bidi_buf) lv_mem_buf_release(bidi_buf);
+        bidi_buf = NULL;
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        if(layout) {
+            line_i++;
+            if(line_i < layout->line_cnt) line_end = layout->lines[line_i + 1].start;
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        }
 
         pos.x = coords->x1;
-        /*Align to middle*/
-        if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
-
-            pos.x += (lv_area_get_width(coords) - line_width) / 2;
-
-        }
-        /*Align to the right*/
-        else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
-            pos.x += lv_area_get_width(coords) - line_width;
+        if(align == LV_TEXT_ALIGN_CENTER || align == LV_TEXT_ALIGN_RIGHT) {
+            if(layout) line_width = layout->lines[line_i].width;
+            else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                   dsc->flag);
+
+            /*Align to middle*/
+            if(align == LV_TEXT_ALIGN_CENTER) pos.x += (lv_area_get_width(coords) - line_width) / 2;
+            /*Align to the right*/
+            else pos.x += lv_area_get_width(coords) - line_width;
         }
 
         /*Go the next line position*/
@@ -367,10 +408,157 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
     draw_ctx->draw_letter(draw_ctx, dsc, pos_p, letter);
 }
 
+void lv_draw_label_layout_init(lv_draw_label_layout_t * layout)
+{
+    lv_memset_00(layout, sizeof(lv_draw_label_layout_t));
+}
+
+bool lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * txt, const lv_font_t * font,
+                                 lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag,
+                                 lv_base_dir_t base_dir, lv_point_t * size_res)
+{
+    lv_draw_label_layout_free(layout);
+    if(txt == NULL || font == NULL) return false;
+
+    if(flag & LV_TEXT_FLAG_EXPAND) max_w = LV_COORD_MAX;
+
+    /*Find and measure the lines as `lv_draw_label` does.
+     *Collect them on the stack first to allocate the final array only once.*/
+    lv_draw_label_line_t lines_stack[LAYOUT_LINES_STACK_NUM];
+    lv_draw_label_line_t * lines_tmp = lines_stack;
+    uint32_t cap = LAYOUT_LINES_STACK_NUM;
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    while(1) {
+        if(line_cnt + 1 > cap) {
+            lv_draw_label_line_t * lines_new = lv_mem_alloc(cap * 2 * sizeof(lv_draw_label_line_t));
+            if(lines_new == NULL) {
+                if(lines_tmp != lines_stack) lv_mem_free(lines_tmp);
+                return false;
+            }
+            lv_memcpy(lines_new, lines_tmp, cap * sizeof(lv_draw_label_line_t));
+            if(lines_tmp != lines_stack) lv_mem_free(lines_tmp);
+            lines_tmp = lines_new;
+            cap = cap * 2;
+        }
+
+        lines_tmp[line_cnt].start = line_start;
+        lines_tmp[line_cnt].width = 0;
+        if(txt[line_start] == '\0') break;
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+        lines_tmp[line_cnt].width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        line_start = line_end;
+        line_cnt++;
+    }
+
+    if(size_res) get_lines_size(lines_tmp, line_cnt, txt, font, line_space, size_res);
+
+    /*Short texts are measured quickly when they are drawn*/
+    if(line_cnt < LV_DRAW_LABEL_LAYOUT_MIN_LINES) {
+        if(lines_tmp != lines_stack) lv_mem_free(lines_tmp);
+        return true;
+    }
+
+    lv_draw_label_line_t * lines = lv_mem_alloc((line_cnt + 1) * sizeof(lv_draw_label_line_t));
+    if(lines) lv_memcpy(lines, lines_tmp, (line_cnt + 1) * sizeof(lv_draw_label_line_t));
+    if(lines_tmp != lines_stack) lv_mem_free(lines_tmp);
+    if(lines == NULL) return true;
+
+#if LV_USE_BIDI
+    if(base_dir == LV_BASE_DIR_AUTO) base_dir = _lv_bidi_detect_base_dir(txt);
+
+    /*Keep the lines in visual order only if they are different*/
+    char * bidi_txt = lv_mem_alloc(line_start + line_cnt + 1);
+    if(bidi_txt == NULL) {
+        lv_mem_free(lines);
+        return true;
+    }
+    bool bidi_same = true;
+    uint32_t i;
+    for(i = 0; i < line_cnt; i++) {
+        uint32_t len = lines[i + 1].start - lines[i].start;
+        char * bidi_line = &bidi_txt[lines[i].start + i];
+        _lv_bidi_process_paragraph(&txt[lines[i].start], bidi_line, len, base_dir, NULL, 0);
+        if(bidi_same && memcmp(bidi_line, &txt[lines[i].start], len) != 0) bidi_same = false;
+    }
+    if(bidi_same) {
+        lv_mem_free(bidi_txt);
+        bidi_txt = NULL;
+    }
+    layout->bidi_txt = bidi_txt;
+#endif
+
+    layout->txt = txt;
+    layout->font = font;
+    layout->lines = lines;
+    layout->line_cnt = line_cnt;
+    layout->max_w = max_w;
+    layout->letter_space = letter_space;
+    layout->flag = flag;
+    layout->base_dir = base_dir;
+
+    return true;
+}
+
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout)
+{
+    if(layout->lines) lv_mem_free(layout->lines);
+#if LV_USE_BIDI
+    if(layout->bidi_txt) lv_mem_free(layout->bidi_txt);
+#endif
+    lv_memset_00(layout, sizeof(lv_draw_label_layout_t));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the size of a text from its lines in the same way as `lv_txt_get_size()`
+ */
+static void get_lines_size(const lv_draw_label_line_t * lines, uint32_t line_cnt, const char * txt,
+                           const lv_font_t * font, lv_coord_t line_space, lv_point_t * size_res)
+{
+    size_res->x = 0;
+    size_res->y = 0;
+
+    uint16_t letter_height = lv_font_get_line_height(font);
+    uint32_t i;
+    for(i = 0; i < line_cnt; i++) {
+        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
+            LV_LOG_WARN("integer overflow while calculating text height");
+            return;
+        }
+        size_res->y += letter_height + line_space;
+        size_res->x = LV_MAX(lines[i].width, size_res->x);
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    uint32_t len = lines[line_cnt].start;
+    if(len != 0 && (txt[len - 1] == '\n' || txt[len - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0) size_res->y = letter_height;
+    else size_res->y -= line_space;
+}
+
+static bool layout_is_valid(const lv_draw_label_layout_t * layout, const lv_draw_label_dsc_t * dsc,
+                            const lv_area_t * coords, const char * txt, lv_base_dir_t base_dir)
+{
+    if(layout->txt != txt || layout->font != dsc->font) return false;
+    if(layout->letter_space != dsc->letter_space || layout->flag != dsc->flag) return false;
+#if LV_USE_BIDI
+    if(layout->base_dir != base_dir) return false;
+#else
+    LV_UNUSED(base_dir);
+#endif
+    if(dsc->flag & LV_TEXT_FLAG_EXPAND) return layout->max_w == LV_COORD_MAX;
+    else return layout->max_w == lv_area_get_width(coords);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
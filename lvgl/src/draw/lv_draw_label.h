@@ -22,13 +22,38 @@ extern "C" {
  *      DEFINES
  *********************/
 #define LV_DRAW_LABEL_NO_TXT_SEL (0xFFFF)
+#define LV_DRAW_LABEL_LAYOUT_MIN_LINES 16   /*Keep the layout of texts with at least this many lines*/
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** Position and width of a line of a text*/
 typedef struct {
+    uint32_t start;             /**< Byte index of the first character of the line*/
+    lv_coord_t width;           /**< Width of the line in pixels*/
+} lv_draw_label_line_t;
+
+/** The lines of a text wrapped to a given width.
+ * With it `lv_draw_label` can jump to the first visible line and needn't measure the lines again.
+ * It's used only if the text, font, width, letter space, flags and base direction are the same as when it was made.*/
+typedef struct _lv_draw_label_layout_t {
+    const char * txt;
     const lv_font_t * font;
+    lv_draw_label_line_t * lines;   /**< `line_cnt + 1` elements. The `start` of the last one is the text's length*/
+#if LV_USE_BIDI
+    char * bidi_txt;                /**< The lines in visual order, each closed by `\0`. NULL if the same as `txt`*/
+#endif
+    uint32_t line_cnt;
+    lv_coord_t max_w;               /**< Width where the lines were wrapped. `LV_COORD_MAX` with `LV_TEXT_FLAG_EXPAND`*/
+    lv_coord_t letter_space;
+    lv_text_flag_t flag;
+    lv_base_dir_t base_dir;
+} lv_draw_label_layout_t;
+
+typedef struct {
+    const lv_font_t * font;
+    const lv_draw_label_layout_t * layout;  /**< Lines of the text made by `lv_draw_label_layout_update()` or NULL*/
     uint32_t sel_start;
     uint32_t sel_end;
     lv_color_t color;
@@ -85,6 +110,36 @@ void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_label(struct _lv_draw_ctx_t * draw_ctx,
 void lv_draw_letter(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                     uint32_t letter);
 
+/**
+ * Initialize a layout as empty
+ * @param layout    pointer to a layout
+ */
+void lv_draw_label_layout_init(lv_draw_label_layout_t * layout);
+
+/**
+ * Break a text into lines and measure them to be used as `layout` of `lv_draw_label_dsc_t`.
+ * The lines are kept only if there are at least `LV_DRAW_LABEL_LAYOUT_MIN_LINES` as short texts are measured quickly.
+ * @param layout        pointer to an initialized layout. Its earlier lines are freed.
+ * @param txt           `\0` terminated text. It can't be changed or freed while the layout is used.
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param line_space    line space, used only for `size_res`
+ * @param max_w         break the lines to fit this width
+ * @param flag          settings for the text from `lv_text_flag_t`
+ * @param base_dir      base direction of the text. `LV_BASE_DIR_AUTO` is detected from the text.
+ * @param size_res      store the size of the text here in the same way as `lv_txt_get_size()`. Can be NULL.
+ * @return              true: `size_res` is set; false: not enough memory to measure the text
+ */
+bool lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * txt, const lv_font_t * font,
+                                 lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag,
+                                 lv_base_dir_t base_dir, lv_point_t * size_res);
+
+/**
+ * Free the lines of a layout and make it empty
+ * @param layout    pointer to a layout
+ */
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
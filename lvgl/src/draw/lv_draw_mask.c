@@ -18,10 +18,22 @@
  *********************/
 #define CIRCLE_CACHE_LIFE_MAX   1000
 #define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
+#define CORNER_CACHE_HASH(r, inv)     (((uint32_t)(r) * 2 + (inv)) & (_LV_DRAW_MASK_CORNER_CACHE_BUCKETS - 1))
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_CORNER_CACHE_SIZE
+/*The pre-rendered corners of a radius. The `(2 * radius)^2` opacity values are stored after it.*/
+typedef struct _lv_draw_mask_corner_map_t {
+    struct _lv_draw_mask_corner_map_t * hash_next;
+    struct _lv_draw_mask_corner_map_t * lru_prev;
+    struct _lv_draw_mask_corner_map_t * lru_next;
+    uint32_t size;          /*Size of the entry with the map after it*/
+    lv_coord_t radius;
+    uint8_t inv;
+} corner_map_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -60,6 +72,11 @@ static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_
                                 lv_coord_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
+#if LV_CORNER_CACHE_SIZE
+    static void corner_map_render(lv_opa_t * map, lv_coord_t radius, bool inv);
+    static void corner_cache_remove(corner_map_t * entry);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -240,6 +257,79 @@ void _lv_draw_mask_cleanup(void)
     }
 }
 
+const lv_opa_t * _lv_draw_mask_get_corner_map(lv_coord_t radius, bool inv)
+{
+#if LV_CORNER_CACHE_SIZE
+    if(radius <= 0) return NULL;
+
+    uint32_t side = radius * 2;
+    uint32_t size = sizeof(corner_map_t) + side * side;
+    if(size > LV_CORNER_CACHE_SIZE) return NULL;
+
+    _lv_draw_mask_corner_cache_t * cache = &LV_GC_ROOT(_lv_corner_cache);
+    uint32_t h = CORNER_CACHE_HASH(radius, inv);
+    corner_map_t * entry = cache->buckets[h];
+    while(entry) {
+        if(entry->radius == radius && entry->inv == inv) break;
+        entry = entry->hash_next;
+    }
+
+    if(entry) {
+        /*Move to the front of the LRU list*/
+        if(entry != cache->lru_first) {
+            entry->lru_prev->lru_next = entry->lru_next;
+            if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+            else cache->lru_last = entry->lru_prev;
+
+            entry->lru_prev = NULL;
+            entry->lru_next = cache->lru_first;
+            cache->lru_first->lru_prev = entry;
+            cache->lru_first = entry;
+        }
+        return (const lv_opa_t *)(entry + 1);
+    }
+
+    /*Drop the least recently used radiuses to make room for the new one*/
+    while(cache->size + size > LV_CORNER_CACHE_SIZE) {
+        corner_cache_remove(cache->lru_last);
+    }
+
+    entry = lv_mem_alloc(size);
+    if(entry == NULL) return NULL;
+
+    entry->radius = radius;
+    entry->inv = inv ? 1 : 0;
+    entry->size = size;
+    entry->hash_next = cache->buckets[h];
+    cache->buckets[h] = entry;
+
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_first;
+    if(cache->lru_first) cache->lru_first->lru_prev = entry;
+    else cache->lru_last = entry;
+    cache->lru_first = entry;
+    cache->size += size;
+
+    corner_map_render((lv_opa_t *)(entry + 1), radius, inv);
+
+    return (const lv_opa_t *)(entry + 1);
+#else
+    LV_UNUSED(radius);
+    LV_UNUSED(inv);
+    return NULL;
+#endif
+}
+
+void _lv_draw_mask_corner_cache_free(void)
+{
+#if LV_CORNER_CACHE_SIZE
+    _lv_draw_mask_corner_cache_t * cache = &LV_GC_ROOT(_lv_corner_cache);
+    while(cache->lru_last) {
+        corner_cache_remove(cache->lru_last);
+    }
+#endif
+}
+
 /**
  * Count the currently added masks
  * @return number of active masks
@@ -1515,6 +1605,53 @@ static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_
     return &c->cir_opa[c->opa_start_on_y[y]];
 }
 
+#if LV_CORNER_CACHE_SIZE
+
+/**
+ * Render the corners of a radius with the radius mask itself to get exactly the same values
+ * @param map       buffer for `(2 * radius)^2` opacity values
+ * @param radius    radius of the corners
+ * @param inv       true: cover the outside of the corners
+ */
+static void corner_map_render(lv_opa_t * map, lv_coord_t radius, bool inv)
+{
+    lv_coord_t side = radius * 2;
+    lv_area_t circle_area;
+    lv_area_set(&circle_area, 0, 0, side - 1, side - 1);
+
+    lv_draw_mask_radius_param_t param;
+    lv_draw_mask_radius_init(&param, &circle_area, radius, inv);
+
+    lv_coord_t y;
+    for(y = 0; y < side; y++) {
+        lv_opa_t * row = &map[y * side];
+        lv_memset_ff(row, side);
+        lv_draw_mask_res_t res = lv_draw_mask_radius(row, 0, y, side, &param);
+        if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(row, side);
+    }
+
+    lv_draw_mask_free_param(&param);
+}
+
+static void corner_cache_remove(corner_map_t * entry)
+{
+    _lv_draw_mask_corner_cache_t * cache = &LV_GC_ROOT(_lv_corner_cache);
+
+    corner_map_t ** link = &cache->buckets[CORNER_CACHE_HASH(entry->radius, entry->inv)];
+    while(*link != entry) link = &(*link)->hash_next;
+    *link = entry->hash_next;
+
+    if(entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else cache->lru_first = entry->lru_next;
+    if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else cache->lru_last = entry->lru_prev;
+
+    cache->size -= entry->size;
+    lv_mem_free(entry);
+}
+
+#endif /*LV_CORNER_CACHE_SIZE*/
+
 static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
     if(mask_new >= LV_OPA_MAX) return mask_act;
@@ -28,6 +28,9 @@ extern "C" {
 # define _LV_MASK_MAX_NUM     1
 #endif
 
+/*Number of hash buckets of the pre-rendered corner cache. Must be a power of 2.*/
+#define _LV_DRAW_MASK_CORNER_CACHE_BUCKETS  16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -162,6 +165,16 @@ typedef struct  {
 
 typedef _lv_draw_mask_radius_circle_dsc_t _lv_draw_mask_radius_circle_dsc_arr_t[LV_CIRCLE_CACHE_SIZE];
 
+struct _lv_draw_mask_corner_map_t;
+
+/*LRU cache of the pre-rendered corners of the radiuses. Each rendering thread has its own.*/
+typedef struct {
+    struct _lv_draw_mask_corner_map_t * buckets[_LV_DRAW_MASK_CORNER_CACHE_BUCKETS];
+    struct _lv_draw_mask_corner_map_t * lru_first;  /*Most recently used*/
+    struct _lv_draw_mask_corner_map_t * lru_last;   /*Least recently used, dropped first*/
+    uint32_t size;                                  /*Bytes allocated for the entries*/
+} _lv_draw_mask_corner_cache_t;
+
 typedef struct {
     /*The first element must be the common descriptor*/
     _lv_draw_mask_common_dsc_t dsc;
@@ -288,6 +301,23 @@ void lv_draw_mask_free_param(void * p);
  */
 void _lv_draw_mask_cleanup(void);
 
+/**
+ * Get the opacity map of the rounded corners of a radius from the cache of the calling thread.
+ * It's the radius mask of a `2 * radius` wide and high square, i.e. a circle whose quarters are the 4 corners.
+ * The values are the same as `lv_draw_mask_radius_init()`'s mask would set on a fully covered line.
+ * @param radius    radius of the corners
+ * @param inv       false: the inside of the corners is covered; true: the outside
+ * @return          `(2 * radius)^2` opacity values row by row or NULL if it doesn't fit into `LV_CORNER_CACHE_SIZE`.
+ *                  Valid until the next call in the same thread.
+ */
+const lv_opa_t * _lv_draw_mask_get_corner_map(lv_coord_t radius, bool inv);
+
+/**
+ * Free the corner maps cached by the calling thread.
+ * Called by `lv_deinit()` and by the rendering threads when they stop.
+ */
+void _lv_draw_mask_corner_cache_free(void);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -13,6 +13,10 @@
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
 
+#if LV_USE_REFR_THREADS
+    #include <pthread.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -36,6 +40,9 @@
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
 #endif
+#if LV_USE_REFR_THREADS
+    static void cache_mutex_init(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -43,6 +50,10 @@
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
 #endif
+#if LV_USE_REFR_THREADS
+    static pthread_once_t cache_mutex_once = PTHREAD_ONCE_INIT;
+    static pthread_mutex_t cache_mutex;
+#endif
 
 /**********************
  *      MACROS
@@ -152,6 +163,7 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_UNUSED(new_entry_cnt);
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
+    _lv_img_cache_lock();
     if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
@@ -163,12 +175,14 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
+        _lv_img_cache_unlock();
         return;
     }
     entry_cnt = new_entry_cnt;
 
     /*Clean the cache*/
     lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    _lv_img_cache_unlock();
 #endif
 }
 
@@ -181,6 +195,7 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
+    _lv_img_cache_lock();
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
     uint16_t i;
@@ -193,6 +208,22 @@ void lv_img_cache_invalidate_src(const void * src)
             lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
         }
     }
+    _lv_img_cache_unlock();
+#endif
+}
+
+void _lv_img_cache_lock(void)
+{
+#if LV_USE_REFR_THREADS
+    pthread_once(&cache_mutex_once, cache_mutex_init);
+    pthread_mutex_lock(&cache_mutex);
+#endif
+}
+
+void _lv_img_cache_unlock(void)
+{
+#if LV_USE_REFR_THREADS
+    pthread_mutex_unlock(&cache_mutex);
 #endif
 }
 
@@ -213,3 +244,15 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
     return strcmp(src1, src2) == 0;
 }
 #endif
+
+#if LV_USE_REFR_THREADS
+static void cache_mutex_init(void)
+{
+    /*Recursive as widgets may hold it around `lv_draw_img` to keep their image sources alive*/
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cache_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+#endif
@@ -67,6 +67,17 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Keep the other rendering threads away from the cache while an entry returned by `_lv_img_cache_open` is used.
+ * It does nothing if only one thread renders (`LV_USE_REFR_THREADS == 0`). Can be called recursively.
+ */
+void _lv_img_cache_lock(void);
+
+/**
+ * Release the cache locked by `_lv_img_cache_lock`
+ */
+void _lv_img_cache_unlock(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -8,6 +8,7 @@
  *********************/
 #include "../lv_draw.h"
 #include "lv_draw_sw.h"
+#include "lv_draw_sw_blend_simd.h"
 
 /*********************
  *      DEFINES
@@ -37,6 +38,26 @@
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_draw_sw_init(void)
+{
+#if _LV_DRAW_SW_SIMD_ENABLED
+    _lv_draw_sw_blend_simd_init();
+#endif
+}
+
+void lv_draw_sw_deinit(void)
+{
+    _lv_draw_sw_shadow_cache_free();
+    lv_gradient_free_cache();
+}
+
+#if LV_USE_REFR_THREADS
+void _lv_draw_sw_thread_init(void)
+{
+    _lv_draw_sw_shadow_cache_init_thread();
+}
+#endif
+
 void lv_draw_sw_init_ctx(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
 {
     LV_UNUSED(drv);
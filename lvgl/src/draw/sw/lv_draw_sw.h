@@ -43,10 +43,37 @@ typedef struct {
     uint32_t has_alpha : 1;
 } lv_draw_sw_layer_ctx_t;
 
+/*Statistics of the shadow corner cache*/
+typedef struct {
+    uint32_t hit_cnt;           /*Number of shadow corners found in the cache*/
+    uint32_t miss_cnt;          /*Number of shadow corners blurred*/
+    uint32_t size;              /*Bytes used by the cached corners*/
+    uint32_t entry_cnt;         /*Number of cached corners*/
+} lv_draw_sw_shadow_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Select the instruction set of the blending. Called once by `lv_init()` before any rendering thread starts.
+ */
+void lv_draw_sw_init(void);
+
+/**
+ * Free the caches of the software renderer used by the calling thread.
+ * Called by `lv_deinit()` and by the rendering threads when they stop.
+ */
+void lv_draw_sw_deinit(void);
+
+#if LV_USE_REFR_THREADS
+/**
+ * Prepare the caches of the software renderer for the calling rendering thread.
+ * Large caches are allocated on the heap as thread-local data is placed on the stack of the thread.
+ */
+void _lv_draw_sw_thread_init(void);
+#endif
+
 void lv_draw_sw_init_ctx(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
 void lv_draw_sw_deinit_ctx(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
 
@@ -91,6 +118,28 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx);
 
+/**
+ * Allocate the shadow corner cache of the calling rendering thread.
+ * Without enough memory the thread won't cache the shadows.
+ */
+void _lv_draw_sw_shadow_cache_init_thread(void);
+
+/**
+ * Free the shadow corner cache of the calling rendering thread or empty it on other threads.
+ */
+void _lv_draw_sw_shadow_cache_free(void);
+
+/**
+ * Get the statistics of the shadow corner cache of the calling thread.
+ * @param stats store the statistics here. All zero if `LV_SHADOW_CACHE_SIZE` is 0.
+ */
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_shadow_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters of the calling thread's shadow corner cache.
+ */
+void lv_draw_sw_shadow_cache_reset_stats(void);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
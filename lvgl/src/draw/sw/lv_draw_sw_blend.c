@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_sw.h"
+#include "lv_draw_sw_blend_simd.h"
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
@@ -68,6 +69,12 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif /*LV_DRAW_COMPLEX*/
 
+#if _LV_DRAW_SW_SIMD_ENABLED
+static bool blend_simd(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                       const lv_draw_sw_blend_dsc_t * dsc, const lv_color_t * src_buf, lv_coord_t src_stride,
+                       const lv_opa_t * mask, lv_coord_t mask_stride);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -165,6 +172,13 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
 
     lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
 
+#if _LV_DRAW_SW_SIMD_ENABLED
+    if(disp->driver->set_px_cb == NULL && disp->driver->screen_transp == 0 &&
+       blend_simd(dest_buf, &blend_area, dest_stride, dsc, src_buf, src_stride, mask, mask_stride)) {
+        return;
+    }
+#endif
+
     if(disp->driver->set_px_cb) {
         if(dsc->src_buf == NULL) {
             fill_set_px(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride);
@@ -259,9 +273,6 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
-            lv_color_t last_dest_color = lv_color_black();
-            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
-
 #if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
             /*lv_color_mix work with an optimized algorithm with 16 bit color depth.
              *However, it introduces some rounded error on opa.
@@ -274,6 +285,10 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
             lv_color_premult(color, opa, color_premult);
             lv_opa_t opa_inv = 255 - opa;
 
+            /*Mix the buffered color the same way as the others (to blend it with SIMD too)*/
+            lv_color_t last_dest_color = lv_color_black();
+            lv_color_t last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
                     if(last_dest_color.full != dest_buf[x].full) {
@@ -404,10 +419,10 @@ static inline void set_px_argb(uint8_t * buf, lv_color_t color, lv_opa_t opa)
 static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t opa, lv_color_t (*blend_fp)(lv_color_t,
                                                                                                            lv_color_t, lv_opa_t))
 {
-    static lv_color_t last_dest_color;
-    static lv_color_t last_src_color;
-    static lv_color_t last_res_color;
-    static uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
+    static LV_THREAD_LOCAL lv_color_t last_dest_color;
+    static LV_THREAD_LOCAL lv_color_t last_src_color;
+    static LV_THREAD_LOCAL lv_color_t last_res_color;
+    static LV_THREAD_LOCAL uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
 
     lv_color_t bg_color;
 
@@ -1050,3 +1065,63 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 }
 
 #endif
+
+#if _LV_DRAW_SW_SIMD_ENABLED
+/**
+ * Blend an area with the SIMD functions the same way as the scalar functions would do it
+ * @return true: blended; false: the scalar functions should blend it
+ */
+static bool blend_simd(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                       const lv_draw_sw_blend_dsc_t * dsc, const lv_color_t * src_buf, lv_coord_t src_stride,
+                       const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    _lv_draw_sw_blend_simd_dsc_t simd_dsc;
+    lv_memset_00(&simd_dsc, sizeof(simd_dsc));
+    simd_dsc.dest_buf = dest_buf;
+    simd_dsc.dest_stride = dest_stride;
+    simd_dsc.src_buf = src_buf;
+    simd_dsc.src_stride = src_stride;
+    simd_dsc.color = dsc->color;
+    simd_dsc.mask = mask;
+    simd_dsc.mask_stride = mask_stride;
+    simd_dsc.w = lv_area_get_width(dest_area);
+    simd_dsc.h = lv_area_get_height(dest_area);
+    simd_dsc.opa = dsc->opa;
+    simd_dsc.blend_mode = dsc->blend_mode;
+
+    /*Handle the opacity and the mask like `fill_normal`, `map_normal`, `fill_blended` and `map_blended`*/
+    if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
+        if(mask == NULL) {
+            /*Filling and copying is already fast*/
+            if(dsc->opa >= LV_OPA_MAX) return false;
+
+            if(src_buf == NULL) {
+#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
+                lv_opa_t opa = (uint32_t)((uint32_t)dsc->opa + 4) >> 3;
+                simd_dsc.opa = opa << 3;
+#endif
+                simd_dsc.premult = 1;
+            }
+        }
+        else if(src_buf == NULL) {
+            simd_dsc.mask_full = dsc->opa >= LV_OPA_MAX ? 0 : LV_OPA_COVER;
+        }
+        else {
+            simd_dsc.mask_full = dsc->opa > LV_OPA_MAX ? 0 : LV_OPA_MAX;
+        }
+    }
+#if LV_DRAW_COMPLEX
+    else if(dsc->blend_mode == LV_BLEND_MODE_ADDITIVE || dsc->blend_mode == LV_BLEND_MODE_SUBTRACTIVE ||
+            dsc->blend_mode == LV_BLEND_MODE_MULTIPLY) {
+        /*The blend functions return the background with such a low opacity*/
+        if(mask == NULL && dsc->opa <= LV_OPA_MIN) return true;
+        simd_dsc.mask_full = LV_OPA_MAX;
+    }
+#endif
+    else {
+        return false;
+    }
+
+    return _lv_draw_sw_blend_simd(&simd_dsc);
+}
+#endif /*_LV_DRAW_SW_SIMD_ENABLED*/
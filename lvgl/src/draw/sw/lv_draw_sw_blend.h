@@ -38,6 +38,15 @@ typedef struct {
     lv_blend_mode_t blend_mode;     /**< E.g. LV_BLEND_MODE_ADDITIVE*/
 } lv_draw_sw_blend_dsc_t;
 
+enum {
+    LV_DRAW_SW_SIMD_NONE,   /**< Blend with the scalar C functions*/
+    LV_DRAW_SW_SIMD_SSE2,
+    LV_DRAW_SW_SIMD_AVX2,
+    LV_DRAW_SW_SIMD_NEON,
+};
+
+typedef uint8_t lv_draw_sw_simd_t;
+
 struct _lv_draw_ctx_t;
 
 /**********************
@@ -59,6 +68,19 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_sw_blend_dsc_t * dsc);
 
+/**
+ * Select the instruction set used to blend. By default it's the best one the CPU supports.
+ * The result of blending is the same with all of them.
+ * @param simd  an instruction set, `LV_DRAW_SW_SIMD_NONE` is used instead if the CPU or `LV_DRAW_SW_SIMD` doesn't support it
+ */
+void lv_draw_sw_blend_set_simd(lv_draw_sw_simd_t simd);
+
+/**
+ * Get the instruction set used to blend
+ * @return  the selected instruction set
+ */
+lv_draw_sw_simd_t lv_draw_sw_blend_get_simd(void);
+
 /**********************
  *      MACROS
  **********************/
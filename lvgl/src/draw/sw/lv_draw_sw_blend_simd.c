@@ -0,0 +1,180 @@
+/**
+ * @file lv_draw_sw_blend_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_simd.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SIMD_NOT_SELECTED   0xFF
+
+#if _LV_DRAW_SW_SIMD_ENABLED
+
+#define SIMD_INLINE         static inline __attribute__((always_inline))
+
+/*Vectors are passed only to inlined functions, so their ABI doesn't matter*/
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void blend_area_base(const _lv_draw_sw_blend_simd_dsc_t * dsc);
+#if _LV_DRAW_SW_SIMD_X86
+    static void blend_area_avx2(const _lv_draw_sw_blend_simd_dsc_t * dsc);
+#endif
+static bool simd_is_supported(lv_draw_sw_simd_t simd);
+
+#endif /*_LV_DRAW_SW_SIMD_ENABLED*/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_draw_sw_simd_t simd_selected = SIMD_NOT_SELECTED;
+
+/**********************
+ *      MACROS
+ **********************/
+#if _LV_DRAW_SW_SIMD_ENABLED
+
+/*Small helpers are macros as vector arguments trigger ABI notes of GCC.
+ *They work with the types of `lv_draw_sw_blend_simd_kernel.h`.*/
+
+#define VEC_STORE(buf, v)       __builtin_memcpy(buf, &(v), sizeof(v))
+
+/*`mask ? a : b` per lane*/
+#define VEC_SELECT(mask, a, b)  (((a) & (mask)) | ((b) & ~(mask)))
+
+/*Same as `LV_UDIV255` for x <= 65534*/
+#define VEC_DIV255(x)           (((x) + 1 + ((x) >> 8)) >> 8)
+
+/*`a < b ? all ones : 0` per lane for `|a - b|` smaller than half of the lanes' range.
+ *GCC falls back to scalar code for comparing vectors wider than SSE2's registers so use the sign instead.*/
+#define VEC_PX_LT(a, b)         ((vec_px_t)((vec_px_s_t)((a) - (b)) >> (sizeof(lv_color_t) * 8 - 1)))
+#define VEC_CH_LT(a, b)         ((vec_ch_t)((vec_ch_s_t)((a) - (b)) >> 15))
+
+/*`min(a, max)` for `max = 2^bits - 1` and `a <= 2 * max`*/
+#define VEC_CH_MIN(a, bits)     (((a) | (0 - ((a) >> (bits)))) & ((1 << (bits)) - 1))
+
+/*`a - b` or 0 if it would be negative*/
+#define VEC_CH_SUB(a, b)        (((a) - (b)) & ~VEC_CH_LT(a, b))
+
+#endif /*_LV_DRAW_SW_SIMD_ENABLED*/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_blend_set_simd(lv_draw_sw_simd_t simd)
+{
+#if _LV_DRAW_SW_SIMD_ENABLED
+    simd_selected = simd_is_supported(simd) ? simd : LV_DRAW_SW_SIMD_NONE;
+#else
+    LV_UNUSED(simd);
+    simd_selected = LV_DRAW_SW_SIMD_NONE;
+#endif
+}
+
+lv_draw_sw_simd_t lv_draw_sw_blend_get_simd(void)
+{
+#if _LV_DRAW_SW_SIMD_ENABLED
+    return simd_selected == SIMD_NOT_SELECTED ? LV_DRAW_SW_SIMD_NONE : simd_selected;
+#else
+    return LV_DRAW_SW_SIMD_NONE;
+#endif
+}
+
+#if _LV_DRAW_SW_SIMD_ENABLED
+
+void _lv_draw_sw_blend_simd_init(void)
+{
+    if(simd_selected != SIMD_NOT_SELECTED) return;
+
+    if(simd_is_supported(LV_DRAW_SW_SIMD_AVX2)) simd_selected = LV_DRAW_SW_SIMD_AVX2;
+    else if(simd_is_supported(LV_DRAW_SW_SIMD_SSE2)) simd_selected = LV_DRAW_SW_SIMD_SSE2;
+    else if(simd_is_supported(LV_DRAW_SW_SIMD_NEON)) simd_selected = LV_DRAW_SW_SIMD_NEON;
+    else simd_selected = LV_DRAW_SW_SIMD_NONE;
+}
+
+bool _lv_draw_sw_blend_simd(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    switch(simd_selected) {
+#if _LV_DRAW_SW_SIMD_X86
+        case LV_DRAW_SW_SIMD_AVX2:
+            blend_area_avx2(dsc);
+            return true;
+#endif
+        case LV_DRAW_SW_SIMD_SSE2:
+        case LV_DRAW_SW_SIMD_NEON:
+            blend_area_base(dsc);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool simd_is_supported(lv_draw_sw_simd_t simd)
+{
+    switch(simd) {
+        case LV_DRAW_SW_SIMD_NONE:
+            return true;
+#if _LV_DRAW_SW_SIMD_X86
+        case LV_DRAW_SW_SIMD_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case LV_DRAW_SW_SIMD_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+#if _LV_DRAW_SW_SIMD_NEON
+        case LV_DRAW_SW_SIMD_NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/*16 bytes for SSE2 and NEON*/
+#define VEC_SIZE        16
+#define KERNEL(name)    name##_16
+#define KERNEL_ATTR
+#include "lv_draw_sw_blend_simd_kernel.h"
+#undef VEC_SIZE
+#undef KERNEL
+#undef KERNEL_ATTR
+
+/*With the instruction set the whole library is compiled for (SSE2 or NEON)*/
+static void blend_area_base(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    blend_area_by_mode_16(dsc);
+}
+
+#if _LV_DRAW_SW_SIMD_X86
+
+/*32 bytes for AVX2*/
+#define VEC_SIZE        32
+#define KERNEL(name)    name##_32
+#define KERNEL_ATTR     __attribute__((target("avx2")))
+#include "lv_draw_sw_blend_simd_kernel.h"
+#undef VEC_SIZE
+#undef KERNEL
+#undef KERNEL_ATTR
+
+static void blend_area_avx2(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    blend_area_by_mode_32(dsc);
+}
+#endif
+
+#endif /*_LV_DRAW_SW_SIMD_ENABLED*/
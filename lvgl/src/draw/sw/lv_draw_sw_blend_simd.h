@@ -0,0 +1,98 @@
+/**
+ * @file lv_draw_sw_blend_simd.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BLEND_SIMD_H
+#define LV_DRAW_SW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The kernels are written with the vector extension of GCC and Clang*/
+#if LV_DRAW_SW_SIMD && defined(__GNUC__) && (LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0))
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define _LV_DRAW_SW_SIMD_X86    1
+#elif defined(__ARM_NEON)
+#define _LV_DRAW_SW_SIMD_NEON   1
+#endif
+#endif
+
+#ifndef _LV_DRAW_SW_SIMD_X86
+#define _LV_DRAW_SW_SIMD_X86    0
+#endif
+
+#ifndef _LV_DRAW_SW_SIMD_NEON
+#define _LV_DRAW_SW_SIMD_NEON   0
+#endif
+
+#define _LV_DRAW_SW_SIMD_ENABLED (_LV_DRAW_SW_SIMD_X86 || _LV_DRAW_SW_SIMD_NEON)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * An area to blend row by row. The rows don't overlap each other.
+ * Every pixel is blended as the scalar functions of `lv_draw_sw_blend.c` would do it:
+ * - the opacity of a pixel `o` is `opa` without mask, the mask value if `mask_full == 0`,
+ *   otherwise `opa` if the mask value is `>= mask_full` else `mask * opa >> 8`
+ * - pixels with 0 mask (and with `o <= LV_OPA_MIN` in the other blend modes) are not changed
+ * - `o == LV_OPA_COVER` writes the (blended) source color, else it's mixed with `lv_color_mix`
+ */
+typedef struct {
+    lv_color_t * dest_buf;
+    lv_coord_t dest_stride;
+    const lv_color_t * src_buf;     /**< NULL to blend `color`*/
+    lv_coord_t src_stride;
+    lv_color_t color;
+    const lv_opa_t * mask;          /**< NULL if there is no mask*/
+    lv_coord_t mask_stride;
+    int32_t w;
+    int32_t h;
+    lv_opa_t opa;
+    lv_opa_t mask_full;
+    lv_blend_mode_t blend_mode;     /**< NORMAL, ADDITIVE, SUBTRACTIVE or MULTIPLY*/
+    uint8_t premult : 1;            /**< 1: mix like `lv_color_mix_premult` (differs only with 16 bit and LV_COLOR_MIX_ROUND_OFS == 0)*/
+} _lv_draw_sw_blend_simd_dsc_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if _LV_DRAW_SW_SIMD_ENABLED
+
+/**
+ * Select the best instruction set of the CPU if none was selected by `lv_draw_sw_blend_set_simd` yet.
+ * Called only by `lv_init()` so the rendering threads just read the selection.
+ */
+void _lv_draw_sw_blend_simd_init(void);
+
+/**
+ * Blend an area with the selected instruction set
+ * @param dsc   descriptor of the area
+ * @return      true: blended; false: SIMD is turned off, the scalar functions should blend it
+ */
+bool _lv_draw_sw_blend_simd(const _lv_draw_sw_blend_simd_dsc_t * dsc);
+
+#endif /*_LV_DRAW_SW_SIMD_ENABLED*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_SIMD_H*/
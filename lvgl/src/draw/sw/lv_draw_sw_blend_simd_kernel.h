@@ -0,0 +1,342 @@
+/**
+ * @file lv_draw_sw_blend_simd_kernel.h
+ *
+ * The blend kernels of `lv_draw_sw_blend_simd.c` with `VEC_SIZE` bytes wide vectors.
+ * It's included once for each vector size and `KERNEL(name)` gives unique names to the types and functions.
+ * `KERNEL_ATTR` is added to the non-inline functions, e.g. to enable an instruction set.
+ * Vectors wider than the registers are very slow with GCC so every instruction set gets its own width.
+ */
+
+/*Intentionally no include guard*/
+
+/*********************
+ *      DEFINES
+ *********************/
+#define vec_px_t             KERNEL(vec_px_t)
+#define vec_px_s_t           KERNEL(vec_px_s_t)
+#define vec_ch_t             KERNEL(vec_ch_t)
+#define vec_ch_s_t           KERNEL(vec_ch_s_t)
+#define vec_mask_t           KERNEL(vec_mask_t)
+#define vec_px32_t           KERNEL(vec_px32_t)
+#define vec_load             KERNEL(vec_load)
+#define vec_load_mask        KERNEL(vec_load_mask)
+#define mask_is_transp       KERNEL(mask_is_transp)
+#define vec_mix              KERNEL(vec_mix)
+#define vec_blend_op         KERNEL(vec_blend_op)
+#define blend_vec            KERNEL(blend_vec)
+#define blend_row            KERNEL(blend_row)
+#define blend_area           KERNEL(blend_area)
+#define blend_area_normal    KERNEL(blend_area_normal)
+#define blend_area_additive  KERNEL(blend_area_additive)
+#define blend_area_subtractive KERNEL(blend_area_subtractive)
+#define blend_area_multiply  KERNEL(blend_area_multiply)
+#define blend_area_by_mode   KERNEL(blend_area_by_mode)
+
+#define VEC_PX_CNT           (VEC_SIZE / (int32_t)sizeof(lv_color_t))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_COLOR_DEPTH == 32
+typedef uint32_t vec_px_t __attribute__((vector_size(VEC_SIZE)));          /*Pixels, or a value per pixel*/
+typedef int32_t vec_px_s_t __attribute__((vector_size(VEC_SIZE)));
+typedef uint16_t vec_ch_t __attribute__((vector_size(VEC_SIZE)));          /*2 channels of the pixels (blue-red or green-alpha)*/
+typedef int16_t vec_ch_s_t __attribute__((vector_size(VEC_SIZE)));
+typedef uint8_t vec_mask_t __attribute__((vector_size(VEC_PX_CNT)));       /*The mask of the pixels*/
+#else
+typedef uint16_t vec_px_t __attribute__((vector_size(VEC_SIZE)));          /*Pixels, or a value per pixel*/
+typedef int16_t vec_px_s_t __attribute__((vector_size(VEC_SIZE)));
+typedef uint32_t vec_px32_t __attribute__((vector_size(VEC_SIZE * 2)));    /*The pixels widened*/
+typedef uint16_t vec_ch_t __attribute__((vector_size(VEC_SIZE)));          /*A channel of the pixels*/
+typedef int16_t vec_ch_s_t __attribute__((vector_size(VEC_SIZE)));
+typedef uint8_t vec_mask_t __attribute__((vector_size(VEC_PX_CNT)));       /*The mask of the pixels*/
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+SIMD_INLINE vec_px_t vec_load(const lv_color_t * buf)
+{
+    vec_px_t v;
+    __builtin_memcpy(&v, buf, sizeof(v));
+    return v;
+}
+
+SIMD_INLINE vec_px_t vec_load_mask(const lv_opa_t * mask)
+{
+    vec_mask_t m;
+    __builtin_memcpy(&m, mask, sizeof(m));
+    return __builtin_convertvector(m, vec_px_t);
+}
+
+/*Tell if the mask of all pixels is 0 (common around rounded corners and letters)*/
+SIMD_INLINE bool mask_is_transp(const lv_opa_t * mask)
+{
+    uint32_t m[sizeof(vec_mask_t) / sizeof(uint32_t)];
+    __builtin_memcpy(m, mask, sizeof(m));
+    uint32_t any = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(m) / sizeof(m[0]); i++) any |= m[i];
+    return any == 0;
+}
+
+#if LV_COLOR_DEPTH == 32
+
+/*The same as `lv_color_mix` on every pixel. Two channels are mixed at once in 16 bit lanes.*/
+SIMD_INLINE vec_px_t vec_mix(const vec_px_t * fg, const vec_px_t * bg, const vec_px_t * opa, bool premult)
+{
+    LV_UNUSED(premult);
+    vec_ch_t o = (vec_ch_t)(*opa | (*opa << 16));
+    vec_ch_t o_inv = 255 - o;
+    vec_ch_t br = VEC_DIV255((vec_ch_t)(*fg & 0xFF00FF) * o + (vec_ch_t)(*bg & 0xFF00FF) * o_inv +
+                             LV_COLOR_MIX_ROUND_OFS);
+    vec_ch_t ga = VEC_DIV255((vec_ch_t)((*fg >> 8) & 0xFF00FF) * o + (vec_ch_t)((*bg >> 8) & 0xFF00FF) * o_inv +
+                             LV_COLOR_MIX_ROUND_OFS);
+    return (vec_px_t)br | ((vec_px_t)ga << 8) | 0xFF000000;
+}
+
+/*The foreground colors of `color_blend_true_color_...` before mixing them with the background*/
+SIMD_INLINE vec_px_t vec_blend_op(const vec_px_t * fg, const vec_px_t * bg, lv_blend_mode_t mode)
+{
+    vec_ch_t fg_br = (vec_ch_t)(*fg & 0xFF00FF);
+    vec_ch_t fg_ga = (vec_ch_t)((*fg >> 8) & 0xFF00FF);
+    vec_ch_t bg_br = (vec_ch_t)(*bg & 0xFF00FF);
+    vec_ch_t bg_ga = (vec_ch_t)((*bg >> 8) & 0xFF00FF);
+    vec_ch_t br, ga;
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        br = VEC_CH_MIN(fg_br + bg_br, 8);
+        ga = VEC_CH_MIN(fg_ga + bg_ga, 8);
+    }
+    else if(mode == LV_BLEND_MODE_SUBTRACTIVE) {
+        br = VEC_CH_SUB(bg_br, fg_br);
+        ga = VEC_CH_SUB(bg_ga, fg_ga);
+    }
+    else {
+        br = (fg_br * bg_br) >> 8;
+        ga = (fg_ga * bg_ga) >> 8;
+    }
+
+    /*Only the color channels are blended*/
+    vec_px_t res = (vec_px_t)br | ((vec_px_t)ga << 8);
+    return (res & 0x00FFFFFF) | (*fg & 0xFF000000);
+}
+
+#else /*LV_COLOR_DEPTH == 16*/
+
+/*The same as `lv_color_mix` (or `lv_color_mix_premult` if `premult` is set) on every pixel*/
+SIMD_INLINE vec_px_t vec_mix(const vec_px_t * fg, const vec_px_t * bg, const vec_px_t * opa, bool premult)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    if(!premult) {
+        /*Mix the channels at once as `lv_color_mix` does*/
+        vec_px32_t fg32 = __builtin_convertvector(*fg, vec_px32_t);
+        vec_px32_t bg32 = __builtin_convertvector(*bg, vec_px32_t);
+        vec_px32_t opa32 = __builtin_convertvector((*opa + 4) >> 3, vec_px32_t);
+        fg32 = (fg32 | (fg32 << 16)) & 0x7E0F81F;
+        bg32 = (bg32 | (bg32 << 16)) & 0x7E0F81F;
+        vec_px32_t res = ((((fg32 - bg32) * opa32) >> 5) + bg32) & 0x7E0F81F;
+        return __builtin_convertvector((res >> 16) | res, vec_px_t);
+    }
+#else
+    LV_UNUSED(premult);
+#endif
+
+    vec_ch_t opa_inv = 255 - *opa;
+    vec_ch_t r = VEC_DIV255((*fg >> 11) * *opa + (*bg >> 11) * opa_inv + LV_COLOR_MIX_ROUND_OFS);
+    vec_ch_t g = VEC_DIV255(((*fg >> 5) & 0x3F) * *opa + ((*bg >> 5) & 0x3F) * opa_inv + LV_COLOR_MIX_ROUND_OFS);
+    vec_ch_t b = VEC_DIV255((*fg & 0x1F) * *opa + (*bg & 0x1F) * opa_inv + LV_COLOR_MIX_ROUND_OFS);
+    return (r << 11) | (g << 5) | b;
+}
+
+/*The foreground colors of `color_blend_true_color_...` before mixing them with the background*/
+SIMD_INLINE vec_px_t vec_blend_op(const vec_px_t * fg, const vec_px_t * bg, lv_blend_mode_t mode)
+{
+    vec_ch_t fg_r = *fg >> 11;
+    vec_ch_t fg_g = (*fg >> 5) & 0x3F;
+    vec_ch_t fg_b = *fg & 0x1F;
+    vec_ch_t bg_r = *bg >> 11;
+    vec_ch_t bg_g = (*bg >> 5) & 0x3F;
+    vec_ch_t bg_b = *bg & 0x1F;
+    vec_ch_t r, g, b;
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        r = VEC_CH_MIN(fg_r + bg_r, 5);
+        g = VEC_CH_MIN(fg_g + bg_g, 6);
+        b = VEC_CH_MIN(fg_b + bg_b, 5);
+    }
+    else if(mode == LV_BLEND_MODE_SUBTRACTIVE) {
+        r = VEC_CH_SUB(bg_r, fg_r);
+        g = VEC_CH_SUB(bg_g, fg_g);
+        b = VEC_CH_SUB(bg_b, fg_b);
+    }
+    else {
+        r = (fg_r * bg_r) >> 5;
+        g = (fg_g * bg_g) >> 6;
+        b = (fg_b * bg_b) >> 5;
+    }
+    return (r << 11) | (g << 5) | b;
+}
+
+#endif /*LV_COLOR_DEPTH*/
+
+/**
+ * Blend `VEC_PX_CNT` pixels
+ * @param dsc       descriptor of the area
+ * @param dest      the destination pixels
+ * @param src       the source pixels or NULL to blend `dsc->color`
+ * @param mask      the mask of the pixels or NULL
+ * @param mode      blend mode, a constant to get a kernel for each mode
+ */
+SIMD_INLINE void blend_vec(const _lv_draw_sw_blend_simd_dsc_t * dsc, lv_color_t * dest, const lv_color_t * src,
+                           const lv_opa_t * mask, lv_blend_mode_t mode)
+{
+    if(mask && mask_is_transp(mask)) return;
+
+    vec_px_t zero = {0};
+    vec_px_t d = vec_load(dest);
+    vec_px_t s = src ? vec_load(src) : zero + dsc->color.full;
+
+    vec_px_t opa;
+    vec_px_t keep;  /*Lanes to leave unchanged*/
+    if(mask) {
+        vec_px_t m = vec_load_mask(mask);
+        if(dsc->mask_full == 0) opa = m;
+        else {
+            /*The product fits to 16 bit lanes which can be multiplied with SSE2 too*/
+            vec_px_t m_opa = (vec_px_t)((vec_ch_t)m * dsc->opa) >> 8;
+            opa = VEC_SELECT(VEC_PX_LT(m, zero + dsc->mask_full), m_opa, zero + dsc->opa);
+        }
+
+        keep = VEC_PX_LT(m, zero + 1);
+        if(mode != LV_BLEND_MODE_NORMAL) keep |= VEC_PX_LT(opa, zero + (LV_OPA_MIN + 1));
+    }
+    else {
+        opa = zero + dsc->opa;
+        keep = zero;
+    }
+
+    vec_px_t fg = mode == LV_BLEND_MODE_NORMAL ? s : vec_blend_op(&s, &d, mode);
+    vec_px_t mix = vec_mix(&fg, &d, &opa, dsc->premult);
+    vec_px_t res = VEC_SELECT(VEC_PX_LT(opa, zero + LV_OPA_COVER), mix, fg);
+    res = VEC_SELECT(keep, d, res);
+    VEC_STORE(dest, res);
+}
+
+SIMD_INLINE void blend_row(const _lv_draw_sw_blend_simd_dsc_t * dsc, lv_color_t * dest, const lv_color_t * src,
+                           const lv_opa_t * mask, lv_blend_mode_t mode)
+{
+    lv_color_t dest_tmp[VEC_PX_CNT];
+    lv_color_t src_tmp[VEC_PX_CNT];
+    lv_opa_t mask_tmp[VEC_PX_CNT];
+
+    int32_t w = dsc->w;
+    int32_t x;
+    for(x = 0; x < w; x += VEC_PX_CNT) {
+        lv_color_t * d = dest + x;
+        const lv_color_t * s = src ? src + x : NULL;
+        const lv_opa_t * m = mask ? mask + x : NULL;
+
+        /*Blend the last pixels in a temporary buffer to not touch anything after the row.
+         *Only one `blend_vec` is inlined to keep the stack small without optimization too.*/
+        int32_t cnt = LV_MIN(w - x, VEC_PX_CNT);
+        if(cnt < VEC_PX_CNT) {
+            __builtin_memcpy(dest_tmp, d, (size_t)cnt * sizeof(lv_color_t));
+            d = dest_tmp;
+            if(s) {
+                __builtin_memcpy(src_tmp, s, (size_t)cnt * sizeof(lv_color_t));
+                s = src_tmp;
+            }
+            if(m) {
+                __builtin_memset(mask_tmp, 0, sizeof(mask_tmp));
+                __builtin_memcpy(mask_tmp, m, (size_t)cnt);
+                m = mask_tmp;
+            }
+        }
+
+        blend_vec(dsc, d, s, m, mode);
+
+        if(d == dest_tmp) __builtin_memcpy(dest + x, dest_tmp, (size_t)cnt * sizeof(lv_color_t));
+    }
+}
+
+SIMD_INLINE void blend_area(const _lv_draw_sw_blend_simd_dsc_t * dsc, lv_blend_mode_t mode)
+{
+    lv_color_t * dest = dsc->dest_buf;
+    const lv_color_t * src = dsc->src_buf;
+    const lv_opa_t * mask = dsc->mask;
+
+    int32_t y;
+    for(y = 0; y < dsc->h; y++) {
+        blend_row(dsc, dest, src, mask, mode);
+        dest += dsc->dest_stride;
+        if(src) src += dsc->src_stride;
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+/*A separate kernel for each blend mode. They are not inlined into one function to keep the stack small.*/
+KERNEL_ATTR static void blend_area_normal(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    blend_area(dsc, LV_BLEND_MODE_NORMAL);
+}
+
+KERNEL_ATTR static void blend_area_additive(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    blend_area(dsc, LV_BLEND_MODE_ADDITIVE);
+}
+
+KERNEL_ATTR static void blend_area_subtractive(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    blend_area(dsc, LV_BLEND_MODE_SUBTRACTIVE);
+}
+
+KERNEL_ATTR static void blend_area_multiply(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    blend_area(dsc, LV_BLEND_MODE_MULTIPLY);
+}
+
+static void blend_area_by_mode(const _lv_draw_sw_blend_simd_dsc_t * dsc)
+{
+    switch(dsc->blend_mode) {
+        case LV_BLEND_MODE_NORMAL:
+            blend_area_normal(dsc);
+            break;
+        case LV_BLEND_MODE_ADDITIVE:
+            blend_area_additive(dsc);
+            break;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            blend_area_subtractive(dsc);
+            break;
+        case LV_BLEND_MODE_MULTIPLY:
+            blend_area_multiply(dsc);
+            break;
+        default:
+            break;
+    }
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#undef VEC_PX_CNT
+#undef vec_px_t
+#undef vec_px_s_t
+#undef vec_ch_t
+#undef vec_ch_s_t
+#undef vec_mask_t
+#undef vec_px32_t
+#undef vec_load
+#undef vec_load_mask
+#undef mask_is_transp
+#undef vec_mix
+#undef vec_blend_op
+#undef blend_vec
+#undef blend_row
+#undef blend_area
+#undef blend_area_normal
+#undef blend_area_additive
+#undef blend_area_subtractive
+#undef blend_area_multiply
+#undef blend_area_by_mode
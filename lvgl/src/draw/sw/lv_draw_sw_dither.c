@@ -47,19 +47,29 @@ void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_hor(lv_grad_t * grad, lv_coord_t x,
          1. An error diffusion algorithm (like Floyd Steinberg) here would be hard to implement since it means that a pixel on column n depends on the pixel on row n
          2. Instead an ordered dithering algorithm shift the value a bit, but the influence only spread from the matrix size (used 8x8 here)
          3. It means that a pixel i,j only depends on the value of a pixel i-7, j-7 to i,j and no other one.
-       Then we compute a complete row of ordered dither and store it in out. */
-
-    /*The apply the algorithm for this patch*/
-    for(lv_coord_t j = 0; j < w; j++) {
-        int8_t factor = dither_ordered_threshold_matrix[(y & 7) * 8 + ((j) & 7)] - 32;
-        lv_color32_t tmp = grad->hmap[LV_CLAMP(0, j - 4, grad->size)];
-        lv_color32_t t;
-        t.ch.red   = LV_CLAMP(0, tmp.ch.red + factor, 255);
-        t.ch.green = LV_CLAMP(0, tmp.ch.green + factor, 255);
-        t.ch.blue  = LV_CLAMP(0, tmp.ch.blue + factor, 255);
-
-        grad->map[j] = lv_color_hex(t.full);
+       Then we compute a complete row of ordered dither and store it in out.
+       A row depends only on `y & 7` so the 8 possible rows are computed once and copied from the cache. */
+    if(grad->dither_rows == NULL) return;
+
+    if(!grad->filled) {
+        for(lv_coord_t i = 0; i < 8; i++) {
+            lv_color_t * row = grad->dither_rows + i * grad->w;
+            /*The apply the algorithm for this patch*/
+            for(lv_coord_t j = 0; j < grad->w; j++) {
+                int8_t factor = dither_ordered_threshold_matrix[i * 8 + ((j) & 7)] - 32;
+                lv_color32_t tmp = grad->hmap[LV_CLAMP(0, j - 4, grad->size)];
+                lv_color32_t t;
+                t.ch.red   = LV_CLAMP(0, tmp.ch.red + factor, 255);
+                t.ch.green = LV_CLAMP(0, tmp.ch.green + factor, 255);
+                t.ch.blue  = LV_CLAMP(0, tmp.ch.blue + factor, 255);
+
+                row[j] = lv_color_hex(t.full);
+            }
+        }
+        grad->filled = 1;
     }
+
+    lv_memcpy(grad->map, grad->dither_rows + (y & 7) * grad->w, LV_MIN(w, grad->w) * sizeof(lv_color_t));
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_ver(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
@@ -85,14 +95,12 @@ void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_ver(lv_grad_t * grad, lv_coord_t x,
 
         grad->map[j] = lv_color_hex(t.full);
     }
-    /*Finally fill the line*/
+    /*Finally fill the line by doubling the filled part. It stays a multiple of 8 so the pattern continues.*/
     lv_coord_t j = 8;
-    for(; j < w - 8; j += 8) {
-        lv_memcpy(grad->map + j, grad->map, 8 * sizeof(*grad->map));
-    }
-    /* Prevent overwriting */
-    for(; j < w; j++) {
-        grad->map[j] = grad->map[j & 7];
+    while(j < w) {
+        lv_coord_t n = LV_MIN(j, w - j);
+        lv_memcpy(grad->map + j, grad->map, n * sizeof(*grad->map));
+        j += n;
     }
 }
 
@@ -35,126 +35,139 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static lv_grad_t * next_in_cache(lv_grad_t * item);
-
-typedef lv_res_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out);
 static size_t get_cache_item_size(lv_grad_t * c);
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
-static lv_res_t find_item(lv_grad_t * c, void * ctx);
-static void free_item(lv_grad_t * c);
-static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
-
-/**********************
- *   STATIC VARIABLE
- **********************/
-static size_t    grad_cache_size = 0;
-static uint8_t * grad_cache_end = 0;
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, uint32_t key);
+static lv_grad_t * find_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, uint32_t key);
+static void add_item(lv_grad_t * c);
+static void remove_item(uint32_t id);
+static void remove_all_items(void);
+#if _DITHER_GRADIENT
+static bool is_dither_ordered_hor(const lv_grad_dsc_t * g);
+#endif
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+{
+    uint32_t key = ((uint32_t)g->dir << 8) | g->stops_count;
+#if _DITHER_GRADIENT
+    key = key * 31 + g->dither;
+#endif
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        key = key * 31 + g->stops[i].color.full;
+        key = key * 31 + g->stops[i].frac;
+    }
+    key = key * 31 + (uint32_t)w;
+    key = key * 31 + (uint32_t)h;
+    return key;
+}
 
-static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
+#if _DITHER_GRADIENT
+static bool is_dither_ordered_hor(const lv_grad_dsc_t * g)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
+    if(g->dir != LV_GRAD_DIR_HOR || g->dither == LV_DITHER_NONE) return false;
+#if LV_DITHER_ERROR_DIFFUSION
+    if(g->dither != LV_DITHER_ORDERED) return false;
+#endif
+    return true;
 }
+#endif
 
 static size_t get_cache_item_size(lv_grad_t * c)
 {
     size_t s = ALIGN(sizeof(*c)) + ALIGN(c->alloc_size * sizeof(lv_color_t));
 #if _DITHER_GRADIENT
     s += ALIGN(c->size * sizeof(lv_color32_t));
+    if(c->dither_rows) s += ALIGN(8 * c->w * sizeof(lv_color_t));
 #if LV_DITHER_ERROR_DIFFUSION == 1
-    s += ALIGN(c->w * sizeof(lv_scolor24_t));
+    if(c->error_acc) s += ALIGN(c->w * sizeof(lv_scolor24_t));
 #endif
 #endif
     return s;
 }
 
-static lv_grad_t * next_in_cache(lv_grad_t * item)
+static lv_grad_t * find_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, uint32_t key)
 {
-    if(grad_cache_size == 0) return NULL;
-
-    if(item == NULL)
-        return (lv_grad_t *)LV_GC_ROOT(_lv_grad_cache_mem);
-
-    size_t s = get_cache_item_size(item);
-    /*Compute the size for this cache item*/
-    if((uint8_t *)item + s >= grad_cache_end) return NULL;
-    else return (lv_grad_t *)((uint8_t *)item + s);
-}
-
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out)
-{
-    lv_grad_t * first = next_in_cache(NULL);
-    while(first != NULL && first->life) {
-        if((*func)(first, ctx) == LV_RES_OK) {
-            if(out != NULL) *out = first;
-            return LV_RES_OK;
+    _lv_grad_cache_t * cache = &LV_GC_ROOT(_lv_grad_cache);
+    uint32_t id = cache->buckets[key & (_LV_GRAD_CACHE_ITEM_MAX - 1)];
+    while(id) {
+        lv_grad_t * c = cache->items[id - 1];
+        id = c->hash_next;
+        if(c->key != key || c->w != w || c->h != h) continue;
+        if(c->dsc.dir != g->dir || c->dsc.stops_count != g->stops_count) continue;
+#if _DITHER_GRADIENT
+        if(c->dsc.dither != g->dither) continue;
+#endif
+        uint8_t i;
+        for(i = 0; i < g->stops_count; i++) {
+            if(c->dsc.stops[i].color.full != g->stops[i].color.full) break;
+            if(c->dsc.stops[i].frac != g->stops[i].frac) break;
         }
-        first = next_in_cache(first);
+        if(i == g->stops_count) return c;
     }
-    return LV_RES_INV;
+    return NULL;
 }
 
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx)
+static void add_item(lv_grad_t * c)
 {
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life < *min_life) *min_life = c->life;
-    return LV_RES_INV;
-}
+    _lv_grad_cache_t * cache = &LV_GC_ROOT(_lv_grad_cache);
+    size_t item_size = get_cache_item_size(c);
+
+    /*Drop the least recently used items to make room for the new one*/
+    while(1) {
+        uint32_t lru_id = UINT32_MAX;
+        uint32_t free_id = UINT32_MAX;
+        uint32_t i;
+        for(i = 0; i < _LV_GRAD_CACHE_ITEM_MAX; i++) {
+            lv_grad_t * item = cache->items[i];
+            if(item == NULL) {
+                if(free_id == UINT32_MAX) free_id = i;
+            }
+            else if(lru_id == UINT32_MAX ||
+                    cache->use_cnt - item->last_use > cache->use_cnt - cache->items[lru_id]->last_use) {
+                lru_id = i;
+            }
+        }
 
-static void free_item(lv_grad_t * c)
-{
-    size_t size = get_cache_item_size(c);
-    size_t next_items_size = (size_t)(grad_cache_end - (uint8_t *)c) - size;
-    grad_cache_end -= size;
-    if(next_items_size) {
-        uint8_t * old = (uint8_t *)c;
-        lv_memcpy(c, ((uint8_t *)c) + size, next_items_size);
-        /* Then need to fix all internal pointers too */
-        while((uint8_t *)c != grad_cache_end) {
-            c->map = (lv_color_t *)(((uint8_t *)c->map) - size);
-#if _DITHER_GRADIENT
-            c->hmap = (lv_color32_t *)(((uint8_t *)c->hmap) - size);
-#if LV_DITHER_ERROR_DIFFUSION == 1
-            c->error_acc = (lv_scolor24_t *)(((uint8_t *)c->error_acc) - size);
-#endif
-#endif
-            c = (lv_grad_t *)(((uint8_t *)c) + get_cache_item_size(c));
+        if(free_id != UINT32_MAX && cache->size + item_size <= cache->size_max) {
+            uint32_t bucket = c->key & (_LV_GRAD_CACHE_ITEM_MAX - 1);
+            c->hash_next = cache->buckets[bucket];
+            cache->buckets[bucket] = free_id + 1;
+            cache->items[free_id] = c;
+            cache->size += item_size;
+            return;
         }
-        lv_memset_00(old + next_items_size, size);
+        remove_item(lru_id);
     }
 }
 
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
+static void remove_item(uint32_t id)
 {
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life == *min_life) {
-        /*Found, let's kill it*/
-        free_item(c);
-        return LV_RES_OK;
-    }
-    return LV_RES_INV;
+    _lv_grad_cache_t * cache = &LV_GC_ROOT(_lv_grad_cache);
+    lv_grad_t * c = cache->items[id];
+
+    /*Unlink it from its bucket*/
+    uint8_t * link = &cache->buckets[c->key & (_LV_GRAD_CACHE_ITEM_MAX - 1)];
+    while(*link != id + 1) link = &cache->items[*link - 1]->hash_next;
+    *link = c->hash_next;
+
+    cache->size -= get_cache_item_size(c);
+    cache->items[id] = NULL;
+    lv_mem_free(c);
 }
 
-static lv_res_t find_item(lv_grad_t * c, void * ctx)
+static void remove_all_items(void)
 {
-    uint32_t * k = (uint32_t *)ctx;
-    if(c->key == *k) return LV_RES_OK;
-    return LV_RES_INV;
+    uint32_t i;
+    for(i = 0; i < _LV_GRAD_CACHE_ITEM_MAX; i++) {
+        if(LV_GC_ROOT(_lv_grad_cache).items[i]) remove_item(i);
+    }
 }
 
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, uint32_t key)
 {
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
     lv_coord_t map_size = LV_MAX(w, h); /* The map is being used horizontally (width) unless
@@ -162,68 +175,43 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 
     size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(map_size * sizeof(lv_color_t));
 #if _DITHER_GRADIENT
+    size_t hmap_ofs = req_size;
     req_size += ALIGN(size * sizeof(lv_color32_t));
+    size_t dither_rows_ofs = req_size;
+    if(is_dither_ordered_hor(g)) req_size += ALIGN(8 * w * sizeof(lv_color_t));
 #if LV_DITHER_ERROR_DIFFUSION == 1
-    req_size += ALIGN(w * sizeof(lv_scolor24_t));
+    size_t error_acc_ofs = req_size;
+    if(g->dither == LV_DITHER_ERR_DIFF) req_size += ALIGN(w * sizeof(lv_scolor24_t));
 #endif
 #endif
 
-    size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
-    lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
-        item = (lv_grad_t *)grad_cache_end;
-        item->not_cached = 0;
-    }
-    else {
-        /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
-            while(act_size + req_size > grad_cache_size) {
-                uint32_t oldest_life = UINT32_MAX;
-                iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
-                iterate_cache(&kill_oldest_item, &oldest_life, NULL);
-                act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
-            }
-            item = (lv_grad_t *)grad_cache_end;
-            item->not_cached = 0;
-        }
-        else {
-            /*The cache is too small. Allocate the item manually and free it later.*/
-            item = lv_mem_alloc(req_size);
-            LV_ASSERT_MALLOC(item);
-            if(item == NULL) return NULL;
-            item->not_cached = 1;
-        }
-    }
-
-    item->key = compute_key(g, size, w);
-    item->life = 1;
+    lv_grad_t * item = lv_mem_alloc(req_size);
+    LV_ASSERT_MALLOC(item);
+    if(item == NULL) return NULL;
+
+    uint8_t * p = (uint8_t *)item;
+    item->key = key;
+    item->last_use = LV_GC_ROOT(_lv_grad_cache).use_cnt;
+    item->dsc = *g;
+    item->w = w;
+    item->h = h;
+    item->hash_next = 0;
     item->filled = 0;
+    item->not_cached = req_size > LV_GC_ROOT(_lv_grad_cache).size_max;
     item->alloc_size = map_size;
     item->size = size;
-    if(item->not_cached) {
-        uint8_t * p = (uint8_t *)item;
-        item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
+    item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
 #if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
+    item->hmap = (lv_color32_t *)(p + hmap_ofs);
+    item->dither_rows = is_dither_ordered_hor(g) ? (lv_color_t *)(p + dither_rows_ofs) : NULL;
 #if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
+    item->error_acc = g->dither == LV_DITHER_ERR_DIFF ? (lv_scolor24_t *)(p + error_acc_ofs) : NULL;
 #endif
 #endif
-    }
-    else {
-        item->map = (lv_color_t *)(grad_cache_end + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
-        grad_cache_end += req_size;
-    }
+
+    /*The cache is too small for it. It will be freed in `lv_gradient_cleanup`.*/
+    if(!item->not_cached) add_item(item);
+
     return item;
 }
 
@@ -232,18 +220,14 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
  **********************/
 void lv_gradient_free_cache(void)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    LV_GC_ROOT(_lv_grad_cache_mem) = grad_cache_end = NULL;
-    grad_cache_size = 0;
+    remove_all_items();
+    LV_GC_ROOT(_lv_grad_cache).size_max = 0;
 }
 
 void lv_gradient_set_cache_size(size_t max_bytes)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    grad_cache_end = LV_GC_ROOT(_lv_grad_cache_mem) = lv_mem_alloc(max_bytes);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_grad_cache_mem));
-    lv_memset_00(LV_GC_ROOT(_lv_grad_cache_mem), max_bytes);
-    grad_cache_size = max_bytes;
+    remove_all_items();
+    LV_GC_ROOT(_lv_grad_cache).size_max = max_bytes;
 }
 
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
@@ -252,23 +236,31 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
     /* Step 0: Check if the cache exist (else create it) */
-    static bool inited = false;
+    static LV_THREAD_LOCAL bool inited = false;
     if(!inited) {
         lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
         inited = true;
     }
 
-    /* Step 1: Search cache for the given key */
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    uint32_t key = compute_key(g, size, w);
-    lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
-        item->life++; /* Don't forget to bump the counter */
+    /* Step 1: Search cache for the given key.
+     * Leave out the sizes the item doesn't depend on to let similar gradients share it.*/
+#if _DITHER_GRADIENT
+    if(g->dir == LV_GRAD_DIR_VER && g->dither == LV_DITHER_NONE) w = 0;
+#else
+    if(g->dir == LV_GRAD_DIR_VER) w = 0;
+#endif
+    if(g->dir == LV_GRAD_DIR_HOR) h = 0;
+
+    uint32_t key = compute_key(g, w, h);
+    LV_GC_ROOT(_lv_grad_cache).use_cnt++;
+    lv_grad_t * item = find_item(g, w, h, key);
+    if(item) {
+        item->last_use = LV_GC_ROOT(_lv_grad_cache).use_cnt;
         return item;
     }
 
     /* Step 2: Need to allocate an item for it */
-    item = allocate_item(g, w, h);
+    item = allocate_item(g, w, h, key);
     if(item == NULL) {
         LV_LOG_WARN("Faild to allcoate item for teh gradient");
         return item;
@@ -280,7 +272,7 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
         item->hmap[i] = lv_gradient_calculate(g, item->size, i);
     }
 #if LV_DITHER_ERROR_DIFFUSION == 1
-    lv_memset_00(item->error_acc, w * sizeof(lv_scolor24_t));
+    if(item->error_acc) lv_memset_00(item->error_acc, w * sizeof(lv_scolor24_t));
 #endif
 #else
     for(lv_coord_t i = 0; i < item->size; i++) {
@@ -24,6 +24,8 @@ extern "C" {
 #error LVGL needs at least 2 stops for gradients. Please increase the LV_GRADIENT_MAX_STOPS
 #endif
 
+#define _LV_GRAD_CACHE_ITEM_MAX     16      /*Must be a power of 2 as it's the number of hash buckets too*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,27 +39,42 @@ typedef lv_color_t lv_grad_color_t;
  *  it's possible to cache the computation in this structure instance.
  *  Whenever possible, this structure is reused instead of recomputing the gradient map */
 typedef struct _lv_gradient_cache_t {
-    uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
-                                   * If the key does not match, the cache item is not used */
-    uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
-                                   * less likely to be evicted from the cache */
-    uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
-    uint32_t        not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
+    uint32_t        key;          /**< A hash of the gradient and the size. It selects the bucket in the cache.
+                                   * The items with the same key are compared with `dsc`, `w` and `h` too */
+    uint32_t        last_use;     /**< The cache's use counter when the item was used last time.
+                                   * The least recently used item is evicted first */
+    lv_grad_dsc_t   dsc;          /**< Copy of the gradient the map is computed from */
+    lv_coord_t      w;            /**< The drawn width if the item depends on it, else 0 */
+    lv_coord_t      h;            /**< The drawn height if the item depends on it, else 0 */
+    uint8_t         hash_next;    /**< Index + 1 of the next item in the same bucket or 0 */
+    uint8_t         filled : 1;   /**< Used to skip dithering in it if already done */
+    uint8_t         not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
     lv_color_t   *  map;          /**< The computed gradient low bitdepth color map, points into the
-                                   * cache's buffer, no free needed */
+                                   * item's memory, no free needed */
     lv_coord_t      alloc_size;   /**< The map allocated size in colors */
     lv_coord_t      size;         /**< The computed gradient color map size, in colors */
 #if _DITHER_GRADIENT
     lv_color32_t  * hmap;         /**< If dithering, we need to store the current, high bitdepth gradient
-                                   * map too, points to the cache's buffer, no free needed */
+                                   * map too, points to the item's memory, no free needed */
+    lv_color_t    * dither_rows;  /**< Horizontal ordered dithering repeats every 8 rows so the 8 rows are
+                                   * dithered once and copied to `map`, `w` colors each. NULL otherwise */
 #if LV_DITHER_ERROR_DIFFUSION == 1
     lv_scolor24_t * error_acc;    /**< Error diffusion dithering algorithm requires storing the last error
-                                   * drawn, points to the cache's buffer, no free needed  */
-    lv_coord_t      w;            /**< The error array width in pixels */
+                                   * drawn, `w` items, points to the item's memory, no free needed.
+                                   * NULL if not error diffusion dithering */
 #endif
 #endif
 } lv_grad_t;
 
+/** The gradient cache of a thread. The items are allocated one by one so they don't move while used. */
+typedef struct {
+    lv_grad_t * items[_LV_GRAD_CACHE_ITEM_MAX]; /**< NULL: free slot */
+    uint8_t     buckets[_LV_GRAD_CACHE_ITEM_MAX]; /**< Index + 1 of the first item with the hash or 0 */
+    size_t      size;                           /**< Total size of the items in bytes */
+    size_t      size_max;
+    uint32_t    use_cnt;
+} _lv_grad_cache_t;
+
 /**********************
  *      PROTOTYPES
  **********************/
@@ -12,6 +12,7 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "lv_draw_sw_dither.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -20,9 +21,44 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    #define SHADOW_CACHE            1
+    #define SHADOW_CACHE_BUF_SIZE   ((uint32_t)LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
+    #define SHADOW_CACHE_ENTRY_MAX  16      /*Must be a power of 2 as it's the number of hash buckets too*/
+    #define SHADOW_CACHE_HASH(size, r, w, h) \
+    (((((uint32_t)(size) * 31 + (uint32_t)(r)) * 31 + (uint32_t)(w)) * 31 + (uint32_t)(h)) & \
+     (SHADOW_CACHE_ENTRY_MAX - 1))
+#else
+    #define SHADOW_CACHE            0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if SHADOW_CACHE
+/*A blurred shadow corner in `shadow_cache_t`*/
+typedef struct {
+    uint32_t ofs;       /*Start of the `size * size` opacity values in `buf`*/
+    uint32_t last_use;  /*`use_cnt` when it was used last time*/
+    lv_coord_t size;    /*Shadow width + radius*/
+    lv_coord_t r;
+    lv_coord_t w;       /*Size of the blurred rectangle as far as it affects the corner*/
+    lv_coord_t h;
+    uint8_t hash_next;  /*Index + 1 of the next entry with the same hash or 0*/
+} shadow_cache_entry_t;
+
+/*The shadow corners cached by a thread*/
+typedef struct {
+    uint8_t * buf;      /*`SHADOW_CACHE_BUF_SIZE` bytes, the corners are stored after each other in the order of `entries`*/
+    uint32_t used;
+    shadow_cache_entry_t entries[SHADOW_CACHE_ENTRY_MAX];
+    uint32_t entry_cnt;
+    uint8_t buckets[SHADOW_CACHE_ENTRY_MAX];    /*Index + 1 of the first entry or 0*/
+    uint32_t use_cnt;
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+} shadow_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -34,6 +70,10 @@ static void draw_border(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 #if LV_DRAW_COMPLEX
+static void draw_bg_corners(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * bg_coords,
+                            lv_coord_t r, const lv_opa_t * corner_map);
+static void corner_map_get_line(lv_opa_t * mask_buf, const lv_opa_t * map_line, const lv_area_t * bg_coords,
+                                lv_coord_t r, lv_coord_t abs_x, lv_coord_t len, lv_opa_t opa);
 static void /* LV_ATTRIBUTE_FAST_MEM */ draw_shadow(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
                                                     const lv_area_t * coords);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf,
@@ -41,6 +81,12 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t *
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
 #endif
 
+#if SHADOW_CACHE
+static const lv_opa_t * shadow_cache_get(lv_coord_t size, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t size, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_remove(uint32_t id);
+#endif
+
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
                          lv_coord_t rout, lv_coord_t rin, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 
@@ -50,12 +96,14 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
-#endif
+#if SHADOW_CACHE
+    static uint8_t sh_cache_main_buf[SHADOW_CACHE_BUF_SIZE];
+    static shadow_cache_t sh_cache_main = {.buf = sh_cache_main_buf};
 
+    /*The cache of the calling thread or NULL. Thread-local data is placed on the stack of the thread
+     *so the rendering threads allocate their cache on the heap in `_lv_draw_sw_thread_init()`*/
+    static LV_THREAD_LOCAL shadow_cache_t * sh_cache = &sh_cache_main;
+#endif
 /**********************
  *      MACROS
  **********************/
@@ -90,6 +138,54 @@ void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, con
     draw_bg_img(draw_ctx, dsc, coords);
 }
 
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_shadow_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_draw_sw_shadow_cache_stats_t));
+#if SHADOW_CACHE
+    if(sh_cache == NULL) return;
+    stats->hit_cnt = sh_cache->hit_cnt;
+    stats->miss_cnt = sh_cache->miss_cnt;
+    stats->size = sh_cache->used;
+    stats->entry_cnt = sh_cache->entry_cnt;
+#endif
+}
+
+void lv_draw_sw_shadow_cache_reset_stats(void)
+{
+#if SHADOW_CACHE
+    if(sh_cache == NULL) return;
+    sh_cache->hit_cnt = 0;
+    sh_cache->miss_cnt = 0;
+#endif
+}
+
+void _lv_draw_sw_shadow_cache_init_thread(void)
+{
+#if SHADOW_CACHE
+    sh_cache = lv_mem_alloc(sizeof(shadow_cache_t) + SHADOW_CACHE_BUF_SIZE);
+    if(sh_cache == NULL) {
+        LV_LOG_WARN("couldn't allocate the shadow cache of a rendering thread");
+        return;
+    }
+    lv_memset_00(sh_cache, sizeof(shadow_cache_t));
+    sh_cache->buf = (uint8_t *)(sh_cache + 1);
+#endif
+}
+
+void _lv_draw_sw_shadow_cache_free(void)
+{
+#if SHADOW_CACHE
+    if(sh_cache == &sh_cache_main) {
+        lv_memset_00(&sh_cache_main, sizeof(shadow_cache_t));
+        sh_cache_main.buf = sh_cache_main_buf;
+    }
+    else {
+        lv_mem_free(sh_cache);
+        sh_cache = NULL;
+    }
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -141,6 +237,20 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     int32_t short_side = LV_MIN(coords_bg_w, coords_bg_h);
     int32_t rout = LV_MIN(dsc->radius, short_side >> 1);
 
+    /*Without other masks use the pre-rendered corners instead of a radius mask*/
+    const lv_opa_t * corner_map = NULL;
+#if LV_CORNER_CACHE_SIZE
+    if(!mask_any && rout > 0) corner_map = _lv_draw_mask_get_corner_map(rout, false);
+#endif
+
+    /*Without gradient blend the corners straight from their map and the rest as rectangles.
+     *The map is shared so it can be passed to the blend only if it won't be rounded for disabled anti-aliasing.*/
+    if(corner_map && grad_dir == LV_GRAD_DIR_NONE && opa == LV_OPA_COVER &&
+       _lv_refr_get_disp_refreshing()->driver->antialiasing) {
+        draw_bg_corners(draw_ctx, &blend_dsc, &bg_coords, rout, corner_map);
+        return;
+    }
+
     /*Add a radius mask if there is radius*/
     int32_t clipped_w = lv_area_get_width(&clipped_coords);
     int16_t mask_rout_id = LV_MASK_ID_INV;
@@ -148,8 +258,10 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     lv_draw_mask_radius_param_t mask_rout_param;
     if(rout > 0 || mask_any) {
         mask_buf = lv_mem_buf_get(clipped_w);
-        lv_draw_mask_radius_init(&mask_rout_param, &bg_coords, rout, false);
-        mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
+        if(corner_map == NULL) {
+            lv_draw_mask_radius_init(&mask_rout_param, &bg_coords, rout, false);
+            mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
+        }
     }
 
     int32_t h;
@@ -179,7 +291,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     }
 
     if(grad && dither_mode == LV_DITHER_NONE) {
-        grad->filled = 0; /*Should we force refilling it each draw call ?*/
+        /*The map is filled only once as the item is used only for this gradient and size*/
         if(grad_dir == LV_GRAD_DIR_VER)
             grad_size = coords_bg_h;
     }
@@ -240,11 +352,17 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
         lv_coord_t bottom_y = bg_coords.y2 - h;
         if(top_y < clipped_coords.y1 && bottom_y > clipped_coords.y2) continue;   /*This line is clipped now*/
 
-        /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
-         * It saves calculating the final opa in lv_draw_sw_blend*/
-        lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, clipped_w);
-        if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        if(corner_map) {
+            corner_map_get_line(mask_buf, &corner_map[h * rout * 2], &bg_coords, rout, blend_area.x1, clipped_w, opa);
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        }
+        else {
+            /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
+             * It saves calculating the final opa in lv_draw_sw_blend*/
+            lv_memset(mask_buf, opa, clipped_w);
+            blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, clipped_w);
+            if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        }
 
         if(top_y >= clipped_coords.y1) {
             blend_area.y1 = top_y;
@@ -321,6 +439,106 @@ bg_clean_up:
 #endif
 }
 
+#if LV_DRAW_COMPLEX
+
+/**
+ * Draw a rounded rectangle without other masks: blend its corners with the corner map and the rest without mask
+ * @param draw_ctx      pointer to a draw context
+ * @param blend_dsc     blend descriptor with the color and blend mode set
+ * @param bg_coords     coordinates of the rectangle
+ * @param r             radius of the corners, not larger than the half of the shorter side
+ * @param corner_map    opacity map of the corners from `_lv_draw_mask_get_corner_map()`
+ */
+static void draw_bg_corners(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * bg_coords,
+                            lv_coord_t r, const lv_opa_t * corner_map)
+{
+    lv_area_t blend_area;
+    lv_area_t map_area;
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->opa = LV_OPA_COVER;
+
+    /*The map is a circle whose quarters are placed to the corners*/
+    blend_dsc->mask_buf = (lv_opa_t *)corner_map;
+    blend_dsc->mask_area = &map_area;
+    blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        bool right = i & 1;
+        bool bottom = i & 2;
+        map_area.x1 = right ? bg_coords->x2 - 2 * r + 1 : bg_coords->x1;
+        map_area.x2 = map_area.x1 + 2 * r - 1;
+        map_area.y1 = bottom ? bg_coords->y2 - 2 * r + 1 : bg_coords->y1;
+        map_area.y2 = map_area.y1 + 2 * r - 1;
+
+        blend_area.x1 = right ? bg_coords->x2 - r + 1 : bg_coords->x1;
+        blend_area.x2 = blend_area.x1 + r - 1;
+        blend_area.y1 = bottom ? bg_coords->y2 - r + 1 : bg_coords->y1;
+        blend_area.y2 = blend_area.y1 + r - 1;
+        lv_draw_sw_blend(draw_ctx, blend_dsc);
+    }
+
+    blend_dsc->mask_buf = NULL;
+    blend_dsc->mask_area = NULL;
+    blend_dsc->mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+
+    /*Between the top and bottom corners*/
+    blend_area.x1 = bg_coords->x1 + r;
+    blend_area.x2 = bg_coords->x2 - r;
+    if(blend_area.x1 <= blend_area.x2) {
+        blend_area.y1 = bg_coords->y1;
+        blend_area.y2 = bg_coords->y1 + r - 1;
+        lv_draw_sw_blend(draw_ctx, blend_dsc);
+
+        blend_area.y1 = bg_coords->y2 - r + 1;
+        blend_area.y2 = bg_coords->y2;
+        lv_draw_sw_blend(draw_ctx, blend_dsc);
+    }
+
+    /*The full width center*/
+    blend_area.x1 = bg_coords->x1;
+    blend_area.x2 = bg_coords->x2;
+    blend_area.y1 = bg_coords->y1 + r;
+    blend_area.y2 = bg_coords->y2 - r;
+    if(blend_area.y1 <= blend_area.y2) lv_draw_sw_blend(draw_ctx, blend_dsc);
+}
+
+/**
+ * Get the mask of a line in the top corners of a rounded rectangle from the corner map.
+ * Gives the same result as applying a radius mask on a line initialized to `opa`.
+ * @param mask_buf      store the mask here
+ * @param map_line      line of the corner map
+ * @param bg_coords     coordinates of the rectangle
+ * @param r             radius of the corners
+ * @param abs_x         absolute x coordinate of the first pixel of `mask_buf`
+ * @param len           length of `mask_buf`. Needs to be inside `bg_coords`.
+ * @param opa           opacity of the rectangle
+ */
+static void corner_map_get_line(lv_opa_t * mask_buf, const lv_opa_t * map_line, const lv_area_t * bg_coords,
+                                lv_coord_t r, lv_coord_t abs_x, lv_coord_t len, lv_opa_t opa)
+{
+    lv_memset(mask_buf, opa, len);
+
+    lv_coord_t x;
+    lv_coord_t abs_x2 = abs_x + len - 1;
+
+    /*The left half of the map's line is the left corner*/
+    lv_coord_t x_end = LV_MIN(abs_x2, bg_coords->x1 + r - 1);
+    for(x = LV_MAX(abs_x, bg_coords->x1); x <= x_end; x++) {
+        lv_opa_t map_opa = map_line[x - bg_coords->x1];
+        mask_buf[x - abs_x] = opa == LV_OPA_COVER ? map_opa : LV_UDIV255(map_opa * opa);
+    }
+
+    /*The right half of the map's line is the right corner*/
+    lv_coord_t map_x1 = bg_coords->x2 - 2 * r + 1;
+    x_end = LV_MIN(abs_x2, bg_coords->x2);
+    for(x = LV_MAX(abs_x, bg_coords->x2 - r + 1); x <= x_end; x++) {
+        lv_opa_t map_opa = map_line[x - map_x1];
+        mask_buf[x - abs_x] = opa == LV_OPA_COVER ? map_opa : LV_UDIV255(map_opa * opa);
+    }
+}
+
+#endif /*LV_DRAW_COMPLEX*/
+
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->bg_img_src == NULL) return;
@@ -478,23 +696,21 @@ static void LV_ATTRIBUTE_FAST_MEM draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
 
     lv_opa_t * sh_buf;
 
-#if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
+#if SHADOW_CACHE
+    /*The far side of the blurred rectangle doesn't affect the corner if the rectangle is large enough*/
+    lv_coord_t cache_w = LV_MIN(lv_area_get_width(&core_area), 2 * corner_size);
+    lv_coord_t cache_h = LV_MIN(lv_area_get_height(&core_area), 2 * corner_size);
+    const lv_opa_t * sh_cached = shadow_cache_get(corner_size, r_sh, cache_w, cache_h);
+    if(sh_cached) {
+        /*Copy it as it's modified while drawing*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        lv_memcpy(sh_buf, sh_cached, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        shadow_cache_add(sh_buf, corner_size, r_sh, cache_w, cache_h);
     }
 #else
     sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1103,6 +1319,111 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(lv_coord_t size, lv_coord_t
 }
 #endif
 
+#if SHADOW_CACHE
+
+/**
+ * Find a blurred shadow corner in the cache of the calling thread
+ * @param size      shadow width + radius
+ * @param r         radius of the shadow
+ * @param w         width of the blurred rectangle, limited to where it affects the corner
+ * @param h         height of the blurred rectangle, limited to where it affects the corner
+ * @return          `size * size` opacity values or NULL if not cached
+ */
+static const lv_opa_t * shadow_cache_get(lv_coord_t size, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    if(sh_cache == NULL) return NULL;
+
+    uint32_t id = sh_cache->buckets[SHADOW_CACHE_HASH(size, r, w, h)];
+    while(id) {
+        shadow_cache_entry_t * entry = &sh_cache->entries[id - 1];
+        if(entry->size == size && entry->r == r && entry->w == w && entry->h == h) {
+            sh_cache->hit_cnt++;
+            sh_cache->use_cnt++;
+            entry->last_use = sh_cache->use_cnt;
+            return &sh_cache->buf[entry->ofs];
+        }
+        id = entry->hash_next;
+    }
+
+    sh_cache->miss_cnt++;
+    return NULL;
+}
+
+/**
+ * Save a blurred shadow corner in the cache of the calling thread if it fits
+ * @param sh_buf    `size * size` opacity values
+ * @param size      shadow width + radius
+ * @param r         radius of the shadow
+ * @param w         width of the blurred rectangle, limited to where it affects the corner
+ * @param h         height of the blurred rectangle, limited to where it affects the corner
+ */
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t size, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    if(sh_cache == NULL) return;
+
+    uint32_t map_size = (uint32_t)size * size;
+    if(map_size >= SHADOW_CACHE_BUF_SIZE) return;
+
+    /*Drop the least recently used corners to make room for the new one*/
+    while(sh_cache->entry_cnt == SHADOW_CACHE_ENTRY_MAX || sh_cache->used + map_size > SHADOW_CACHE_BUF_SIZE) {
+        uint32_t lru_id = 0;
+        uint32_t i;
+        for(i = 1; i < sh_cache->entry_cnt; i++) {
+            if(sh_cache->use_cnt - sh_cache->entries[i].last_use > sh_cache->use_cnt - sh_cache->entries[lru_id].last_use) {
+                lru_id = i;
+            }
+        }
+        shadow_cache_remove(lru_id);
+    }
+
+    shadow_cache_entry_t * entry = &sh_cache->entries[sh_cache->entry_cnt];
+    entry->ofs = sh_cache->used;
+    entry->size = size;
+    entry->r = r;
+    entry->w = w;
+    entry->h = h;
+    sh_cache->use_cnt++;
+    entry->last_use = sh_cache->use_cnt;
+    lv_memcpy(&sh_cache->buf[entry->ofs], sh_buf, map_size);
+    sh_cache->used += map_size;
+
+    uint32_t hash = SHADOW_CACHE_HASH(size, r, w, h);
+    entry->hash_next = sh_cache->buckets[hash];
+    sh_cache->entry_cnt++;
+    sh_cache->buckets[hash] = sh_cache->entry_cnt;
+}
+
+/**
+ * Remove a corner from the cache and move the next ones to its place to keep the free space in one block
+ * @param id        index of the entry in `sh_cache->entries`
+ */
+static void shadow_cache_remove(uint32_t id)
+{
+    shadow_cache_entry_t * entry = &sh_cache->entries[id];
+    uint32_t map_size = (uint32_t)entry->size * entry->size;
+    uint32_t next_ofs = entry->ofs + map_size;
+    memmove(&sh_cache->buf[entry->ofs], &sh_cache->buf[next_ofs], sh_cache->used - next_ofs);
+    sh_cache->used -= map_size;
+
+    uint32_t i;
+    for(i = id + 1; i < sh_cache->entry_cnt; i++) {
+        sh_cache->entries[i - 1] = sh_cache->entries[i];
+        sh_cache->entries[i - 1].ofs -= map_size;
+    }
+    sh_cache->entry_cnt--;
+
+    /*The indices have changed so add all the entries to the hash buckets again*/
+    lv_memset_00(sh_cache->buckets, sizeof(sh_cache->buckets));
+    for(i = 0; i < sh_cache->entry_cnt; i++) {
+        uint32_t hash = SHADOW_CACHE_HASH(sh_cache->entries[i].size, sh_cache->entries[i].r,
+                                          sh_cache->entries[i].w, sh_cache->entries[i].h);
+        sh_cache->entries[i].hash_next = sh_cache->buckets[hash];
+        sh_cache->buckets[hash] = i + 1;
+    }
+}
+
+#endif /*SHADOW_CACHE*/
+
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->outline_opa <= LV_OPA_MIN) return;
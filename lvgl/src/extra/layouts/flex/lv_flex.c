@@ -17,15 +17,6 @@
 /**********************
  *      TYPEDEFS
  **********************/
-typedef struct {
-    lv_flex_align_t main_place;
-    lv_flex_align_t cross_place;
-    lv_flex_align_t track_place;
-    uint8_t row : 1;
-    uint8_t wrap : 1;
-    uint8_t rev : 1;
-} flex_t;
-
 typedef struct {
     lv_obj_t * item;
     lv_coord_t min_size;
@@ -36,13 +27,27 @@ typedef struct {
 } grow_dsc_t;
 
 typedef struct {
+    lv_flex_align_t main_place;
+    lv_flex_align_t cross_place;
+    lv_flex_align_t track_place;
+    uint8_t row : 1;
+    uint8_t wrap : 1;
+    uint8_t rev : 1;
+    uint8_t rtl : 1;
+    grow_dsc_t * grow_dsc;              /*The grow items of all tracks*/
+    uint32_t grow_dsc_cnt;
+    uint32_t grow_dsc_size;             /*Number of elements fitting into `grow_dsc`*/
+} flex_t;
+
+typedef struct {
+    int32_t item_first_id;
+    int32_t item_end_id;                /*The first item of the next track*/
     lv_coord_t track_cross_size;
     lv_coord_t track_main_size;         /*For all items*/
     lv_coord_t track_fix_main_size;     /*For non grow items*/
     uint32_t item_cnt;
-    grow_dsc_t * grow_dsc;
+    uint32_t grow_dsc_id;               /*Index of the first grow item in `flex_t`'s `grow_dsc`*/
     uint32_t grow_item_cnt;
-    uint32_t grow_dsc_calc : 1;
 } track_t;
 
 /**********************
@@ -57,6 +62,7 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                               lv_coord_t item_gap, track_t * t);
 static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, int32_t item_last_id, lv_coord_t abs_x,
                            lv_coord_t abs_y, lv_coord_t max_main_size, lv_coord_t item_gap, track_t * t);
+static bool buf_reserve(void ** buf, uint32_t cnt, uint32_t * size, size_t elem_size);
 static void place_content(lv_flex_align_t place, lv_coord_t max_size, lv_coord_t content_size, lv_coord_t item_cnt,
                           lv_coord_t * start_pos, lv_coord_t * gap);
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
@@ -216,8 +222,12 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     f.main_place = lv_obj_get_style_flex_main_place(cont, LV_PART_MAIN);
     f.cross_place = lv_obj_get_style_flex_cross_place(cont, LV_PART_MAIN);
     f.track_place = lv_obj_get_style_flex_track_place(cont, LV_PART_MAIN);
+    f.rtl = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL ? 1 : 0;
+    f.grow_dsc = NULL;
+    f.grow_dsc_cnt = 0;
+    f.grow_dsc_size = 0;
 
-    bool rtl = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL ? true : false;
+    bool rtl = f.rtl;
     lv_coord_t track_gap = !f.row ? lv_obj_get_style_pad_column(cont, LV_PART_MAIN) : lv_obj_get_style_pad_row(cont,
                                                                                                                LV_PART_MAIN);
     lv_coord_t item_gap = f.row ? lv_obj_get_style_pad_column(cont, LV_PART_MAIN) : lv_obj_get_style_pad_row(cont,
@@ -235,6 +245,11 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
     lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
 
+    /*Can't wrap if the size if auto (i.e. the size depends on the children)*/
+    if(f.wrap && ((f.row && w_set == LV_SIZE_CONTENT) || (!f.row && h_set == LV_SIZE_CONTENT))) {
+        f.wrap = false;
+    }
+
     /*Content sized objects should squeezed the gap between the children, therefore any alignment will look like `START`*/
     if((f.row && h_set == LV_SIZE_CONTENT && cont->h_layout == 0) ||
        (!f.row && w_set == LV_SIZE_CONTENT && cont->w_layout == 0)) {
@@ -246,22 +261,29 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         else if(track_cross_place == LV_FLEX_ALIGN_END) track_cross_place = LV_FLEX_ALIGN_START;
     }
 
+    /*Measure the tracks only once and use the result to place the tracks and the items too*/
+    track_t * tracks = NULL;
+    uint32_t track_size = 0;
+    uint32_t track_cnt = 0;
+    int32_t track_first_item = f.rev ? cont->spec_attr->child_cnt - 1 : 0;
+    while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
+        if(!buf_reserve((void **)&tracks, track_cnt, &track_size, sizeof(track_t))) break;
+
+        /*Search the first item of the next row*/
+        track_t * t = &tracks[track_cnt];
+        t->item_first_id = track_first_item;
+        t->item_end_id = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, t);
+        track_cnt++;
+        track_first_item = t->item_end_id;
+    }
+
     lv_coord_t total_track_cross_size = 0;
     lv_coord_t gap = 0;
-    uint32_t track_cnt = 0;
-    int32_t track_first_item;
-    int32_t next_track_first_item;
+    uint32_t i;
 
     if(track_cross_place != LV_FLEX_ALIGN_START) {
-        track_first_item = f.rev ? cont->spec_attr->child_cnt - 1 : 0;
-        track_t t;
-        while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
-            /*Search the first item of the next row*/
-            t.grow_dsc_calc = 0;
-            next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
-            total_track_cross_size += t.track_cross_size + track_gap;
-            track_cnt++;
-            track_first_item = next_track_first_item;
+        for(i = 0; i < track_cnt; i++) {
+            total_track_cross_size += tracks[i].track_cross_size + track_gap;
         }
 
         if(track_cnt) total_track_cross_size -= track_gap;   /*No gap after the last track*/
@@ -271,32 +293,26 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         place_content(track_cross_place, max_cross_size, total_track_cross_size, track_cnt, cross_pos, &gap);
     }
 
-    track_first_item = f.rev ? cont->spec_attr->child_cnt - 1 : 0;
-
     if(rtl && !f.row) {
         *cross_pos += total_track_cross_size;
     }
 
-    while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
-        track_t t;
-        t.grow_dsc_calc = 1;
-        /*Search the first item of the next row*/
-        next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
-
+    for(i = 0; i < track_cnt; i++) {
+        track_t * t = &tracks[i];
         if(rtl && !f.row) {
-            *cross_pos -= t.track_cross_size;
+            *cross_pos -= t->track_cross_size;
         }
-        children_repos(cont, &f, track_first_item, next_track_first_item, abs_x, abs_y, max_main_size, item_gap, &t);
-        track_first_item = next_track_first_item;
-        lv_mem_buf_release(t.grow_dsc);
-        t.grow_dsc = NULL;
+        children_repos(cont, &f, t->item_first_id, t->item_end_id, abs_x, abs_y, max_main_size, item_gap, t);
         if(rtl && !f.row) {
             *cross_pos -= gap + track_gap;
         }
         else {
-            *cross_pos += t.track_cross_size + gap + track_gap;
+            *cross_pos += t->track_cross_size + gap + track_gap;
         }
     }
+
+    lv_mem_buf_release(tracks);
+    lv_mem_buf_release(f.grow_dsc);
     LV_ASSERT_MEM_INTEGRITY();
 
     if(w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) {
@@ -314,13 +330,6 @@ static void flex_update(lv_obj_t * cont, void * user_data)
 static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id, lv_coord_t max_main_size,
                               lv_coord_t item_gap, track_t * t)
 {
-    lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
-    lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
-
-    /*Can't wrap if the size if auto (i.e. the size depends on the children)*/
-    if(f->wrap && ((f->row && w_set == LV_SIZE_CONTENT) || (!f->row && h_set == LV_SIZE_CONTENT))) {
-        f->wrap = false;
-    }
     lv_coord_t(*get_main_size)(const lv_obj_t *) = (f->row ? lv_obj_get_width : lv_obj_get_height);
     lv_coord_t(*get_cross_size)(const lv_obj_t *) = (!f->row ? lv_obj_get_width : lv_obj_get_height);
 
@@ -329,7 +338,7 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     t->grow_item_cnt = 0;
     t->track_cross_size = 0;
     t->item_cnt = 0;
-    t->grow_dsc = NULL;
+    t->grow_dsc_id = f->grow_dsc_cnt;
 
     int32_t item_id = item_start_id;
 
@@ -340,26 +349,19 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
         if(!lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
             uint8_t grow_value = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
             if(grow_value) {
+                if(!buf_reserve((void **)&f->grow_dsc, f->grow_dsc_cnt, &f->grow_dsc_size, sizeof(grow_dsc_t))) return item_id;
+
                 t->grow_item_cnt++;
                 t->track_fix_main_size += item_gap;
-                if(t->grow_dsc_calc) {
-                    grow_dsc_t * new_dsc = lv_mem_buf_get(sizeof(grow_dsc_t) * (t->grow_item_cnt));
-                    LV_ASSERT_MALLOC(new_dsc);
-                    if(new_dsc == NULL) return item_id;
-
-                    if(t->grow_dsc) {
-                        lv_memcpy(new_dsc, t->grow_dsc, sizeof(grow_dsc_t) * (t->grow_item_cnt - 1));
-                        lv_mem_buf_release(t->grow_dsc);
-                    }
-                    new_dsc[t->grow_item_cnt - 1].item = item;
-                    new_dsc[t->grow_item_cnt - 1].min_size = f->row ? lv_obj_get_style_min_width(item,
-                                                                                                 LV_PART_MAIN) : lv_obj_get_style_min_height(item, LV_PART_MAIN);
-                    new_dsc[t->grow_item_cnt - 1].max_size = f->row ? lv_obj_get_style_max_width(item,
-                                                                                                 LV_PART_MAIN) : lv_obj_get_style_max_height(item, LV_PART_MAIN);
-                    new_dsc[t->grow_item_cnt - 1].grow_value = grow_value;
-                    new_dsc[t->grow_item_cnt - 1].clamped = 0;
-                    t->grow_dsc = new_dsc;
-                }
+                grow_dsc_t * new_dsc = &f->grow_dsc[f->grow_dsc_cnt];
+                f->grow_dsc_cnt++;
+                new_dsc->item = item;
+                new_dsc->min_size = f->row ? lv_obj_get_style_min_width(item,
+                                                                       LV_PART_MAIN) : lv_obj_get_style_min_height(item, LV_PART_MAIN);
+                new_dsc->max_size = f->row ? lv_obj_get_style_max_width(item,
+                                                                       LV_PART_MAIN) : lv_obj_get_style_max_height(item, LV_PART_MAIN);
+                new_dsc->grow_value = grow_value;
+                new_dsc->clamped = 0;
             }
             else {
                 lv_coord_t item_size = get_main_size(item);
@@ -404,6 +406,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     void (*area_set_main_size)(lv_area_t *, lv_coord_t) = (f->row ? lv_area_set_width : lv_area_set_height);
     lv_coord_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
     lv_coord_t (*area_get_cross_size)(const lv_area_t *) = (!f->row ? lv_area_get_width : lv_area_get_height);
+    grow_dsc_t * grow_dsc = t->grow_item_cnt ? &f->grow_dsc[t->grow_dsc_id] : NULL;
 
     /*Calculate the size of grow items first*/
     uint32_t i;
@@ -413,34 +416,34 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
         lv_coord_t grow_value_sum = 0;
         lv_coord_t grow_max_size = t->track_main_size - t->track_fix_main_size;
         for(i = 0; i < t->grow_item_cnt; i++) {
-            if(t->grow_dsc[i].clamped == 0) {
-                grow_value_sum += t->grow_dsc[i].grow_value;
+            if(grow_dsc[i].clamped == 0) {
+                grow_value_sum += grow_dsc[i].grow_value;
             }
             else {
-                grow_max_size -= t->grow_dsc[i].final_size;
+                grow_max_size -= grow_dsc[i].final_size;
             }
         }
         lv_coord_t grow_unit;
 
         for(i = 0; i < t->grow_item_cnt; i++) {
-            if(t->grow_dsc[i].clamped == 0) {
+            if(grow_dsc[i].clamped == 0) {
                 LV_ASSERT(grow_value_sum != 0);
                 grow_unit = grow_max_size / grow_value_sum;
-                lv_coord_t size = grow_unit * t->grow_dsc[i].grow_value;
-                lv_coord_t size_clamp = LV_CLAMP(t->grow_dsc[i].min_size, size, t->grow_dsc[i].max_size);
+                lv_coord_t size = grow_unit * grow_dsc[i].grow_value;
+                lv_coord_t size_clamp = LV_CLAMP(grow_dsc[i].min_size, size, grow_dsc[i].max_size);
 
                 if(size_clamp != size) {
-                    t->grow_dsc[i].clamped = 1;
+                    grow_dsc[i].clamped = 1;
                     grow_reiterate = true;
                 }
-                t->grow_dsc[i].final_size = size_clamp;
-                grow_value_sum -= t->grow_dsc[i].grow_value;
-                grow_max_size  -= t->grow_dsc[i].final_size;
+                grow_dsc[i].final_size = size_clamp;
+                grow_value_sum -= grow_dsc[i].grow_value;
+                grow_max_size  -= grow_dsc[i].final_size;
             }
         }
     }
 
-    bool rtl = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL ? true : false;
+    bool rtl = f->rtl;
 
     lv_coord_t main_pos = 0;
 
@@ -449,21 +452,17 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     if(f->row && rtl) main_pos += lv_obj_get_content_width(cont);
 
     lv_obj_t * item = lv_obj_get_child(cont, item_first_id);
+    uint32_t grow_id = 0;
     /*Reposition the children*/
     while(item && item_first_id != item_last_id) {
         if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
             item = get_next_item(cont, f->rev, &item_first_id);
             continue;
         }
-        lv_coord_t grow_size = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
-        if(grow_size) {
-            lv_coord_t s = 0;
-            for(i = 0; i < t->grow_item_cnt; i++) {
-                if(t->grow_dsc[i].item == item) {
-                    s = t->grow_dsc[i].final_size;
-                    break;
-                }
-            }
+        /*The grow items were collected in the same order*/
+        if(grow_id < t->grow_item_cnt && grow_dsc[grow_id].item == item) {
+            lv_coord_t s = grow_dsc[grow_id].final_size;
+            grow_id++;
 
             if(f->row) {
                 item->w_layout = 1;
@@ -579,6 +578,33 @@ static void place_content(lv_flex_align_t place, lv_coord_t max_size, lv_coord_t
     }
 }
 
+/**
+ * Get a larger buffer with `lv_mem_buf_get` if the current one is full.
+ * The size is doubled to copy the elements only a few times.
+ * @param buf           pointer to the buffer. Replaced by the new buffer.
+ * @param cnt           number of used elements
+ * @param size          number of elements fitting into the buffer. Updated with the new size.
+ * @param elem_size     size of an element in bytes
+ * @return              false: out of memory
+ */
+static bool buf_reserve(void ** buf, uint32_t cnt, uint32_t * size, size_t elem_size)
+{
+    if(cnt < *size) return true;
+
+    uint32_t new_size = *size ? *size * 2 : 4;
+    void * new_buf = lv_mem_buf_get(new_size * elem_size);
+    LV_ASSERT_MALLOC(new_buf);
+    if(new_buf == NULL) return false;
+
+    if(*buf) {
+        lv_memcpy(new_buf, *buf, cnt * elem_size);
+        lv_mem_buf_release(*buf);
+    }
+    *buf = new_buf;
+    *size = new_size;
+    return true;
+}
+
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id)
 {
     if(rev) {
@@ -3,6 +3,9 @@
 #if LV_USE_TINY_TTF
 #include <stdio.h>
 #include "../../../misc/lv_lru.h"
+#if LV_USE_REFR_THREADS
+    #include <pthread.h>
+#endif
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -75,6 +78,9 @@ typedef struct ttf_font_desc {
     int ascent;
     int descent;
     lv_lru_t * bitmap_cache;
+#if LV_USE_REFR_THREADS
+    pthread_mutex_t mutex;  /*The stream and the bitmap cache are used by several rendering threads*/
+#endif
 } ttf_font_desc_t;
 
 typedef struct ttf_bitmap_cache_key {
@@ -82,6 +88,13 @@ typedef struct ttf_bitmap_cache_key {
     lv_coord_t line_height;
 } ttf_bitmap_cache_key_t;
 
+#if LV_USE_REFR_THREADS
+/*The last glyph bitmap of the calling thread. Another thread can drop the glyph from the cache
+ *while it's being drawn so it's copied here. Freed by `_lv_tiny_ttf_clean_up()`.*/
+static LV_THREAD_LOCAL uint8_t * glyph_buf;
+static LV_THREAD_LOCAL size_t glyph_buf_size;
+#endif
+
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
 {
@@ -98,9 +111,15 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+#if LV_USE_REFR_THREADS
+    pthread_mutex_lock(&dsc->mutex);
+#endif
     int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
     if(g1 == 0) {
         /* Glyph not found */
+#if LV_USE_REFR_THREADS
+        pthread_mutex_unlock(&dsc->mutex);
+#endif
         return false;
     }
     int x1, y1, x2, y2;
@@ -113,6 +132,9 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
     int advw, lsb;
     stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
     int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
+#if LV_USE_REFR_THREADS
+    pthread_mutex_unlock(&dsc->mutex);
+#endif
     dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
 
@@ -127,7 +149,8 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
     return true; /*true: glyph found; false: glyph was not found*/
 }
 
-static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
+static const uint8_t * ttf_get_cached_glyph_bitmap(const lv_font_t * font, uint32_t unicode_letter,
+                                                   size_t * size_out)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
     const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
@@ -148,13 +171,14 @@ static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t
     cache_key.unicode_letter = unicode_letter;
     cache_key.line_height = font->line_height;
     uint8_t * buffer = NULL;
+    size_t szb = h * stride;
+    *size_out = szb;
     lv_lru_get(dsc->bitmap_cache, &cache_key, sizeof(cache_key), (void **)&buffer);
     if(buffer) {
         return buffer;
     }
     LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
     /*Prepare space in cache*/
-    size_t szb = h * stride;
     buffer = lv_mem_alloc(szb);
     if(!buffer) {
         LV_LOG_ERROR("failed to allocate cache value");
@@ -171,6 +195,34 @@ static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t
     return buffer;
 }
 
+static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
+{
+    size_t size;
+#if LV_USE_REFR_THREADS
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    pthread_mutex_lock(&dsc->mutex);
+    const uint8_t * bitmap = ttf_get_cached_glyph_bitmap(font, unicode_letter, &size);
+    if(bitmap && glyph_buf_size < size) {
+        uint8_t * new_buf = lv_mem_realloc(glyph_buf, size);
+        if(new_buf) {
+            glyph_buf = new_buf;
+            glyph_buf_size = size;
+        }
+    }
+    if(bitmap && glyph_buf_size >= size) {
+        lv_memcpy(glyph_buf, bitmap, size);
+        bitmap = glyph_buf;
+    }
+    else {
+        bitmap = NULL;
+    }
+    pthread_mutex_unlock(&dsc->mutex);
+    return bitmap;
+#else
+    return ttf_get_cached_glyph_bitmap(font, unicode_letter, &size);
+#endif
+}
+
 static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
                                       size_t cache_size)
 {
@@ -216,6 +268,9 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
         LV_LOG_ERROR("failed to create lru cache");
         goto err_after_dsc;
     }
+#if LV_USE_REFR_THREADS
+    pthread_mutex_init(&dsc->mutex, NULL);
+#endif
 
     lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
     if(out_font == NULL) {
@@ -229,6 +284,9 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
 err_after_bitmap_cache:
+#if LV_USE_REFR_THREADS
+    pthread_mutex_destroy(&dsc->mutex);
+#endif
     lv_lru_del(dsc->bitmap_cache);
 err_after_dsc:
     TTF_FREE(dsc);
@@ -276,9 +334,21 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
             }
 #endif
             lv_lru_del(ttf->bitmap_cache);
+#if LV_USE_REFR_THREADS
+            pthread_mutex_destroy(&ttf->mutex);
+#endif
             TTF_FREE(ttf);
         }
         TTF_FREE(font);
     }
 }
+#if LV_USE_REFR_THREADS
+void _lv_tiny_ttf_clean_up(void)
+{
+    lv_mem_free(glyph_buf);
+    glyph_buf = NULL;
+    glyph_buf_size = 0;
+}
+#endif
+
 #endif /*LV_USE_TINY_TTF*/
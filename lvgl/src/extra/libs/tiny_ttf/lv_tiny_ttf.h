@@ -49,6 +49,11 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size);
 /* destroy a font previously created with lv_tiny_ttf_create_xxxx()*/
 void lv_tiny_ttf_destroy(lv_font_t * font);
 
+#if LV_USE_REFR_THREADS
+/* free the copy of the last glyph bitmap of the calling thread. Called after rendering.*/
+void _lv_tiny_ttf_clean_up(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
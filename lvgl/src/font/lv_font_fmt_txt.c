@@ -15,9 +15,45 @@
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
 
+#if LV_FONT_FMT_TXT_FAST_LOOKUP && LV_USE_REFR_THREADS
+    #include <pthread.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
+/*The one letter cache of a font is shared by all the threads and its two fields can't be updated at once,
+ *so it's not used when several threads render*/
+#if LV_USE_REFR_THREADS
+    #define GLYPH_ID_CACHE(fdsc) ((lv_font_fmt_txt_glyph_cache_t *)NULL)
+#else
+    #define GLYPH_ID_CACHE(fdsc) ((fdsc)->cache)
+#endif
+
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+    /*The Basic Multilingual Plane is covered by pages of 256 code points*/
+    #define FAST_LOOKUP_PAGE_SIZE       256
+    #define FAST_LOOKUP_PAGE_CNT        (0x10000 / FAST_LOOKUP_PAGE_SIZE)
+
+    /*The kerning pairs of the glyphs with smaller id are stored in a matrix.
+     *Fonts are ordered by code point so these are usually the ASCII characters.*/
+    #define FAST_LOOKUP_KERN_GLYPHS     128
+
+    /*The render threads look for the tables while another thread might add a new font to the list*/
+    #if LV_USE_REFR_THREADS
+        #define FAST_LOOKUP_LIST_GET()      __atomic_load_n(&LV_GC_ROOT(_lv_font_fast_lookup_list), __ATOMIC_ACQUIRE)
+        #define FAST_LOOKUP_LIST_SET(fl)    __atomic_store_n(&LV_GC_ROOT(_lv_font_fast_lookup_list), fl, __ATOMIC_RELEASE)
+    #else
+        #define FAST_LOOKUP_LIST_GET()      LV_GC_ROOT(_lv_font_fast_lookup_list)
+        #define FAST_LOOKUP_LIST_SET(fl)    LV_GC_ROOT(_lv_font_fast_lookup_list) = fl
+    #endif
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    #define BITMAP_CACHE 1
+#else
+    #define BITMAP_CACHE 0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +64,36 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+/*Lookup tables of a font, built at its first use*/
+typedef struct _lv_font_fmt_txt_fast_lookup_t {
+    struct _lv_font_fmt_txt_fast_lookup_t * next;
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint16_t page_ids[FAST_LOOKUP_PAGE_CNT];    /*1 + index of the code points' page in `gids`. 0: no glyphs on the page*/
+    uint16_t * gids;                            /*Glyph ids of the pages with glyphs*/
+    int8_t * kern_matrix;                       /*`[left_gid * FAST_LOOKUP_KERN_GLYPHS + right_gid]` or NULL*/
+    uint8_t gids_valid : 1;                     /*0: the glyph ids didn't fit or out of memory*/
+} fast_lookup_t;
+#endif
+
+#if BITMAP_CACHE
+typedef struct _lv_font_fmt_txt_bitmap_cache_entry_t {
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * hash_next;
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * lru_prev;
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * lru_next;
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint32_t size;      /*Size of the entry with the bitmap after it*/
+} bitmap_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int8_t find_kern_pair_value(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
@@ -46,18 +107,42 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+    static inline const fast_lookup_t * get_fast_lookup(const lv_font_fmt_txt_dsc_t * fdsc);
+    static const fast_lookup_t * fast_lookup_add(const lv_font_fmt_txt_dsc_t * fdsc);
+    static fast_lookup_t * fast_lookup_create(const lv_font_fmt_txt_dsc_t * fdsc);
+    static bool fast_lookup_page_has_cmap(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t p);
+    static void fast_lookup_free(fast_lookup_t * fl);
+#endif
+
+#if BITMAP_CACHE
+    static uint8_t * bitmap_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid);
+    static uint8_t * bitmap_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t bitmap_size);
+    static void bitmap_cache_remove(bitmap_cache_entry_t * entry);
+    static void bitmap_cache_drop_all(void);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static LV_THREAD_LOCAL uint32_t rle_rdp;
+    static LV_THREAD_LOCAL const uint8_t * rle_in;
+    static LV_THREAD_LOCAL uint8_t rle_bpp;
+    static LV_THREAD_LOCAL uint8_t rle_prev_v;
+    static LV_THREAD_LOCAL uint8_t rle_cnt;
+    static LV_THREAD_LOCAL rle_state_t rle_state;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_FAST_LOOKUP && LV_USE_REFR_THREADS
+    static pthread_mutex_t fast_lookup_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#if BITMAP_CACHE
+    /*Incremented to make all threads drop their cached bitmaps*/
+    static uint32_t bitmap_cache_generation;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -92,7 +177,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
-        static size_t last_buf_size = 0;
+        static LV_THREAD_LOCAL size_t last_buf_size = 0;
         if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
 
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
@@ -115,6 +200,21 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+
+#if BITMAP_CACHE
+        uint8_t * cached = bitmap_cache_get(fdsc, gid);
+        if(cached) return cached;
+
+        /*Decompress directly into a new cache entry. Use the shared buffer if it can't be cached.*/
+        cached = bitmap_cache_add(fdsc, gid, buf_size);
+        if(cached) {
+            decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], cached, gdsc->box_w, gdsc->box_h,
+                       (uint8_t)fdsc->bpp, prefilter);
+            return cached;
+        }
+#endif
+
         if(last_buf_size < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MALLOC(tmp);
@@ -123,7 +223,6 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
             last_buf_size = buf_size;
         }
 
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
         return LV_GC_ROOT(_lv_font_decompr_buf);
@@ -202,6 +301,90 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+void _lv_font_fmt_txt_cache_free(void)
+{
+#if BITMAP_CACHE
+    bitmap_cache_drop_all();
+    lv_memset_00(&LV_GC_ROOT(_lv_font_bitmap_cache), sizeof(_lv_font_fmt_txt_bitmap_cache_t));
+#endif
+}
+
+void lv_font_fmt_txt_cache_clear(void)
+{
+#if BITMAP_CACHE
+    /*The other threads drop their entries on their next look up*/
+    bitmap_cache_generation++;
+    bitmap_cache_drop_all();
+#endif
+}
+
+void lv_font_fmt_txt_cache_get_stats(lv_font_fmt_txt_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_font_fmt_txt_cache_stats_t));
+#if BITMAP_CACHE
+    _lv_font_fmt_txt_bitmap_cache_t * cache = &LV_GC_ROOT(_lv_font_bitmap_cache);
+    stats->hit_cnt = cache->hit_cnt;
+    stats->miss_cnt = cache->miss_cnt;
+    stats->size = cache->size;
+    stats->entry_cnt = cache->entry_cnt;
+#endif
+}
+
+void lv_font_fmt_txt_cache_reset_stats(void)
+{
+#if BITMAP_CACHE
+    LV_GC_ROOT(_lv_font_bitmap_cache).hit_cnt = 0;
+    LV_GC_ROOT(_lv_font_bitmap_cache).miss_cnt = 0;
+#endif
+}
+
+void _lv_font_fmt_txt_free_fast_lookup(const lv_font_t * font)
+{
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+#if LV_USE_REFR_THREADS
+    pthread_mutex_lock(&fast_lookup_mutex);
+#endif
+
+    fast_lookup_t ** link = &LV_GC_ROOT(_lv_font_fast_lookup_list);
+    while(*link) {
+        fast_lookup_t * fl = *link;
+        if(fl->fdsc == font->dsc) {
+            *link = fl->next;
+            fast_lookup_free(fl);
+            break;
+        }
+        link = &fl->next;
+    }
+
+#if LV_USE_REFR_THREADS
+    pthread_mutex_unlock(&fast_lookup_mutex);
+#endif
+#else
+    LV_UNUSED(font);
+#endif
+}
+
+void _lv_font_fmt_txt_free_all_fast_lookup(void)
+{
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+#if LV_USE_REFR_THREADS
+    pthread_mutex_lock(&fast_lookup_mutex);
+#endif
+
+    fast_lookup_t * fl = LV_GC_ROOT(_lv_font_fast_lookup_list);
+    while(fl) {
+        fast_lookup_t * next = fl->next;
+        fast_lookup_free(fl);
+        fl = next;
+    }
+    FAST_LOOKUP_LIST_SET(NULL);
+
+#if LV_USE_REFR_THREADS
+    pthread_mutex_unlock(&fast_lookup_mutex);
+#endif
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,15 +395,40 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+    if(letter < FAST_LOOKUP_PAGE_CNT * FAST_LOOKUP_PAGE_SIZE) {
+        const fast_lookup_t * fl = get_fast_lookup(fdsc);
+        if(fl && fl->gids_valid) {
+            uint32_t page_id = fl->page_ids[letter / FAST_LOOKUP_PAGE_SIZE];
+            return page_id ? fl->gids[(page_id - 1) * FAST_LOOKUP_PAGE_SIZE + letter % FAST_LOOKUP_PAGE_SIZE] : 0;
+        }
+    }
+#endif
+
+    lv_font_fmt_txt_glyph_cache_t * cache = GLYPH_ID_CACHE(fdsc);
+
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+    if(cache && letter == cache->last_letter) return cache->last_glyph_id;
+
+    uint32_t glyph_id = find_glyph_dsc_id(fdsc, letter);
 
+    /*Update the cache*/
+    if(cache) {
+        cache->last_letter = letter;
+        cache->last_glyph_id = glyph_id;
+    }
+    return glyph_id;
+}
+
+/*Search the glyph id of a letter in the character maps*/
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -251,20 +459,10 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
-        }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
-    }
     return 0;
-
 }
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
@@ -275,37 +473,13 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
-        const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
-        if(kdsc->glyph_ids_size == 0) {
-            /*Use binary search to find the kern value.
-             *The pairs are ordered left_id first, then right_id secondly.*/
-            const uint16_t * g_ids = kdsc->glyph_ids;
-            uint16_t g_id_both = (gid_right << 8) + gid_left; /*Create one number from the ids*/
-            uint16_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
-
-            /*If the `g_id_both` were found get its index from the pointer*/
-            if(kid_p) {
-                lv_uintptr_t ofs = kid_p - g_ids;
-                value = kdsc->values[ofs];
-            }
-        }
-        else if(kdsc->glyph_ids_size == 1) {
-            /*Use binary search to find the kern value.
-             *The pairs are ordered left_id first, then right_id secondly.*/
-            const uint32_t * g_ids = kdsc->glyph_ids;
-            uint32_t g_id_both = (gid_right << 16) + gid_left; /*Create one number from the ids*/
-            uint32_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
-
-            /*If the `g_id_both` were found get its index from the pointer*/
-            if(kid_p) {
-                lv_uintptr_t ofs = kid_p - g_ids;
-                value = kdsc->values[ofs];
-            }
-
-        }
-        else {
-            /*Invalid value*/
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+        if(gid_left < FAST_LOOKUP_KERN_GLYPHS && gid_right < FAST_LOOKUP_KERN_GLYPHS) {
+            const fast_lookup_t * fl = get_fast_lookup(fdsc);
+            if(fl && fl->kern_matrix) return fl->kern_matrix[gid_left * FAST_LOOKUP_KERN_GLYPHS + gid_right];
         }
+#endif
+        value = find_kern_pair_value(fdsc->kern_dsc, gid_left, gid_right);
     }
     else {
         /*Kern classes*/
@@ -323,6 +497,45 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     return value;
 }
 
+/*Search the kern value of two glyphs in the kerning pairs*/
+static int8_t find_kern_pair_value(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t gid_left, uint32_t gid_right)
+{
+    int8_t value = 0;
+
+    if(kdsc->glyph_ids_size == 0) {
+        /*Use binary search to find the kern value.
+         *The pairs are ordered left_id first, then right_id secondly.*/
+        const uint16_t * g_ids = kdsc->glyph_ids;
+        uint16_t g_id_both = (gid_right << 8) + gid_left; /*Create one number from the ids*/
+        uint16_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
+
+        /*If the `g_id_both` were found get its index from the pointer*/
+        if(kid_p) {
+            lv_uintptr_t ofs = kid_p - g_ids;
+            value = kdsc->values[ofs];
+        }
+    }
+    else if(kdsc->glyph_ids_size == 1) {
+        /*Use binary search to find the kern value.
+         *The pairs are ordered left_id first, then right_id secondly.*/
+        const uint32_t * g_ids = kdsc->glyph_ids;
+        uint32_t g_id_both = (gid_right << 16) + gid_left; /*Create one number from the ids*/
+        uint32_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
+
+        /*If the `g_id_both` were found get its index from the pointer*/
+        if(kid_p) {
+            lv_uintptr_t ofs = kid_p - g_ids;
+            value = kdsc->values[ofs];
+        }
+
+    }
+    else {
+        /*Invalid value*/
+    }
+
+    return value;
+}
+
 static int32_t kern_pair_8_compare(const void * ref, const void * element)
 {
     const uint8_t * ref8_p = ref;
@@ -575,6 +788,273 @@ static inline uint8_t rle_next(void)
 }
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_FAST_LOOKUP
+
+/**
+ * Get the lookup tables of a font. Build them if the font is used the first time.
+ * @param fdsc      descriptor of the font
+ * @return          the lookup tables or NULL if there was not enough memory
+ */
+static inline const fast_lookup_t * get_fast_lookup(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    const fast_lookup_t * fl;
+    for(fl = FAST_LOOKUP_LIST_GET(); fl; fl = fl->next) {
+        if(fl->fdsc == fdsc) return fl;
+    }
+
+    return fast_lookup_add(fdsc);
+}
+
+static const fast_lookup_t * fast_lookup_add(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    fast_lookup_t * fl;
+
+#if LV_USE_REFR_THREADS
+    pthread_mutex_lock(&fast_lookup_mutex);
+#endif
+
+    /*Another thread might have built it in the meantime*/
+    for(fl = FAST_LOOKUP_LIST_GET(); fl; fl = fl->next) {
+        if(fl->fdsc == fdsc) break;
+    }
+
+    if(fl == NULL) {
+        fl = fast_lookup_create(fdsc);
+        if(fl) {
+            fl->next = FAST_LOOKUP_LIST_GET();
+            FAST_LOOKUP_LIST_SET(fl);
+        }
+    }
+
+#if LV_USE_REFR_THREADS
+    pthread_mutex_unlock(&fast_lookup_mutex);
+#endif
+
+    return fl;
+}
+
+static fast_lookup_t * fast_lookup_create(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    fast_lookup_t * fl = lv_mem_alloc(sizeof(fast_lookup_t));
+    LV_ASSERT_MALLOC(fl);
+    if(fl == NULL) return NULL;
+    lv_memset_00(fl, sizeof(fast_lookup_t));
+    fl->fdsc = fdsc;
+
+    /*Allocate the glyph ids for the pages where a character map has code points at once*/
+    uint32_t page_max = 0;
+    uint32_t p;
+    for(p = 0; p < FAST_LOOKUP_PAGE_CNT; p++) {
+        if(fast_lookup_page_has_cmap(fdsc, p)) page_max++;
+    }
+
+    fl->gids_valid = 1;
+    if(page_max) {
+        fl->gids = lv_mem_alloc(page_max * FAST_LOOKUP_PAGE_SIZE * sizeof(uint16_t));
+        if(fl->gids == NULL) fl->gids_valid = 0;
+    }
+
+    /*Fill only the pages with glyphs*/
+    uint32_t page_cnt = 0;
+    for(p = 0; p < FAST_LOOKUP_PAGE_CNT && fl->gids_valid; p++) {
+        if(!fast_lookup_page_has_cmap(fdsc, p)) continue;
+
+        uint16_t * page = &fl->gids[page_cnt * FAST_LOOKUP_PAGE_SIZE];
+        uint32_t page_first = p * FAST_LOOKUP_PAGE_SIZE;
+        bool has_glyph = false;
+        uint32_t c;
+        for(c = 0; c < FAST_LOOKUP_PAGE_SIZE; c++) {
+            uint32_t gid = find_glyph_dsc_id(fdsc, page_first + c);
+            if(gid > UINT16_MAX) fl->gids_valid = 0;
+            if(gid) has_glyph = true;
+            page[c] = gid;
+        }
+        if(!has_glyph) continue;
+
+        page_cnt++;
+        fl->page_ids[p] = page_cnt;
+    }
+
+    /*Give back the space of the pages without glyphs*/
+    if(fl->gids_valid && page_cnt < page_max) {
+        if(page_cnt == 0) {
+            lv_mem_free(fl->gids);
+            fl->gids = NULL;
+        }
+        else {
+            uint16_t * gids_new = lv_mem_realloc(fl->gids, page_cnt * FAST_LOOKUP_PAGE_SIZE * sizeof(uint16_t));
+            if(gids_new) fl->gids = gids_new;
+        }
+    }
+
+    /*Search the glyph ids the slow way if the table is not complete*/
+    if(!fl->gids_valid) {
+        LV_LOG_WARN("couldn't build the glyph id table of a font");
+        if(fl->gids) lv_mem_free(fl->gids);
+        fl->gids = NULL;
+    }
+
+    /*The kern classes are already a matrix*/
+    const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+    if(kdsc && fdsc->kern_classes == 0 && kdsc->pair_cnt > 0) {
+        fl->kern_matrix = lv_mem_alloc(FAST_LOOKUP_KERN_GLYPHS * FAST_LOOKUP_KERN_GLYPHS);
+        if(fl->kern_matrix) {
+            uint32_t left;
+            uint32_t right;
+            for(left = 0; left < FAST_LOOKUP_KERN_GLYPHS; left++) {
+                for(right = 0; right < FAST_LOOKUP_KERN_GLYPHS; right++) {
+                    fl->kern_matrix[left * FAST_LOOKUP_KERN_GLYPHS + right] = find_kern_pair_value(kdsc, left, right);
+                }
+            }
+        }
+    }
+
+    return fl;
+}
+
+/**
+ * Tell if a character map of a font has code points on a page of the glyph id table
+ * @param fdsc      descriptor of the font
+ * @param p         index of the page
+ * @return          true: the page needs to be filled
+ */
+static bool fast_lookup_page_has_cmap(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t p)
+{
+    uint32_t page_first = p * FAST_LOOKUP_PAGE_SIZE;
+    uint32_t page_last = page_first + FAST_LOOKUP_PAGE_SIZE - 1;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        uint32_t range_last = fdsc->cmaps[i].range_start + fdsc->cmaps[i].range_length - 1;
+        if(fdsc->cmaps[i].range_start <= page_last && range_last >= page_first) return true;
+    }
+    return false;
+}
+
+static void fast_lookup_free(fast_lookup_t * fl)
+{
+    if(fl->gids) lv_mem_free(fl->gids);
+    if(fl->kern_matrix) lv_mem_free(fl->kern_matrix);
+    lv_mem_free(fl);
+}
+
+#endif /*LV_FONT_FMT_TXT_FAST_LOOKUP*/
+
+#if BITMAP_CACHE
+
+static inline uint32_t bitmap_cache_hash(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid)
+{
+    return (gid ^ (uint32_t)((lv_uintptr_t)fdsc >> 4)) & (_LV_FONT_FMT_TXT_BITMAP_CACHE_BUCKETS - 1);
+}
+
+/**
+ * Find a glyph's decompressed bitmap in the cache and mark it as the most recently used
+ * @param fdsc      descriptor of the font
+ * @param gid       id of the glyph
+ * @return          the bitmap or NULL if not cached
+ */
+static uint8_t * bitmap_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid)
+{
+    _lv_font_fmt_txt_bitmap_cache_t * cache = &LV_GC_ROOT(_lv_font_bitmap_cache);
+    if(cache->generation != bitmap_cache_generation) {
+        bitmap_cache_drop_all();
+        cache->generation = bitmap_cache_generation;
+    }
+
+    bitmap_cache_entry_t * entry = cache->buckets[bitmap_cache_hash(fdsc, gid)];
+    while(entry) {
+        if(entry->gid == gid && entry->fdsc == fdsc) break;
+        entry = entry->hash_next;
+    }
+
+    if(entry == NULL) {
+        cache->miss_cnt++;
+        return NULL;
+    }
+
+    cache->hit_cnt++;
+
+    /*Move to the front of the LRU list*/
+    if(entry != cache->lru_first) {
+        entry->lru_prev->lru_next = entry->lru_next;
+        if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+        else cache->lru_last = entry->lru_prev;
+
+        entry->lru_prev = NULL;
+        entry->lru_next = cache->lru_first;
+        cache->lru_first->lru_prev = entry;
+        cache->lru_first = entry;
+    }
+
+    return (uint8_t *)(entry + 1);
+}
+
+/**
+ * Allocate a new entry for a glyph. Drop the least recently used entries if the cache would be too large.
+ * @param fdsc          descriptor of the font
+ * @param gid           id of the glyph
+ * @param bitmap_size   size of the decompressed bitmap in bytes
+ * @return              buffer to decompress the bitmap into or NULL if it can't be cached
+ */
+static uint8_t * bitmap_cache_add(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t bitmap_size)
+{
+    _lv_font_fmt_txt_bitmap_cache_t * cache = &LV_GC_ROOT(_lv_font_bitmap_cache);
+    uint32_t size = sizeof(bitmap_cache_entry_t) + bitmap_size;
+    if(size > LV_FONT_COMPRESSED_CACHE_SIZE) return NULL;
+
+    while(cache->size + size > LV_FONT_COMPRESSED_CACHE_SIZE) {
+        bitmap_cache_remove(cache->lru_last);
+    }
+
+    bitmap_cache_entry_t * entry = lv_mem_alloc(size);
+    if(entry == NULL) return NULL;
+
+    uint32_t h = bitmap_cache_hash(fdsc, gid);
+    entry->fdsc = fdsc;
+    entry->gid = gid;
+    entry->size = size;
+    entry->hash_next = cache->buckets[h];
+    cache->buckets[h] = entry;
+
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_first;
+    if(cache->lru_first) cache->lru_first->lru_prev = entry;
+    else cache->lru_last = entry;
+    cache->lru_first = entry;
+
+    cache->size += size;
+    cache->entry_cnt++;
+
+    return (uint8_t *)(entry + 1);
+}
+
+static void bitmap_cache_remove(bitmap_cache_entry_t * entry)
+{
+    _lv_font_fmt_txt_bitmap_cache_t * cache = &LV_GC_ROOT(_lv_font_bitmap_cache);
+
+    bitmap_cache_entry_t ** link = &cache->buckets[bitmap_cache_hash(entry->fdsc, entry->gid)];
+    while(*link != entry) link = &(*link)->hash_next;
+    *link = entry->hash_next;
+
+    if(entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else cache->lru_first = entry->lru_next;
+    if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else cache->lru_last = entry->lru_prev;
+
+    cache->size -= entry->size;
+    cache->entry_cnt--;
+    lv_mem_free(entry);
+}
+
+static void bitmap_cache_drop_all(void)
+{
+    _lv_font_fmt_txt_bitmap_cache_t * cache = &LV_GC_ROOT(_lv_font_bitmap_cache);
+    while(cache->lru_last) {
+        bitmap_cache_remove(cache->lru_last);
+    }
+}
+
+#endif /*BITMAP_CACHE*/
+
 /** Code Comparator.
  *
  *  Compares the value of both input arguments.
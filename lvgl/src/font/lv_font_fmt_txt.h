@@ -21,6 +21,8 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Number of hash buckets of the decompressed glyph bitmap cache. Must be a power of 2.*/
+#define _LV_FONT_FMT_TXT_BITMAP_CACHE_BUCKETS   32
 
 /**********************
  *      TYPEDEFS
@@ -197,6 +199,29 @@ typedef struct {
     lv_font_fmt_txt_glyph_cache_t * cache;
 } lv_font_fmt_txt_dsc_t;
 
+struct _lv_font_fmt_txt_bitmap_cache_entry_t;
+struct _lv_font_fmt_txt_fast_lookup_t;
+
+/*LRU cache of decompressed glyph bitmaps of compressed fonts. Each rendering thread has its own.*/
+typedef struct {
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * buckets[_LV_FONT_FMT_TXT_BITMAP_CACHE_BUCKETS];
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * lru_first;   /*Most recently used*/
+    struct _lv_font_fmt_txt_bitmap_cache_entry_t * lru_last;    /*Least recently used, dropped first*/
+    uint32_t size;              /*Bytes allocated for the entries*/
+    uint32_t entry_cnt;
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+    uint32_t generation;        /*Dropped if it differs from the generation set by `lv_font_fmt_txt_cache_clear()`*/
+} _lv_font_fmt_txt_bitmap_cache_t;
+
+/*Statistics of the decompressed glyph bitmap cache*/
+typedef struct {
+    uint32_t hit_cnt;           /*Number of glyphs found in the cache*/
+    uint32_t miss_cnt;          /*Number of glyphs decompressed*/
+    uint32_t size;              /*Bytes used by the cached glyphs*/
+    uint32_t entry_cnt;         /*Number of cached glyphs*/
+} lv_font_fmt_txt_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -225,6 +250,41 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Free the decompressed glyph bitmaps cached by the calling thread.
+ * Called by `lv_deinit()` and by the rendering threads when they stop.
+ */
+void _lv_font_fmt_txt_cache_free(void);
+
+/**
+ * Free the glyph id and kerning lookup tables of a font built with `LV_FONT_FMT_TXT_FAST_LOOKUP`.
+ * Needs to be called before freeing a font.
+ * @param font pointer to a font
+ */
+void _lv_font_fmt_txt_free_fast_lookup(const lv_font_t * font);
+
+/**
+ * Free the glyph id and kerning lookup tables of all fonts. Called by `lv_deinit()`.
+ */
+void _lv_font_fmt_txt_free_all_fast_lookup(void);
+
+/**
+ * Drop the cached glyph bitmaps of the compressed fonts in all threads.
+ * Should be called before freeing a compressed font.
+ */
+void lv_font_fmt_txt_cache_clear(void);
+
+/**
+ * Get the statistics of the decompressed glyph bitmap cache of the calling thread.
+ * @param stats store the statistics here. All zero if `LV_FONT_COMPRESSED_CACHE_SIZE` is 0.
+ */
+void lv_font_fmt_txt_cache_get_stats(lv_font_fmt_txt_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters of the calling thread's glyph bitmap cache.
+ */
+void lv_font_fmt_txt_cache_reset_stats(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -187,6 +187,14 @@ typedef struct _lv_disp_t {
     uint16_t inv_p;
     int32_t inv_en_cnt;
 
+#if LV_INV_TILE_SIZE
+    /** Bit per tile, row by row, of the invalidated areas if there were more than `LV_INV_BUF_SIZE`*/
+    uint32_t * inv_tiles;
+    uint16_t inv_tile_cols;
+    uint16_t inv_tile_rows;
+    uint8_t inv_tiles_act : 1;      /**< 1: The invalidated areas are marked in `inv_tiles` instead of `inv_areas`*/
+#endif
+
     /** Double buffer sync areas */
     lv_ll_t sync_areas;
 
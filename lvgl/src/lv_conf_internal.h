@@ -157,6 +157,17 @@
         #endif
     #endif
 
+    /*Size of the part of `LV_MEM_SIZE` reserved for small allocations (objects, animations, timers, linked list nodes, etc).
+     *They are served from free lists of a few size classes which is faster and doesn't fragment the rest of the memory.
+     *It's used in 1 kB pages. 0: disable*/
+    #ifndef LV_MEM_SLAB_SIZE
+        #ifdef CONFIG_LV_MEM_SLAB_SIZE
+            #define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+        #else
+            #define LV_MEM_SLAB_SIZE 0     /*[bytes]*/
+        #endif
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #ifndef LV_MEM_CUSTOM_INCLUDE
         #ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -220,6 +231,17 @@
     #endif
 #endif
 
+/*If more areas are invalidated in a refresh period than what fits to the display's list (LV_INV_BUF_SIZE)
+ *mark them on a grid of this size tiles and redraw the covering rectangles instead of the whole screen.
+ *The grid needs (hor. res / size / 8) * (ver. res / size) bytes. 0: redraw the whole screen*/
+#ifndef LV_INV_TILE_SIZE
+    #ifdef CONFIG_LV_INV_TILE_SIZE
+        #define LV_INV_TILE_SIZE CONFIG_LV_INV_TILE_SIZE
+    #else
+        #define LV_INV_TILE_SIZE 16             /*[px]*/
+    #endif
+#endif
+
 /*Input device read period in milliseconds*/
 #ifndef LV_INDEV_DEF_READ_PERIOD
     #ifdef CONFIG_LV_INDEV_DEF_READ_PERIOD
@@ -229,6 +251,16 @@
     #endif
 #endif
 
+/*Put the children of objects with at least this many children on a grid by their position
+ *to check only the children around the point when searching the pressed object. 0: check all children*/
+#ifndef LV_INDEV_HIT_GRID_MIN
+    #ifdef CONFIG_LV_INDEV_HIT_GRID_MIN
+        #define LV_INDEV_HIT_GRID_MIN CONFIG_LV_INDEV_HIT_GRID_MIN
+    #else
+        #define LV_INDEV_HIT_GRID_MIN 0
+    #endif
+#endif
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #ifndef LV_TICK_CUSTOM
@@ -293,7 +325,8 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost. The corners of several smaller shadows can be cached in it
+    *and the least recently used ones are dropped first.*/
     #ifndef LV_SHADOW_CACHE_SIZE
         #ifdef CONFIG_LV_SHADOW_CACHE_SIZE
             #define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -313,6 +346,18 @@
             #define LV_CIRCLE_CACHE_SIZE 4
         #endif
     #endif
+
+    /* Size of the cache of pre-rendered rounded corners in bytes.
+    * The 4 corners of a radius are saved as a (2 * radius)^2 bytes opacity map
+    * to draw rounded rectangles without evaluating a mask on every line (the most recently used radiuses are saved)
+    * 0: to disable caching */
+    #ifndef LV_CORNER_CACHE_SIZE
+        #ifdef CONFIG_LV_CORNER_CACHE_SIZE
+            #define LV_CORNER_CACHE_SIZE CONFIG_LV_CORNER_CACHE_SIZE
+        #else
+            #define LV_CORNER_CACHE_SIZE 0
+        #endif
+    #endif
 #endif /*LV_DRAW_COMPLEX*/
 
 /**
@@ -412,6 +457,62 @@
     #endif
 #endif
 
+/*Number of resolved style properties to cache (e.g. 4096) to avoid searching the styles of the objects on every read.
+ *The properties of all objects share the cache. It should be large enough for the properties of the objects on the screen.
+ *Every property needs 12 + sizeof(lv_style_value_t) bytes (16 on 32 bit systems), on every rendering thread. 0: no caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Render the invalidated areas in horizontal bands on several threads at once.
+ *Requires POSIX threads and the software renderer (other draw units render on one thread).
+ *The draw events (e.g. `LV_EVENT_DRAW_PART_BEGIN`) are sent from the rendering threads,
+ *so their callbacks shouldn't write shared data.*/
+#ifndef LV_USE_REFR_THREADS
+    #ifdef CONFIG_LV_USE_REFR_THREADS
+        #define LV_USE_REFR_THREADS CONFIG_LV_USE_REFR_THREADS
+    #else
+        #define LV_USE_REFR_THREADS 0
+    #endif
+#endif
+#if LV_USE_REFR_THREADS
+    /*Number of rendering threads, including the one calling `lv_timer_handler()`*/
+    #ifndef LV_REFR_THREAD_CNT
+        #ifdef CONFIG_LV_REFR_THREAD_CNT
+            #define LV_REFR_THREAD_CNT CONFIG_LV_REFR_THREAD_CNT
+        #else
+            #define LV_REFR_THREAD_CNT 4
+        #endif
+    #endif
+
+    /*Don't split an area into bands lower than this many rows (starting threads has a cost too)*/
+    #ifndef LV_REFR_THREAD_MIN_BAND
+        #ifdef CONFIG_LV_REFR_THREAD_MIN_BAND
+            #define LV_REFR_THREAD_MIN_BAND CONFIG_LV_REFR_THREAD_MIN_BAND
+        #else
+            #define LV_REFR_THREAD_MIN_BAND 16
+        #endif
+    #endif
+#endif
+
+/*Blend with SSE2/AVX2 (x86) or NEON (ARM) instructions if the CPU supports them (checked at runtime on x86).
+ *Works with 32 bit and not swapped 16 bit colors and GCC compatible compilers. The result is the same as without it.*/
+#ifndef LV_DRAW_SW_SIMD
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_DRAW_SW_SIMD
+            #define LV_DRAW_SW_SIMD CONFIG_LV_DRAW_SW_SIMD
+        #else
+            #define LV_DRAW_SW_SIMD 0
+        #endif
+    #else
+        #define LV_DRAW_SW_SIMD 1
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -1220,6 +1321,17 @@
     #endif
 #endif
 
+/*Build direct lookup tables for the glyph ids of the Basic Multilingual Plane (0.5 kB per 256 code points with glyphs)
+ *and for the kerning pairs of the first 128 glyphs (16 kB, only for fonts with kerning pairs) when a font is first used.
+ *Speeds up getting the glyphs of large and sparse fonts, e.g. CJK fonts.*/
+#ifndef LV_FONT_FMT_TXT_FAST_LOOKUP
+    #ifdef CONFIG_LV_FONT_FMT_TXT_FAST_LOOKUP
+        #define LV_FONT_FMT_TXT_FAST_LOOKUP CONFIG_LV_FONT_FMT_TXT_FAST_LOOKUP
+    #else
+        #define LV_FONT_FMT_TXT_FAST_LOOKUP 0
+    #endif
+#endif
+
 /*Enables/disables support for compressed fonts.*/
 #ifndef LV_USE_FONT_COMPRESSED
     #ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -1228,6 +1340,17 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of the decompressed glyph bitmaps in bytes (per rendering thread).
+     *The least recently used glyphs are dropped if it's full. 0: decompress the glyph on every draw*/
+    #ifndef LV_FONT_COMPRESSED_CACHE_SIZE
+        #ifdef CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+            #define LV_FONT_COMPRESSED_CACHE_SIZE CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+        #else
+            #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
@@ -1497,6 +1620,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+                #define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+            #else
+                #define LV_LABEL_LAYOUT_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LAYOUT_CACHE 1   /*Store the lines of the text in labels to not measure them again on every redraw*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -21,7 +21,10 @@ extern "C" {
 #include "lv_types.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
+#include "../draw/sw/lv_draw_sw_gradient.h"
+#include "../font/lv_font_fmt_txt.h"
 #include "../core/lv_obj_pos.h"
+#include "../core/lv_obj.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +35,12 @@ extern "C" {
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+#    define LV_OBJ_STYLE_CACHE          1
+#else
+#    define LV_OBJ_STYLE_CACHE          0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -40,6 +49,7 @@ extern "C" {
 #define LV_DISPATCH10(f, t, n)
 #define LV_DISPATCH11(f, t, n)          LV_DISPATCH(f, t, n)
 
+/*The roots used while rendering are `LV_THREAD_LOCAL`*/
 #define LV_ITERATE_ROOTS(f)                                                                            \
     LV_DISPATCH(f, lv_ll_t, _lv_timer_ll) /*Linked list to store the lv_timers*/                       \
     LV_DISPATCH(f, lv_ll_t, _lv_disp_ll)  /*Linked list of display device*/                            \
@@ -53,13 +63,18 @@ extern "C" {
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
-    LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH(f, lv_timer_t **, _lv_timer_queue) /*The not paused timers in a binary heap*/          \
+    LV_DISPATCH(f, LV_THREAD_LOCAL lv_mem_buf_pool_t , lv_mem_buf)                                     \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_draw_mask_corner_cache_t , _lv_corner_cache, LV_DRAW_COMPLEX, 1)            \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
-    LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
-    LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)    \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_font_fmt_txt_bitmap_cache_t, _lv_font_bitmap_cache, LV_USE_FONT_COMPRESSED, 1) \
+    LV_DISPATCH_COND(f, struct _lv_font_fmt_txt_fast_lookup_t *, _lv_font_fast_lookup_list, LV_FONT_FMT_TXT_FAST_LOOKUP, 1) \
+    LV_DISPATCH(f, LV_THREAD_LOCAL _lv_grad_cache_t , _lv_grad_cache)                                  \
+    LV_DISPATCH_COND(f, LV_THREAD_LOCAL _lv_obj_style_cache_t , _lv_obj_style_cache, LV_OBJ_STYLE_CACHE, 1) \
     LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
@@ -69,6 +84,9 @@ extern "C" {
 #if LV_MEM_CUSTOM != 1
 #error "GC requires CUSTOM_MEM"
 #endif /*LV_MEM_CUSTOM*/
+#if LV_USE_REFR_THREADS
+#error "GC can't be used with LV_USE_REFR_THREADS"
+#endif /*LV_USE_REFR_THREADS*/
 #include LV_GC_INCLUDE
 #else  /*LV_ENABLE_GC*/
 #define LV_GC_ROOT(x) x
@@ -21,6 +21,10 @@
     #include LV_MEM_POOL_INCLUDE
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_USE_REFR_THREADS
+    #include <pthread.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -39,15 +43,60 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#if LV_MEM_BUF_MAX_NUM > 255
+    #error "LV_MEM_BUF_MAX_NUM can be at most 255"
+#endif
+
+/*Small allocations are served from pages of slots of a few size classes*/
+#define SLAB_PAGE_SIZE     1024
+#define SLAB_CLASS_CNT     14
+#define SLAB_SIZE_MAX      192
+#define SLAB_NONE          0xFFFF
+
+#if LV_MEM_CUSTOM == 0
+    #define SLAB               (LV_MEM_SLAB_SIZE >= SLAB_PAGE_SIZE)
+    #define SLAB_PAGE_CNT      (LV_MEM_SLAB_SIZE / SLAB_PAGE_SIZE)
+    #define SLAB_PAGE_ID(p)    ((uint32_t)(((uint8_t *)(p) - slab_mem) / SLAB_PAGE_SIZE))
+#else
+    #define SLAB               0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if SLAB
+typedef struct {
+    void * free_slot;   /*The first free slot. The free slots store the address of the next free slot.*/
+    uint16_t next;      /*Next page in the list of the partially used pages of the class or of the free pages*/
+    uint16_t prev;
+    uint16_t used_cnt;
+    uint8_t class_id;
+} slab_page_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+    #if SLAB || LV_MEM_ADD_JUNK
+        static size_t block_size(void * data);
+    #endif
+#endif
+static uint32_t buf_bucket_ceil(uint32_t size);
+static uint32_t buf_hash(const void * p);
+static bool buf_in_arena(lv_mem_buf_pool_t * pool, const void * p);
+static uint32_t buf_pop_free(lv_mem_buf_pool_t * pool, uint32_t bucket);
+static bool buf_create(lv_mem_buf_pool_t * pool, uint32_t id, uint32_t size);
+static void buf_drop(lv_mem_buf_pool_t * pool, uint32_t id);
+#if SLAB
+    static void slab_init(void);
+    static void * slab_alloc(size_t size);
+    static size_t slab_free(void * data);
+    static bool slab_contains(const void * data);
+    static bool slab_check(void);
+    static void slab_list_add(uint16_t * head, uint16_t id);
+    static void slab_list_remove(uint16_t * head, uint16_t id);
 #endif
 
 /**********************
@@ -57,6 +106,20 @@
     static lv_tlsf_t tlsf;
     static uint32_t cur_used;
     static uint32_t max_used;
+#if LV_USE_REFR_THREADS
+    static pthread_mutex_t tlsf_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#endif
+
+#if SLAB
+    static uint8_t * slab_mem;
+    static slab_page_t slab_pages[SLAB_PAGE_CNT];
+    static uint16_t slab_partial[SLAB_CLASS_CNT];   /*Pages with free slots for each class*/
+    static uint16_t slab_free_page;                 /*Pages not used by any class*/
+    static uint8_t slab_class_lut[SLAB_SIZE_MAX / 8 + 1];   /*Size in 8 bytes units -> class*/
+    static uint32_t slab_used;
+    static uint32_t slab_fallback_cnt;
+    static const uint16_t slab_class_size[SLAB_CLASS_CNT] = {8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192};
 #endif
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
@@ -70,6 +133,15 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
     #define MEM_TRACE(...)
 #endif
 
+/*The rendering threads allocate too, so TLSF is protected by a mutex*/
+#if LV_MEM_CUSTOM == 0 && LV_USE_REFR_THREADS
+    #define MEM_LOCK()   pthread_mutex_lock(&tlsf_mutex)
+    #define MEM_UNLOCK() pthread_mutex_unlock(&tlsf_mutex)
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 #define COPY32 *d32 = *s32; d32++; s32++;
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
@@ -98,6 +170,10 @@ void lv_mem_init(void)
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
+
+#if SLAB
+    slab_init();
+#endif
 #endif
 
 #if LV_MEM_ADD_JUNK
@@ -131,7 +207,18 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+#if SLAB
+    void * alloc = size <= SLAB_SIZE_MAX ? slab_alloc(size) : NULL;
+    if(alloc == NULL) alloc = lv_tlsf_malloc(tlsf, size);
+#else
     void * alloc = lv_tlsf_malloc(tlsf, size);
+#endif
+    if(alloc) {
+        cur_used += size;
+        max_used = LV_MAX(cur_used, max_used);
+    }
+    MEM_UNLOCK();
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -153,10 +240,6 @@ void * lv_mem_alloc(size_t size)
 #endif
 
     if(alloc) {
-#if LV_MEM_CUSTOM == 0
-        cur_used += size;
-        max_used = LV_MAX(cur_used, max_used);
-#endif
         MEM_TRACE("allocated at %p", alloc);
     }
     return alloc;
@@ -174,11 +257,17 @@ void lv_mem_free(void * data)
 
 #if LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
-    lv_memset(data, 0xbb, lv_tlsf_block_size(data));
+    lv_memset(data, 0xbb, block_size(data));
 #  endif
+    MEM_LOCK();
+#if SLAB
+    size_t size = slab_contains(data) ? slab_free(data) : lv_tlsf_free(tlsf, data);
+#else
     size_t size = lv_tlsf_free(tlsf, data);
+#endif
     if(cur_used > size) cur_used -= size;
     else cur_used = 0;
+    MEM_UNLOCK();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
@@ -202,8 +291,31 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
+#if SLAB
+    /*Let new small memories come from the slab too*/
+    if(data_p == NULL) return lv_mem_alloc(new_size);
+
+    /*Slots can't grow so move the data to a larger slot or to TLSF*/
+    if(slab_contains(data_p)) {
+        size_t old_size = block_size(data_p);
+        if(new_size <= old_size) return data_p;
+
+        void * new_p = lv_mem_alloc(new_size);
+        if(new_p == NULL) {
+            LV_LOG_ERROR("couldn't allocate memory");
+            return NULL;
+        }
+        lv_memcpy(new_p, data_p, old_size);
+        lv_mem_free(data_p);
+        MEM_TRACE("allocated at %p", new_p);
+        return new_p;
+    }
+#endif
+
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    MEM_UNLOCK();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -224,15 +336,29 @@ lv_res_t lv_mem_test(void)
     }
 
 #if LV_MEM_CUSTOM == 0
-    if(lv_tlsf_check(tlsf)) {
+    MEM_LOCK();
+    int tlsf_res = lv_tlsf_check(tlsf);
+    int pool_res = lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf));
+#if SLAB
+    bool slab_res = slab_check();
+#endif
+    MEM_UNLOCK();
+    if(tlsf_res) {
         LV_LOG_WARN("failed");
         return LV_RES_INV;
     }
 
-    if(lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf))) {
+    if(pool_res) {
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
+
+#if SLAB
+    if(!slab_res) {
+        LV_LOG_WARN("slab failed");
+        return LV_RES_INV;
+    }
+#endif
 #endif
     MEM_TRACE("passed");
     return LV_RES_OK;
@@ -250,10 +376,23 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    MEM_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    mon_p->max_used = max_used;
+#if SLAB
+    if(slab_mem) {
+        /*Count the used slots instead of the slab's TLSF block*/
+        mon_p->used_cnt--;
+        uint32_t i;
+        for(i = 0; i < SLAB_PAGE_CNT; i++) mon_p->used_cnt += slab_pages[i].used_cnt;
+        mon_p->slab_size = SLAB_PAGE_CNT * SLAB_PAGE_SIZE;
+        mon_p->slab_used = slab_used;
+    }
+    mon_p->slab_fallback_cnt = slab_fallback_cnt;
+#endif
+    MEM_UNLOCK();
 
     mon_p->total_size = LV_MEM_SIZE;
-    mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
         mon_p->frag_pct = 100 - mon_p->frag_pct;
@@ -262,7 +401,9 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 
-    mon_p->max_used = max_used;
+    /*The free slots are available only for small allocations so they don't count in the fragmentation*/
+    mon_p->free_size += mon_p->slab_size - mon_p->slab_used;
+    mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
 
     MEM_TRACE("finished");
 #endif
@@ -278,50 +419,54 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
-    /*Try to find a free buffer with suitable size*/
-    int8_t i_guess = -1;
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0 && LV_GC_ROOT(lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(lv_mem_buf[i]).p;
-            }
-            else if(i_guess < 0) {
-                i_guess = i;
-            }
-            /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(lv_mem_buf[i]).size < LV_GC_ROOT(lv_mem_buf[i_guess]).size) {
-                i_guess = i;
-            }
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT(lv_mem_buf);
+    uint32_t bucket = buf_bucket_ceil(size);
+
+    /*Use the smallest not used buffer which is large enough*/
+    uint32_t mask = pool->free_mask >> (bucket - LV_MEM_BUF_BUCKET_MIN);
+    if(mask) {
+        while((mask & 1) == 0) {
+            mask >>= 1;
+            bucket++;
         }
+        uint32_t id = buf_pop_free(pool, bucket);
+        MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", id, pool->buf[id].p);
+        return pool->buf[id].p;
     }
 
-    if(i_guess >= 0) {
-        LV_GC_ROOT(lv_mem_buf[i_guess]).used = 1;
-        MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", i_guess,
-                  LV_GC_ROOT(lv_mem_buf[i_guess]).p);
-        return LV_GC_ROOT(lv_mem_buf[i_guess]).p;
+    /*Use an empty entry or drop the memory of the smallest not used buffer*/
+    uint32_t id;
+    if(pool->empty_head) {
+        id = pool->empty_head - 1;
+        pool->empty_head = pool->buf[id].next;
+    }
+    else if(pool->buf_cnt < LV_MEM_BUF_MAX_NUM) {
+        id = pool->buf_cnt;
+        pool->buf_cnt++;
+    }
+    else if(pool->free_mask) {
+        uint32_t drop_bucket = LV_MEM_BUF_BUCKET_MIN;
+        while((pool->free_mask & (1UL << (drop_bucket - LV_MEM_BUF_BUCKET_MIN))) == 0) drop_bucket++;
+        id = buf_pop_free(pool, drop_bucket);
+        buf_drop(pool, id);
+    }
+    else {
+        LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
+        LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
+        return NULL;
     }
 
-    /*Reallocate a free buffer*/
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
-            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
-            LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
-            if(buf == NULL) return NULL;
-
-            LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
-            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
-            return LV_GC_ROOT(lv_mem_buf[i]).p;
-        }
+    if(!buf_create(pool, id, size)) {
+        pool->buf[id].next = pool->empty_head;
+        pool->empty_head = id + 1;
+        /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+        LV_ASSERT_MSG(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
+        return NULL;
     }
 
-    LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
-    LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
-    return NULL;
+    pool->buf[id].used = 1;
+    MEM_TRACE("allocated (buffer id: %d, address: %p)", id, pool->buf[id].p);
+    return pool->buf[id].p;
 }
 
 /**
@@ -332,29 +477,46 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
+    /*Releasing NULL was accepted as the empty entries had NULL too*/
+    if(p == NULL) return;
+
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT(lv_mem_buf);
+    uint32_t id1 = pool->hash_head[buf_hash(p)];
+    while(id1) {
+        lv_mem_buf_t * buf = &pool->buf[id1 - 1];
+        if(buf->p == p) {
+            if(buf->used) {
+                uint32_t i = buf->bucket - LV_MEM_BUF_BUCKET_MIN;
+                buf->used = 0;
+                buf->next = pool->free_head[i];
+                pool->free_head[i] = id1;
+                pool->free_mask |= 1UL << i;
+            }
             return;
         }
+        id1 = buf->hash_next;
     }
 
     LV_LOG_ERROR("p is not a known buffer");
 }
 
 /**
- * Free all memory buffers
+ * Free all memory buffers and the arena. The next arena will be as large as the buffers were in total.
  */
 void lv_mem_buf_free_all(void)
 {
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
-            LV_GC_ROOT(lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(lv_mem_buf[i]).size = 0;
-        }
-    }
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT(lv_mem_buf);
+    uint32_t i;
+    for(i = 0; i < pool->buf_cnt; i++) {
+        if(pool->buf[i].p && !buf_in_arena(pool, pool->buf[i].p)) lv_mem_free(pool->buf[i].p);
+    }
+    if(pool->arena) lv_mem_free(pool->arena);
+
+    uint32_t arena_size = pool->frame_size;
+    uint32_t frame_size_max = pool->frame_size_max;
+    lv_memset_00(pool, sizeof(lv_mem_buf_pool_t));
+    pool->arena_size = arena_size;
+    pool->frame_size_max = frame_size_max;
 }
 
 #if LV_MEMCPY_MEMSET_STD == 0
@@ -562,4 +724,275 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+
+#if SLAB || LV_MEM_ADD_JUNK
+/**
+ * Get the size of an allocated memory which can be really used
+ * @param data pointer to an allocated memory
+ * @return the size of the block
+ */
+static size_t block_size(void * data)
+{
+#if SLAB
+    if(slab_contains(data)) return slab_class_size[slab_pages[SLAB_PAGE_ID(data)].class_id];
 #endif
+    return lv_tlsf_block_size(data);
+}
+#endif
+#endif
+
+#if SLAB
+static void slab_init(void)
+{
+    slab_used = 0;
+    slab_fallback_cnt = 0;
+    slab_free_page = SLAB_NONE;
+    uint32_t i;
+    for(i = 0; i < SLAB_CLASS_CNT; i++) slab_partial[i] = SLAB_NONE;
+
+    uint32_t c = 0;
+    for(i = 0; i < sizeof(slab_class_lut); i++) {
+        while(slab_class_size[c] < i * 8) c++;
+        slab_class_lut[i] = c;
+    }
+
+    slab_mem = lv_tlsf_malloc(tlsf, SLAB_PAGE_CNT * SLAB_PAGE_SIZE);
+    if(slab_mem == NULL) {
+        LV_LOG_WARN("couldn't allocate the slab. Increase LV_MEM_SIZE or decrease LV_MEM_SLAB_SIZE");
+        return;
+    }
+
+    /*Add the pages in reverse order to use the first pages first*/
+    for(i = SLAB_PAGE_CNT; i > 0; i--) {
+        slab_pages[i - 1].used_cnt = 0;
+        slab_pages[i - 1].free_slot = NULL;
+        slab_list_add(&slab_free_page, i - 1);
+    }
+}
+
+/**
+ * Get a free slot for a small allocation. `MEM_LOCK` should be held.
+ * @param size size of the memory to allocate in bytes (<= `SLAB_SIZE_MAX`)
+ * @return pointer to the slot or NULL if the slab is full
+ */
+static void * slab_alloc(size_t size)
+{
+    uint32_t c = slab_class_lut[(size + 7) >> 3];
+    uint32_t slot_size = slab_class_size[c];
+    uint16_t id = slab_partial[c];
+    slab_page_t * page;
+    if(id == SLAB_NONE) {
+        id = slab_free_page;
+        if(id == SLAB_NONE) {
+            slab_fallback_cnt++;
+            return NULL;
+        }
+
+        /*Cut a free page to slots of this class*/
+        slab_list_remove(&slab_free_page, id);
+        slab_list_add(&slab_partial[c], id);
+        page = &slab_pages[id];
+        page->class_id = c;
+
+        uint8_t * slot = slab_mem + id * SLAB_PAGE_SIZE;
+        uint8_t * slot_last = slot + (SLAB_PAGE_SIZE / slot_size - 1) * slot_size;
+        page->free_slot = slot;
+        while(slot < slot_last) {
+            *(void **)slot = slot + slot_size;
+            slot += slot_size;
+        }
+        *(void **)slot_last = NULL;
+    }
+
+    page = &slab_pages[id];
+    void * slot = page->free_slot;
+    page->free_slot = *(void **)slot;
+    page->used_cnt++;
+
+    /*Full pages needn't be in the list*/
+    if(page->free_slot == NULL) slab_list_remove(&slab_partial[c], id);
+
+    slab_used += slot_size;
+    return slot;
+}
+
+/**
+ * Free a slot. `MEM_LOCK` should be held.
+ * @param data pointer to a slot
+ * @return size of the slot
+ */
+static size_t slab_free(void * data)
+{
+    uint16_t id = SLAB_PAGE_ID(data);
+    slab_page_t * page = &slab_pages[id];
+    uint32_t c = page->class_id;
+
+    /*The page was full so it wasn't in the list*/
+    if(page->free_slot == NULL) slab_list_add(&slab_partial[c], id);
+
+    *(void **)data = page->free_slot;
+    page->free_slot = data;
+    page->used_cnt--;
+
+    /*Let any class use the empty page*/
+    if(page->used_cnt == 0) {
+        slab_list_remove(&slab_partial[c], id);
+        slab_list_add(&slab_free_page, id);
+    }
+
+    slab_used -= slab_class_size[c];
+    return slab_class_size[c];
+}
+
+static bool slab_contains(const void * data)
+{
+    const uint8_t * data8 = data;
+    return slab_mem && data8 >= slab_mem && data8 < slab_mem + SLAB_PAGE_CNT * SLAB_PAGE_SIZE;
+}
+
+/**
+ * Check the free slots of the pages and the used size. `MEM_LOCK` should be held.
+ * @return true: the slab is consistent
+ */
+static bool slab_check(void)
+{
+    if(slab_mem == NULL) return true;
+
+    uint32_t used = 0;
+    uint32_t i;
+    for(i = 0; i < SLAB_PAGE_CNT; i++) {
+        slab_page_t * page = &slab_pages[i];
+        if(page->used_cnt == 0) continue;
+
+        uint32_t slot_size = slab_class_size[page->class_id];
+        uint32_t slot_cnt = SLAB_PAGE_SIZE / slot_size;
+        uint8_t * page_start = slab_mem + i * SLAB_PAGE_SIZE;
+        uint32_t free_cnt = 0;
+        uint8_t * slot;
+        for(slot = page->free_slot; slot; slot = *(void **)slot) {
+            if(slot < page_start || slot >= page_start + slot_cnt * slot_size) return false;
+            if((slot - page_start) % slot_size) return false;
+            free_cnt++;
+            if(free_cnt > slot_cnt) return false;
+        }
+
+        if(free_cnt + page->used_cnt != slot_cnt) return false;
+        used += page->used_cnt * slot_size;
+    }
+
+    return used == slab_used;
+}
+
+static void slab_list_add(uint16_t * head, uint16_t id)
+{
+    slab_pages[id].prev = SLAB_NONE;
+    slab_pages[id].next = *head;
+    if(*head != SLAB_NONE) slab_pages[*head].prev = id;
+    *head = id;
+}
+
+static void slab_list_remove(uint16_t * head, uint16_t id)
+{
+    slab_page_t * page = &slab_pages[id];
+    if(page->prev != SLAB_NONE) slab_pages[page->prev].next = page->next;
+    else *head = page->next;
+    if(page->next != SLAB_NONE) slab_pages[page->next].prev = page->prev;
+}
+#endif /*SLAB*/
+
+static uint32_t buf_bucket_ceil(uint32_t size)
+{
+    uint32_t bucket = LV_MEM_BUF_BUCKET_MIN;
+    while(bucket < 31 && (1UL << bucket) < size) bucket++;
+    return bucket;
+}
+
+static uint32_t buf_hash(const void * p)
+{
+    lv_uintptr_t v = (lv_uintptr_t)p >> 3;
+    return (uint32_t)(v ^ (v >> 5) ^ (v >> 10)) & (LV_MEM_BUF_HASH_SIZE - 1);
+}
+
+static bool buf_in_arena(lv_mem_buf_pool_t * pool, const void * p)
+{
+    const uint8_t * p8 = p;
+    return pool->arena && p8 >= pool->arena && p8 < pool->arena + pool->arena_size;
+}
+
+/**
+ * Remove the first not used buffer from a bucket and mark it as used
+ * @param pool the buffers of the thread
+ * @param bucket a bucket with not used buffers
+ * @return index of the buffer
+ */
+static uint32_t buf_pop_free(lv_mem_buf_pool_t * pool, uint32_t bucket)
+{
+    uint32_t i = bucket - LV_MEM_BUF_BUCKET_MIN;
+    uint32_t id = pool->free_head[i] - 1;
+    pool->free_head[i] = pool->buf[id].next;
+    if(pool->free_head[i] == 0) pool->free_mask &= ~(1UL << i);
+    pool->buf[id].used = 1;
+    return id;
+}
+
+/**
+ * Give memory to an entry from the arena or from the heap
+ * @param pool the buffers of the thread
+ * @param id index of an entry without memory
+ * @param size the required size
+ * @return true: success
+ */
+static bool buf_create(lv_mem_buf_pool_t * pool, uint32_t id, uint32_t size)
+{
+    uint32_t bucket = buf_bucket_ceil(size);
+    uint32_t buf_size = 1UL << bucket;
+
+    if(pool->arena == NULL && pool->arena_size) {
+        pool->arena = lv_mem_alloc(pool->arena_size);
+        if(pool->arena == NULL) pool->arena_size = 0;
+    }
+
+    uint8_t * p = NULL;
+    if(pool->arena && pool->arena_size - pool->arena_used >= buf_size) {
+        p = pool->arena + pool->arena_used;
+        pool->arena_used += buf_size;
+    }
+    else {
+        p = lv_mem_alloc(buf_size);
+        /*Try without rounding up if the memory is low*/
+        if(p == NULL && size > (1UL << LV_MEM_BUF_BUCKET_MIN)) {
+            p = lv_mem_alloc(size);
+            bucket--;
+            buf_size = size;
+        }
+        if(p == NULL) return false;
+    }
+
+    pool->frame_size += buf_size;
+    pool->frame_size_max = LV_MAX(pool->frame_size, pool->frame_size_max);
+
+    lv_mem_buf_t * buf = &pool->buf[id];
+    buf->p = p;
+    buf->bucket = bucket;
+    uint32_t h = buf_hash(p);
+    buf->hash_next = pool->hash_head[h];
+    pool->hash_head[h] = id + 1;
+    return true;
+}
+
+/**
+ * Free the memory of an entry
+ * @param pool the buffers of the thread
+ * @param id index of the entry
+ */
+static void buf_drop(lv_mem_buf_pool_t * pool, uint32_t id)
+{
+    lv_mem_buf_t * buf = &pool->buf[id];
+    uint8_t * id1_p = &pool->hash_head[buf_hash(buf->p)];
+    while(*id1_p != id + 1) id1_p = &pool->buf[*id1_p - 1].hash_next;
+    *id1_p = buf->hash_next;
+
+    /*The memory from the arena will be reused only after the next refresh*/
+    if(!buf_in_arena(pool, buf->p)) lv_mem_free(buf->p);
+    buf->p = NULL;
+}
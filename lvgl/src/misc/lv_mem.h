@@ -24,6 +24,10 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*The capacity of the `lv_mem_buf_get` buffers is a power of two, at least 32 bytes*/
+#define LV_MEM_BUF_BUCKET_MIN   5
+#define LV_MEM_BUF_BUCKET_CNT   (32 - LV_MEM_BUF_BUCKET_MIN)
+#define LV_MEM_BUF_HASH_SIZE    32
 
 /**********************
  *      TYPEDEFS
@@ -41,15 +45,36 @@ typedef struct {
     uint32_t max_used; /**< Max size of Heap memory used*/
     uint8_t used_pct; /**< Percentage used*/
     uint8_t frag_pct; /**< Amount of fragmentation*/
+    uint32_t slab_size; /**< Size of the memory reserved for small allocations (`LV_MEM_SLAB_SIZE`)*/
+    uint32_t slab_used; /**< Used part of `slab_size`*/
+    uint32_t slab_fallback_cnt; /**< Number of small allocations which didn't fit into the slab*/
 } lv_mem_monitor_t;
 
 typedef struct {
     void * p;
-    uint16_t size;
+    uint8_t bucket;         /**< The buffer has at least `1 << bucket` bytes*/
     uint8_t used : 1;
+    uint8_t next;           /**< Index + 1 of the next not used buffer of the bucket or of the next empty entry*/
+    uint8_t hash_next;      /**< Index + 1 of the next buffer with the same hash*/
 } lv_mem_buf_t;
 
-typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
+/**
+ * Temporary buffers of a thread. They are freed at the end of every display refresh.
+ * The buffers are allocated from an arena whose size is the total size of the buffers in the previous refresh.
+ */
+typedef struct {
+    lv_mem_buf_t buf[LV_MEM_BUF_MAX_NUM];
+    uint8_t free_head[LV_MEM_BUF_BUCKET_CNT];   /**< Index + 1 of the first not used buffer in each bucket*/
+    uint8_t hash_head[LV_MEM_BUF_HASH_SIZE];    /**< Index + 1 of the first buffer with a given hash*/
+    uint8_t empty_head;                         /**< Index + 1 of the first entry without memory*/
+    uint8_t buf_cnt;                            /**< Number of entries ever used since the last refresh*/
+    uint32_t free_mask;                         /**< Bit `n` is set if `free_head[n]` is not empty*/
+    uint8_t * arena;
+    uint32_t arena_size;
+    uint32_t arena_used;
+    uint32_t frame_size;                        /**< Size of the buffers created since the last refresh*/
+    uint32_t frame_size_max;                    /**< The largest `frame_size` so far*/
+} lv_mem_buf_pool_t;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -114,7 +139,7 @@ void * lv_mem_buf_get(uint32_t size);
 void lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Free all memory buffers and the arena. The next arena will be as large as the buffers were in total.
  */
 void lv_mem_buf_free_all(void);
 
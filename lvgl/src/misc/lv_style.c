@@ -139,6 +139,8 @@ uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
 static uint16_t last_custom_prop_id = (uint16_t)_LV_STYLE_LAST_BUILT_IN_PROP;
 static const lv_style_value_t null_style_value = { .num = 0 };
+static uint32_t style_version;
+static bool style_version_inc = true;
 
 /**********************
  *      MACROS
@@ -171,8 +173,12 @@ void lv_style_reset(lv_style_t * style)
         return;
     }
 
-    if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
+    if(style->prop1 == _LV_STYLE_PROP_FROZEN) {
+        if(style->v_p.frozen->allocated) lv_mem_free((lv_style_frozen_t *)style->v_p.frozen);
+    }
+    else if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
     lv_memset_00(style, sizeof(lv_style_t));
+    if(style_version_inc) style_version++;
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
@@ -228,12 +234,18 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
         return false;
     }
 
+    if(style->prop1 == _LV_STYLE_PROP_FROZEN) {
+        LV_LOG_ERROR("Cannot remove prop from frozen style");
+        return false;
+    }
+
     if(style->prop_cnt == 0)  return false;
 
     if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
             style->prop_cnt = 0;
+            if(style_version_inc) style_version++;
             return true;
         }
         return false;
@@ -273,6 +285,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_mem_free(old_values);
+            if(style_version_inc) style_version++;
             return true;
         }
     }
@@ -295,6 +308,74 @@ lv_style_res_t lv_style_get_prop(const lv_style_t * style, lv_style_prop_t prop,
     return lv_style_get_prop_inlined(style, prop, value);
 }
 
+bool lv_style_freeze(lv_style_t * style)
+{
+    LV_ASSERT_STYLE(style);
+
+    if(style->prop1 == _LV_STYLE_PROP_FROZEN) return true;
+
+    if(style->prop1 == LV_STYLE_PROP_ANY) {
+        LV_LOG_WARN("Cannot freeze const style");
+        return false;
+    }
+
+    const uint16_t * props;
+    const lv_style_value_t * values;
+    if(style->prop_cnt > 1) {
+        values = (const lv_style_value_t *)style->v_p.values_and_props;
+        props = (const uint16_t *)(style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t));
+    }
+    else {
+        values = &style->v_p.value1;
+        props = &style->prop1;
+    }
+
+    uint32_t i;
+    for(i = 0; i < style->prop_cnt; i++) {
+        if(LV_STYLE_PROP_ID_MASK(props[i]) >= _LV_STYLE_NUM_BUILT_IN_PROPS) {
+            LV_LOG_WARN("Cannot freeze style with custom properties");
+            return false;
+        }
+    }
+
+    lv_style_frozen_t * frozen = lv_mem_alloc(sizeof(lv_style_frozen_t) + style->prop_cnt * sizeof(lv_style_value_t));
+    LV_ASSERT_MALLOC(frozen);
+    if(frozen == NULL) return false;
+    lv_memset_00(frozen, sizeof(lv_style_frozen_t));
+    frozen->allocated = 1;
+
+    for(i = 0; i < style->prop_cnt; i++) {
+        lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
+        uint32_t bit = (uint32_t)1 << (prop_id & 0x1F);
+        frozen->has_prop[prop_id >> 5] |= bit;
+        if(props[i] & LV_STYLE_PROP_META_INHERIT) frozen->inherit[prop_id >> 5] |= bit;
+    }
+
+    uint32_t w;
+    uint32_t cnt = 0;
+    for(w = 0; w < _LV_STYLE_FROZEN_WORDS; w++) {
+        frozen->first_value[w] = cnt;
+        cnt += _lv_style_popcount(frozen->has_prop[w]);
+    }
+
+    /*Put the values to the place where the lookup will search them*/
+    lv_style_value_t * new_values = (lv_style_value_t *)(frozen + 1);
+    for(i = 0; i < style->prop_cnt; i++) {
+        lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
+        uint32_t w_act = prop_id >> 5;
+        uint32_t bit = (uint32_t)1 << (prop_id & 0x1F);
+        uint32_t idx = frozen->first_value[w_act] + _lv_style_popcount(frozen->has_prop[w_act] & (bit - 1));
+        new_values[idx] = (props[i] & LV_STYLE_PROP_META_INITIAL) ? lv_style_prop_get_default(prop_id) : values[i];
+    }
+    frozen->values = new_values;
+
+    if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
+    style->v_p.frozen = frozen;
+    style->prop1 = _LV_STYLE_PROP_FROZEN;
+
+    return true;
+}
+
 void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style_prop_t props[],
                                   lv_anim_path_cb_t path_cb, uint32_t time, uint32_t delay, void * user_data)
 {
@@ -393,6 +474,16 @@ uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop)
     return 0;
 }
 
+uint32_t _lv_style_get_version(void)
+{
+    return style_version;
+}
+
+void _lv_style_enable_version_inc(bool en)
+{
+    style_version_inc = en;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -422,6 +513,13 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    if(style->prop1 == _LV_STYLE_PROP_FROZEN) {
+        LV_LOG_ERROR("Cannot set property of frozen style");
+        return;
+    }
+
+    if(style_version_inc) style_version++;
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
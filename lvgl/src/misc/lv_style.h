@@ -68,6 +68,25 @@ LV_EXPORT_CONST_INT(LV_IMG_ZOOM_NONE);
         .prop_cnt = (sizeof(prop_array) / sizeof((prop_array)[0])),     \
     }
 #endif
+
+#if LV_USE_ASSERT_STYLE
+#define LV_STYLE_FROZEN_INIT(var_name, frozen_dsc)                      \
+    const lv_style_t var_name = {                                       \
+        .sentinel = LV_STYLE_SENTINEL_VALUE,                            \
+        .v_p = { .frozen = &(frozen_dsc) },                             \
+        .has_group = 0xFF,                                              \
+        .prop1 = _LV_STYLE_PROP_FROZEN,                                 \
+        .prop_cnt = 1,                                                  \
+    }
+#else
+#define LV_STYLE_FROZEN_INIT(var_name, frozen_dsc)                      \
+    const lv_style_t var_name = {                                       \
+        .v_p = { .frozen = &(frozen_dsc) },                             \
+        .has_group = 0xFF,                                              \
+        .prop1 = _LV_STYLE_PROP_FROZEN,                                 \
+        .prop_cnt = 1,                                                  \
+    }
+#endif
 // *INDENT-ON*
 
 #define LV_STYLE_PROP_META_INHERIT 0x8000
@@ -281,7 +300,8 @@ typedef enum {
     _LV_STYLE_NUM_BUILT_IN_PROPS     = _LV_STYLE_LAST_BUILT_IN_PROP + 1,
 
     LV_STYLE_PROP_ANY                = 0xFFFF,
-    _LV_STYLE_PROP_CONST             = 0xFFFF /* magic value for const styles */
+    _LV_STYLE_PROP_CONST             = 0xFFFF, /* magic value for const styles */
+    _LV_STYLE_PROP_FROZEN            = 0xFFFE  /* magic value for frozen styles */
 } lv_style_prop_t;
 
 enum {
@@ -313,6 +333,21 @@ typedef struct {
     lv_style_value_t value;
 } lv_style_const_prop_t;
 
+#define _LV_STYLE_FROZEN_WORDS  ((_LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32)
+
+/**
+ * Descriptor of a frozen style. The values of the built-in properties are stored in a dense array
+ * in the order of the property IDs. The index of a value is the number of set bits before the property's bit.
+ * It can be created by `lv_style_freeze` or filled in the ROM and used with `LV_STYLE_FROZEN_INIT`.
+ */
+typedef struct {
+    uint32_t has_prop[_LV_STYLE_FROZEN_WORDS];  /**< Bit `prop` is set if the style contains `prop`*/
+    uint32_t inherit[_LV_STYLE_FROZEN_WORDS];   /**< Bit `prop` is set if `prop` is inherited from the parent*/
+    uint8_t first_value[_LV_STYLE_FROZEN_WORDS];/**< Index of the value of the first set bit of every `has_prop` word*/
+    uint8_t allocated;                          /**< 1: created by `lv_style_freeze`, free it on `lv_style_reset`*/
+    const lv_style_value_t * values;            /**< The values of the properties (inherited ones too, but not used)*/
+} lv_style_frozen_t;
+
 /**
  * Descriptor of a style (a collection of properties and values).
  */
@@ -328,6 +363,7 @@ typedef struct {
         lv_style_value_t value1;
         uint8_t * values_and_props;
         const lv_style_const_prop_t * const_props;
+        const lv_style_frozen_t * frozen;
     } v_p;
 
     uint16_t prop1;
@@ -412,6 +448,16 @@ void lv_style_set_prop_meta(lv_style_t * style, lv_style_prop_t prop, uint16_t m
  */
 lv_style_res_t lv_style_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value);
 
+/**
+ * Freeze a style which won't change any more to get its properties faster.
+ * The properties are stored in a dense array indexed by a bitmask of the properties.
+ * @param style pointer to a style
+ * @return true: the style is frozen; false: the style is not changed because it's const,
+ *         has custom properties or there was no enough memory.
+ * @note The properties of a frozen style can't be set or removed, but `lv_style_reset` can clear the style.
+ */
+bool lv_style_freeze(lv_style_t * style);
+
 /**
  * Initialize a transition descriptor.
  * @param tr        pointer to a transition descriptor to initialize
@@ -435,6 +481,22 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Count the set bits in a number
+ * @param x     a number
+ * @return      the number of 1 bits
+ */
+static inline uint32_t _lv_style_popcount(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+#endif
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -448,6 +510,17 @@ lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style, lv_style_prop_t prop,
                                                        lv_style_value_t * value)
 {
+    if(style->prop1 == _LV_STYLE_PROP_FROZEN) {
+        if(prop >= _LV_STYLE_NUM_BUILT_IN_PROPS) return LV_STYLE_RES_NOT_FOUND;
+        const lv_style_frozen_t * frozen = style->v_p.frozen;
+        uint32_t w = prop >> 5;
+        uint32_t bit = (uint32_t)1 << (prop & 0x1F);
+        if((frozen->has_prop[w] & bit) == 0) return LV_STYLE_RES_NOT_FOUND;
+        if(frozen->inherit[w] & bit) return LV_STYLE_RES_INHERIT;
+        *value = frozen->values[frozen->first_value[w] + _lv_style_popcount(frozen->has_prop[w] & (bit - 1))];
+        return LV_STYLE_RES_FOUND;
+    }
+
     if(style->prop1 == LV_STYLE_PROP_ANY) {
         const lv_style_const_prop_t * const_prop;
         uint32_t i;
@@ -518,6 +591,20 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop);
  */
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop);
 
+/**
+ * Get a counter which is incremented when a property of any shared style is set or removed.
+ * It tells if the style properties resolved earlier might be outdated.
+ * @return the current value of the counter
+ */
+uint32_t _lv_style_get_version(void);
+
+/**
+ * Used internally to modify the local and transition styles of the objects without incrementing the style version.
+ * Only their object uses these styles and it marks its own cached properties as outdated.
+ * @param en    false: the next modifications don't increment the version; true: they increment it again
+ */
+void _lv_style_enable_version_inc(bool en);
+
 #include "lv_style_gen.h"
 
 static inline void lv_style_set_size(lv_style_t * style, lv_coord_t value)
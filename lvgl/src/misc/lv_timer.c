@@ -17,6 +17,7 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define NEXT_RUN_MAX 0x3FFFFFFF /*Longer periods are checked in steps to keep `next_run`s comparable*/
 
 /**********************
  *      TYPEDEFS
@@ -27,14 +28,20 @@
  **********************/
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static bool queue_update(lv_timer_t * timer);
+static void queue_remove(lv_timer_t * timer);
+static bool queue_before(const lv_timer_t * a, const lv_timer_t * b);
+static void queue_set(uint32_t pos, lv_timer_t * timer);
+static void queue_sift(uint32_t pos);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static uint32_t queue_cnt;
+static uint32_t queue_size;
+static uint32_t handler_run_id;
 
 /**********************
  *      MACROS
@@ -55,6 +62,9 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_queue) = NULL;
+    queue_cnt = 0;
+    queue_size = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,40 +105,21 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    /*Run the ready timers in the order of their next run. They are checked only once in a call,
+     *so a timer which is ready again (e.g. has 0 period) is left for the next call.*/
+    handler_run_id++;
+    while(queue_cnt) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_queue)[0];
+        if(timer->run_id == handler_run_id) break;
+        if((int32_t)(timer->next_run - lv_tick_get()) > 0) break;
+
+        timer->run_id = handler_run_id;
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        lv_timer_exec(timer);
     }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+
+    uint32_t time_till_next = lv_timer_get_time_till_next();
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -145,6 +136,14 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
     return time_till_next;
 }
 
+uint32_t lv_timer_get_time_till_next(void)
+{
+    if(queue_cnt == 0) return LV_NO_TIMER_READY;
+
+    int32_t time_till_next = (int32_t)(LV_GC_ROOT(_lv_timer_queue)[0]->next_run - lv_tick_get());
+    return time_till_next > 0 ? (uint32_t)time_till_next : 0;
+}
+
 /**
  * Create an "empty" timer. It needs to initialized with at least
  * `lv_timer_set_cb` and `lv_timer_set_period`
@@ -178,8 +177,14 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->queue_pos = 0;
+    new_timer->run_id = 0;
 
-    timer_created = true;
+    if(!queue_update(new_timer)) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), new_timer);
+        lv_mem_free(new_timer);
+        return NULL;
+    }
 
     return new_timer;
 }
@@ -201,7 +206,8 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 void lv_timer_del(lv_timer_t * timer)
 {
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    queue_remove(timer);
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
 }
@@ -213,11 +219,13 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    queue_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     timer->paused = false;
+    queue_update(timer);
 }
 
 /**
@@ -228,6 +236,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    queue_update(timer);
 }
 
 /**
@@ -237,6 +246,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    queue_update(timer);
 }
 
 /**
@@ -247,6 +257,7 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+    queue_update(timer);
 }
 
 /**
@@ -257,6 +268,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    queue_update(timer);
 }
 
 /**
@@ -316,11 +328,14 @@ static bool lv_timer_exec(lv_timer_t * timer)
         exec = true;
     }
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
+        else {
+            queue_update(timer);
+        }
     }
 
     return exec;
@@ -339,3 +354,96 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Set when the timer needs to be checked again and move it to its place in the queue.
+ * Paused timers are removed from the queue.
+ * @param timer pointer to lv_timer
+ * @return false: couldn't allocate memory to add the timer to the queue
+ */
+static bool queue_update(lv_timer_t * timer)
+{
+    if(timer->paused) {
+        queue_remove(timer);
+        return true;
+    }
+
+    /*Timers with 0 repeat count will be deleted when checked*/
+    uint32_t remaining = timer->repeat_count == 0 ? 0 : lv_timer_time_remaining(timer);
+    timer->next_run = lv_tick_get() + LV_MIN(remaining, NEXT_RUN_MAX);
+
+    if(timer->queue_pos == 0) {
+        if(queue_cnt == queue_size) {
+            uint32_t new_size = queue_size ? queue_size * 2 : 8;
+            lv_timer_t ** new_queue = lv_mem_realloc(LV_GC_ROOT(_lv_timer_queue), new_size * sizeof(lv_timer_t *));
+            LV_ASSERT_MALLOC(new_queue);
+            if(new_queue == NULL) return false;
+            LV_GC_ROOT(_lv_timer_queue) = new_queue;
+            queue_size = new_size;
+        }
+        queue_cnt++;
+        queue_set(queue_cnt - 1, timer);
+    }
+
+    queue_sift(timer->queue_pos - 1);
+    return true;
+}
+
+static void queue_remove(lv_timer_t * timer)
+{
+    if(timer->queue_pos == 0) return;
+
+    uint32_t pos = timer->queue_pos - 1;
+    timer->queue_pos = 0;
+    queue_cnt--;
+    if(pos == queue_cnt) return;
+
+    /*Move the last timer to the empty place*/
+    queue_set(pos, LV_GC_ROOT(_lv_timer_queue)[queue_cnt]);
+    queue_sift(pos);
+}
+
+/**
+ * Tell if a timer needs to be checked before an other. In case of equal `next_run` the one not checked
+ * in the current `lv_timer_handler` call comes first.
+ */
+static bool queue_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)(a->next_run - b->next_run);
+    if(diff != 0) return diff < 0;
+    return a->run_id != handler_run_id && b->run_id == handler_run_id;
+}
+
+static void queue_set(uint32_t pos, lv_timer_t * timer)
+{
+    LV_GC_ROOT(_lv_timer_queue)[pos] = timer;
+    timer->queue_pos = pos + 1;
+}
+
+/**
+ * Move a timer up or down in the binary heap until its parent is before and its children are after it
+ * @param pos position of the timer
+ */
+static void queue_sift(uint32_t pos)
+{
+    lv_timer_t ** queue = LV_GC_ROOT(_lv_timer_queue);
+    lv_timer_t * timer = queue[pos];
+
+    while(pos > 0) {
+        uint32_t parent = (pos - 1) / 2;
+        if(!queue_before(timer, queue[parent])) break;
+        queue_set(pos, queue[parent]);
+        pos = parent;
+    }
+
+    while(1) {
+        uint32_t child = pos * 2 + 1;
+        if(child >= queue_cnt) break;
+        if(child + 1 < queue_cnt && queue_before(queue[child + 1], queue[child])) child++;
+        if(!queue_before(queue[child], timer)) break;
+        queue_set(pos, queue[child]);
+        pos = child;
+    }
+
+    queue_set(pos, timer);
+}
@@ -47,6 +47,9 @@ typedef struct _lv_timer_t {
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t next_run; /**< Tick when the timer needs to be checked again*/
+    uint32_t queue_pos; /**< Position + 1 in the queue of the not paused timers ordered by `next_run`. 0: not queued*/
+    uint32_t run_id; /**< The `lv_timer_handler` call in which the timer was checked last*/
     uint32_t paused : 1;
 } lv_timer_t;
 
@@ -87,6 +90,13 @@ static inline uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler_run_in_period
     return 1;
 }
 
+/**
+ * Get the time until the next timer needs to be run.
+ * The caller can sleep for this long if there is no other source of events (e.g. input devices not handled by timers)
+ * @return time until the next timer in ms, 0 if one is ready or `LV_NO_TIMER_READY` if there are no running timers
+ */
+uint32_t lv_timer_get_time_till_next(void);
+
 /**
  * Create an "empty" timer. It needs to initialized with at least
  * `lv_timer_set_cb` and `lv_timer_set_period`
@@ -13,6 +13,7 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include "../lv_conf_internal.h"
 #include <stdint.h>
 
 /*********************
@@ -71,6 +72,18 @@ typedef uint32_t lv_uintptr_t;
 
 #define LV_UNUSED(x) ((void)x)
 
+/*Storage class of the variables used while rendering.
+ *With `LV_USE_REFR_THREADS` every rendering thread has its own copy of them.*/
+#if LV_USE_REFR_THREADS
+#if defined(__GNUC__) || defined(__clang__)
+#define LV_THREAD_LOCAL __thread
+#else
+#define LV_THREAD_LOCAL _Thread_local
+#endif
+#else
+#define LV_THREAD_LOCAL
+#endif
+
 #define _LV_CONCAT(x, y) x ## y
 #define LV_CONCAT(x, y) _LV_CONCAT(x, y)
 
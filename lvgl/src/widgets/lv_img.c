@@ -597,14 +597,16 @@ static void draw_img(lv_event_t * e)
             bg_coords.y2 += obj->coords.y1;
         }
 
+        /*Don't write the coordinates if not required as other rendering threads might read them*/
+        bool coords_swap = !_lv_area_is_equal(&bg_coords, &obj->coords);
         lv_area_t ori_coords;
         lv_area_copy(&ori_coords, &obj->coords);
-        lv_area_copy(&obj->coords, &bg_coords);
+        if(coords_swap) lv_area_copy(&obj->coords, &bg_coords);
 
         lv_res_t res = lv_obj_event_base(MY_CLASS, e);
         if(res != LV_RES_OK) return;
 
-        lv_area_copy(&obj->coords, &ori_coords);
+        if(coords_swap) lv_area_copy(&obj->coords, &ori_coords);
 
         if(code == LV_EVENT_DRAW_MAIN) {
             if(img->h == 0 || img->w == 0) return;
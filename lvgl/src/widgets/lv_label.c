@@ -706,6 +706,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_init(&label->layout);
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -726,6 +730,9 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     lv_label_dot_tmp_free(obj);
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_free(&label->layout);
+#endif
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
 }
@@ -808,6 +815,9 @@ static void draw_main(lv_event_t * e)
 
     label_draw_dsc.flag = flag;
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
+#if LV_LABEL_LAYOUT_CACHE
+    label_draw_dsc.layout = &label->layout;
+#endif
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
 
     label_draw_dsc.sel_start = lv_label_get_text_selection_start(obj);
@@ -828,7 +838,8 @@ static void draw_main(lv_event_t * e)
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
     }
-#if LV_LABEL_LONG_TXT_HINT
+#if LV_LABEL_LONG_TXT_HINT && LV_USE_REFR_THREADS == 0
+    /*The hint is updated while drawing, so it can't be used if several threads draw the label*/
     lv_draw_label_hint_t * hint = &label->hint;
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
@@ -912,7 +923,16 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
+#if LV_LABEL_LAYOUT_CACHE
+    /*Break the text into lines once here instead of on every redraw*/
+    lv_base_dir_t base_dir_layout = lv_obj_get_style_base_dir(obj, LV_PART_MAIN);
+    if(!lv_draw_label_layout_update(&label->layout, label->text, font, letter_space, line_space, max_w, flag,
+                                    base_dir_layout, &size)) {
+        lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    }
+#else
     lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+#endif
 
     lv_obj_refresh_self_size(obj);
 
@@ -1156,6 +1176,11 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LAYOUT_CACHE
+                /*The text has changed*/
+                lv_draw_label_layout_update(&label->layout, label->text, font, letter_space, line_space, max_w, flag,
+                                            base_dir_layout, NULL);
+#endif
             }
         }
     }
@@ -1173,6 +1198,10 @@ static void lv_label_revert_dots(lv_obj_t * obj)
 
     if(label->long_mode != LV_LABEL_LONG_DOT) return;
     if(label->dot_end == LV_LABEL_DOT_END_INV) return;
+#if LV_LABEL_LAYOUT_CACHE
+    /*It was made for the text with the dots*/
+    lv_draw_label_layout_free(&label->layout);
+#endif
     uint32_t letter_i = label->dot_end - LV_LABEL_DOT_NUM;
     uint32_t byte_i   = _lv_txt_encoded_get_byte_id(label->text, letter_i);
 
@@ -11,6 +11,16 @@
 
 static inline uint32_t lv_test_get_free_mem(void)
 {
+#if LV_USE_REFR_THREADS
+    /*Stop the rendering threads to free their caches, they are started again for the next refresh.
+     *The work is shared differently between the threads in every refresh so free the caches of this thread too.*/
+    _lv_refr_deinit();
+    _lv_font_fmt_txt_cache_free();
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_corner_cache_free();
+#endif
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+#endif
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
     return m1.free_size;
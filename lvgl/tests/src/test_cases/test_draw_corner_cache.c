@@ -0,0 +1,145 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_DRAW_COMPLEX
+    #define CORNER_CACHE_ENABLED (LV_CORNER_CACHE_SIZE > 0)
+#else
+    #define CORNER_CACHE_ENABLED 0
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->antialiasing = 1;
+    lv_obj_clean(lv_scr_act());
+}
+
+#if CORNER_CACHE_ENABLED
+static void test_map(lv_coord_t radius, bool inv)
+{
+    const lv_opa_t * map = _lv_draw_mask_get_corner_map(radius, inv);
+    TEST_ASSERT_NOT_NULL(map);
+
+    lv_coord_t side = radius * 2;
+    lv_area_t circle_area;
+    lv_area_set(&circle_area, 10, 20, 10 + side - 1, 20 + side - 1);
+    lv_draw_mask_radius_param_t param;
+    lv_draw_mask_radius_init(&param, &circle_area, radius, inv);
+    int16_t id = lv_draw_mask_add(&param, NULL);
+
+    static lv_opa_t line[256];
+    lv_coord_t y;
+    for(y = 0; y < side; y++) {
+        lv_memset_ff(line, side);
+        lv_draw_mask_res_t res = lv_draw_mask_apply(line, circle_area.x1, circle_area.y1 + y, side);
+        if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(line, side);
+        TEST_ASSERT_EQUAL_MEMORY(line, &map[y * side], side);
+    }
+
+    lv_draw_mask_remove_id(id);
+    lv_draw_mask_free_param(&param);
+}
+#endif
+
+void test_corner_map_is_same_as_radius_mask(void)
+{
+#if CORNER_CACHE_ENABLED
+    lv_coord_t r;
+    for(r = 1; r <= 40; r++) {
+        test_map(r, false);
+        test_map(r, true);
+    }
+#endif
+}
+
+void test_corner_cache_reuses_and_drops_maps(void)
+{
+#if CORNER_CACHE_ENABLED
+    const lv_opa_t * map = _lv_draw_mask_get_corner_map(10, false);
+    TEST_ASSERT_EQUAL_PTR(map, _lv_draw_mask_get_corner_map(10, false));
+    TEST_ASSERT_NOT_EQUAL(map, _lv_draw_mask_get_corner_map(10, true));
+
+    /*Too large for the cache*/
+    TEST_ASSERT_NULL(_lv_draw_mask_get_corner_map(LV_CORNER_CACHE_SIZE, false));
+
+    /*Fill the cache with many radiuses. It shouldn't grow above the limit.*/
+    lv_coord_t r;
+    for(r = 1; r <= 60; r++) {
+        TEST_ASSERT_NOT_NULL(_lv_draw_mask_get_corner_map(r, false));
+        TEST_ASSERT_LESS_OR_EQUAL(LV_CORNER_CACHE_SIZE, LV_GC_ROOT(_lv_corner_cache).size);
+    }
+
+    /*The most recently used radius is kept*/
+    map = _lv_draw_mask_get_corner_map(60, false);
+    TEST_ASSERT_EQUAL_PTR(map, _lv_draw_mask_get_corner_map(60, false));
+#endif
+}
+
+void test_corner_cache_free_releases_the_maps(void)
+{
+#if CORNER_CACHE_ENABLED
+    _lv_draw_mask_corner_cache_free();
+    _lv_draw_mask_cleanup();
+    uint32_t mem_before = lv_test_get_free_mem();
+
+    TEST_ASSERT_NOT_NULL(_lv_draw_mask_get_corner_map(10, false));
+    TEST_ASSERT_NOT_NULL(_lv_draw_mask_get_corner_map(20, true));
+    TEST_ASSERT_GREATER_THAN(0, LV_GC_ROOT(_lv_corner_cache).size);
+
+    _lv_draw_mask_corner_cache_free();
+    _lv_draw_mask_cleanup();
+    TEST_ASSERT_EQUAL(0, LV_GC_ROOT(_lv_corner_cache).size);
+    TEST_ASSERT_NULL(LV_GC_ROOT(_lv_corner_cache).lru_first);
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem()));
+#endif
+}
+
+static void create_rects(void)
+{
+    /*Some rectangles are clipped by the scrolled parent*/
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 300);
+    lv_obj_set_style_radius(cont, 0, 0);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_scroll_to(cont, 13, 17, LV_ANIM_OFF);
+
+    static const lv_coord_t radius[] = {1, 2, 5, 8, 15, 30, LV_RADIUS_CIRCLE};
+    static const lv_opa_t opa[] = {LV_OPA_COVER, LV_OPA_50, LV_OPA_20};
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(radius) / sizeof(radius[0]); i++) {
+        for(j = 0; j < sizeof(opa) / sizeof(opa[0]) * 2; j++) {
+            lv_obj_t * obj = lv_obj_create(j & 1 ? lv_scr_act() : cont);
+            lv_obj_remove_style_all(obj);
+            lv_obj_set_size(obj, 37 + i * 3, 29 + j * 5);
+            if(j & 1) lv_obj_set_pos(obj, 320 + j * 70, i * 65);
+            lv_obj_set_style_radius(obj, radius[i], 0);
+            lv_obj_set_style_bg_opa(obj, opa[j / 2], 0);
+            lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+            if(i % 3 == 2) {
+                lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+                lv_obj_set_style_bg_grad_dir(obj, i & 1 ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+            }
+        }
+    }
+}
+
+/*The reference images were rendered with radius masks, without the corner cache*/
+void test_corner_cache_draws_the_same_as_radius_mask(void)
+{
+    create_rects();
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_corner_cache_1.png");
+
+    lv_disp_get_default()->driver->antialiasing = 0;
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_corner_cache_2.png");
+}
+
+#endif
@@ -0,0 +1,142 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+}
+
+void tearDown(void)
+{
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    lv_obj_clean(lv_scr_act());
+}
+
+static void grad_init(lv_grad_dsc_t * g, lv_grad_dir_t dir, uint32_t c1, uint32_t c2)
+{
+    lv_memset_00(g, sizeof(lv_grad_dsc_t));
+    g->dir = dir;
+    g->stops_count = 2;
+    g->stops[0].color = lv_color_hex(c1);
+    g->stops[0].frac = 0;
+    g->stops[1].color = lv_color_hex(c2);
+    g->stops[1].frac = 255;
+}
+
+static uint32_t get_item_cnt(void)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < _LV_GRAD_CACHE_ITEM_MAX; i++) {
+        if(LV_GC_ROOT(_lv_grad_cache).items[i]) cnt++;
+    }
+    return cnt;
+}
+
+void test_grad_cache_finds_the_same_gradient(void)
+{
+    lv_grad_dsc_t g1;
+    lv_grad_dsc_t g2;
+    grad_init(&g1, LV_GRAD_DIR_HOR, 0xff0000, 0x0000ff);
+    grad_init(&g2, LV_GRAD_DIR_HOR, 0xff0000, 0x0000ff);
+
+    /*An other descriptor with the same content*/
+    lv_grad_t * item = lv_gradient_get(&g1, 100, 20);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_PTR(item, lv_gradient_get(&g2, 100, 20));
+
+    /*The height doesn't matter for a horizontal gradient*/
+    TEST_ASSERT_EQUAL_PTR(item, lv_gradient_get(&g2, 100, 50));
+    TEST_ASSERT_EQUAL(1, get_item_cnt());
+
+    /*Different width or color*/
+    TEST_ASSERT_NOT_EQUAL(item, lv_gradient_get(&g2, 101, 20));
+    g2.stops[1].color = lv_color_hex(0x00ff00);
+    lv_grad_t * item2 = lv_gradient_get(&g2, 100, 20);
+    TEST_ASSERT_NOT_EQUAL(item, item2);
+    TEST_ASSERT_EQUAL(3, get_item_cnt());
+
+    /*The color map is computed*/
+    TEST_ASSERT_EQUAL(100, item2->size);
+#if LV_COLOR_DEPTH == 32
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0xff0000).full, item2->map[0].full);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x00ff00).full, item2->map[99].full);
+#endif
+}
+
+void test_grad_cache_evicts_the_least_recently_used(void)
+{
+    lv_grad_dsc_t g;
+    grad_init(&g, LV_GRAD_DIR_VER, 0x000000, 0xffffff);
+
+    /*Make room for 3 items*/
+    lv_gradient_get(&g, 10, 100);
+    size_t item_size = LV_GC_ROOT(_lv_grad_cache).size;
+    lv_gradient_set_cache_size(item_size * 3);
+
+    lv_grad_t * items[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        g.stops[0].color = lv_color_hex(i);
+        items[i] = lv_gradient_get(&g, 10, 100);
+    }
+    TEST_ASSERT_EQUAL(3, get_item_cnt());
+    TEST_ASSERT_EQUAL(item_size * 3, LV_GC_ROOT(_lv_grad_cache).size);
+
+    /*Use the first one to keep it. The second is dropped for the new one.*/
+    g.stops[0].color = lv_color_hex(0);
+    TEST_ASSERT_EQUAL_PTR(items[0], lv_gradient_get(&g, 10, 100));
+    g.stops[0].color = lv_color_hex(3);
+    lv_gradient_get(&g, 10, 100);
+    TEST_ASSERT_EQUAL(3, get_item_cnt());
+
+    /*The items don't move while they are in the cache*/
+    g.stops[0].color = lv_color_hex(0);
+    TEST_ASSERT_EQUAL_PTR(items[0], lv_gradient_get(&g, 10, 100));
+    g.stops[0].color = lv_color_hex(2);
+    TEST_ASSERT_EQUAL_PTR(items[2], lv_gradient_get(&g, 10, 100));
+    TEST_ASSERT_EQUAL(3, get_item_cnt());
+    TEST_ASSERT_EQUAL(100, items[0]->size);
+}
+
+void test_grad_cache_too_large_item_is_freed(void)
+{
+    lv_grad_dsc_t g;
+    grad_init(&g, LV_GRAD_DIR_HOR, 0x000000, 0xffffff);
+    lv_gradient_set_cache_size(256);
+
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+
+    lv_grad_t * item = lv_gradient_get(&g, 400, 10);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE(item->not_cached);
+    TEST_ASSERT_EQUAL(0, get_item_cnt());
+    lv_gradient_cleanup(item);
+
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL(mon1.free_size, mon2.free_size);
+}
+
+void test_grad_cache_is_used_while_drawing(void)
+{
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_set_pos(obj, 10, 10 + i * 60);
+        lv_obj_set_size(obj, 200, 50);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+        lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+    }
+    lv_refr_now(NULL);
+
+    /*All the objects have the same gradient*/
+    TEST_ASSERT_EQUAL(1, get_item_cnt());
+}
+
+#endif
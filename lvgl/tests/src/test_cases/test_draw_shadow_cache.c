@@ -0,0 +1,153 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+/*The statistics are of the calling thread, the rendering threads draw parts of the screen with their own cache*/
+#define STATS_OF_WHOLE_SCREEN   (LV_USE_REFR_THREADS == 0)
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static lv_obj_t * create_card(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_coord_t radius,
+                              lv_coord_t shadow_width, lv_coord_t shadow_spread)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, shadow_width, 0);
+    lv_obj_set_style_shadow_spread(obj, shadow_spread, 0);
+    lv_obj_set_style_shadow_ofs_y(obj, 4, 0);
+    lv_obj_set_style_shadow_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    return obj;
+}
+
+static void create_cards(void)
+{
+    /*Cards with the same shadow should use the same corner*/
+    create_card(30, 30, 120, 80, 10, 20, 0);
+    create_card(180, 30, 160, 90, 10, 20, 0);
+    create_card(370, 30, 100, 100, 10, 20, 0);
+
+    /*Different shadow width, radius and spread*/
+    create_card(30, 170, 120, 80, 10, 40, 0);
+    create_card(180, 170, 120, 80, 20, 20, 0);
+    create_card(370, 170, 120, 80, 10, 20, 5);
+
+    /*Small circles whose other side affects the corners too*/
+    create_card(550, 40, 40, 40, LV_RADIUS_CIRCLE, 30, 0);
+    create_card(550, 150, 40, 80, LV_RADIUS_CIRCLE, 30, 0);
+    create_card(650, 40, 80, 40, LV_RADIUS_CIRCLE, 30, 0);
+
+    /*Translucent background, the shadow is masked under it*/
+    lv_obj_t * obj = create_card(30, 320, 200, 100, 15, 25, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+}
+
+/*The reference image was rendered without the shadow cache*/
+void test_shadow_cache_draws_the_same(void)
+{
+    lv_draw_sw_shadow_cache_stats_t stats;
+
+    create_cards();
+    lv_draw_sw_shadow_cache_reset_stats();
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_shadow_cache_1.png");
+
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    if(STATS_OF_WHOLE_SCREEN) {
+        TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+        TEST_ASSERT_GREATER_THAN(0, stats.miss_cnt);
+    }
+
+    /*Only found in the cache now*/
+    lv_draw_sw_shadow_cache_reset_stats();
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw_shadow_cache_1.png");
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    if(STATS_OF_WHOLE_SCREEN) {
+        TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+        TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    }
+}
+
+void test_shadow_cache_keeps_different_shadows(void)
+{
+    if(!STATS_OF_WHOLE_SCREEN) TEST_IGNORE_MESSAGE("the shadows are cached by several threads");
+
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    uint32_t entry_cnt_start = stats.entry_cnt;
+
+    create_card(30, 30, 120, 80, 12, 22, 0);
+    create_card(180, 30, 120, 80, 12, 22, 0);
+    create_card(30, 170, 120, 80, 12, 32, 0);
+    lv_refr_now(NULL);
+
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(entry_cnt_start + 2, stats.entry_cnt);
+#if LV_DRAW_COMPLEX
+    TEST_ASSERT_LESS_OR_EQUAL(LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE, stats.size);
+#endif
+
+    /*Both are found in the cache*/
+    lv_draw_sw_shadow_cache_reset_stats();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(entry_cnt_start + 2, stats.entry_cnt);
+}
+
+void test_shadow_cache_drops_least_recently_used(void)
+{
+    static lv_color32_t fb_ref[800 * 480];
+    extern lv_color32_t test_fb[];
+
+    /*More different shadows than the number of cached corners*/
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        create_card(30 + (i % 6) * 125, 20 + (i / 6) * 90, 80, 50, 5 + i, 10 + i, 0);
+    }
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    if(STATS_OF_WHOLE_SCREEN) {
+        lv_draw_sw_shadow_cache_stats_t stats;
+        lv_draw_sw_shadow_cache_get_stats(&stats);
+        TEST_ASSERT_GREATER_THAN(0, stats.entry_cnt);
+        TEST_ASSERT_LESS_THAN(30, stats.entry_cnt);
+
+        /*The most recently drawn shadow is in the cache*/
+        lv_draw_sw_shadow_cache_reset_stats();
+        lv_obj_invalidate(lv_obj_get_child(lv_scr_act(), -1));
+        lv_refr_now(NULL);
+        lv_draw_sw_shadow_cache_get_stats(&stats);
+        TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+
+        /*The first one was dropped*/
+        lv_draw_sw_shadow_cache_reset_stats();
+        lv_obj_invalidate(lv_obj_get_child(lv_scr_act(), 0));
+        lv_refr_now(NULL);
+        lv_draw_sw_shadow_cache_get_stats(&stats);
+        TEST_ASSERT_GREATER_THAN(0, stats.miss_cnt);
+    }
+
+    /*Drawn the same with the partly evicted cache*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+}
+
+#endif
@@ -0,0 +1,146 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+/*Odd sizes to have pixels left after the vectors*/
+#define BUF_W   77
+#define BUF_H   7
+
+static lv_color_t dest_ori[BUF_W * BUF_H];
+static lv_color_t dest_ref[BUF_W * BUF_H];
+static lv_color_t dest_simd[BUF_W * BUF_H];
+static lv_color_t src_buf[BUF_W * BUF_H];
+static lv_opa_t mask_buf[BUF_W * BUF_H];
+static lv_opa_t mask_tmp[BUF_W * BUF_H];
+static uint32_t rnd_state;
+static lv_disp_t * disp_refr_ori;
+static lv_draw_sw_simd_t simd_ori;
+
+static uint32_t rnd(void)
+{
+    /*xorshift32*/
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static lv_color_t rnd_color(void)
+{
+    lv_color_t c;
+    c.full = rnd();
+    return c;
+}
+
+void setUp(void)
+{
+    /*The blend functions get the display from here*/
+    disp_refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(lv_disp_get_default());
+    simd_ori = lv_draw_sw_blend_get_simd();
+    rnd_state = 0x12345678;
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_blend_set_simd(simd_ori);
+    _lv_refr_set_disp_refreshing(disp_refr_ori);
+}
+
+static void fill_buffers(void)
+{
+    uint32_t i;
+    lv_color_t c = rnd_color();
+    for(i = 0; i < BUF_W * BUF_H; i++) {
+        /*Repeat the colors sometimes as the scalar functions reuse the last result.
+         *Frame buffers are opaque so keep the alpha channel of the destination 0xFF*/
+        if(rnd() % 4 == 0) c = lv_color_hex(rnd());
+        dest_ori[i] = c;
+        src_buf[i] = rnd() % 4 == 0 && i > 0 ? src_buf[i - 1] : rnd_color();
+
+        uint32_t r = rnd() % 8;
+        if(r < 2) mask_buf[i] = LV_OPA_TRANSP;
+        else if(r < 4) mask_buf[i] = LV_OPA_COVER;
+        else if(r == 4) mask_buf[i] = LV_OPA_MAX + rnd() % 3;
+        else mask_buf[i] = rnd();
+    }
+}
+
+static void blend(lv_color_t * buf, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_area_t buf_area = {0, 0, BUF_W - 1, BUF_H - 1};
+    lv_draw_sw_ctx_t draw_ctx;
+    lv_memset_00(&draw_ctx, sizeof(draw_ctx));
+    draw_ctx.base_draw.buf = buf;
+    draw_ctx.base_draw.buf_area = &buf_area;
+    draw_ctx.base_draw.clip_area = &buf_area;
+
+    lv_memcpy(buf, dest_ori, sizeof(dest_ori));
+    lv_draw_sw_blend_basic((lv_draw_ctx_t *)&draw_ctx, dsc);
+}
+
+static void test_blend_modes(lv_draw_sw_simd_t simd)
+{
+    static const lv_blend_mode_t modes[] = {LV_BLEND_MODE_NORMAL, LV_BLEND_MODE_ADDITIVE,
+                                            LV_BLEND_MODE_SUBTRACTIVE, LV_BLEND_MODE_MULTIPLY
+                                           };
+    static const lv_opa_t opas[] = {LV_OPA_COVER, 254, LV_OPA_MAX, 252, 200, LV_OPA_50, 3, LV_OPA_MIN};
+
+    /*Not aligned to the buffer to have strides*/
+    lv_area_t blend_area = {3, 1, BUF_W - 2, BUF_H - 1};
+
+    uint32_t mode_i;
+    uint32_t opa_i;
+    uint32_t variant;
+    for(mode_i = 0; mode_i < sizeof(modes) / sizeof(modes[0]); mode_i++) {
+        for(opa_i = 0; opa_i < sizeof(opas) / sizeof(opas[0]); opa_i++) {
+            for(variant = 0; variant < 4; variant++) {
+                fill_buffers();
+
+                lv_draw_sw_blend_dsc_t dsc;
+                lv_memset_00(&dsc, sizeof(dsc));
+                dsc.blend_area = &blend_area;
+                dsc.src_buf = variant & 0x1 ? src_buf : NULL;
+                dsc.color = rnd_color();
+                dsc.opa = opas[opa_i];
+                dsc.blend_mode = modes[mode_i];
+                if(variant & 0x2) {
+                    dsc.mask_buf = mask_tmp;
+                    dsc.mask_area = &blend_area;
+                    dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+                }
+
+                lv_draw_sw_blend_set_simd(LV_DRAW_SW_SIMD_NONE);
+                lv_memcpy(mask_tmp, mask_buf, sizeof(mask_buf));
+                blend(dest_ref, &dsc);
+
+                lv_draw_sw_blend_set_simd(simd);
+                lv_memcpy(mask_tmp, mask_buf, sizeof(mask_buf));
+                blend(dest_simd, &dsc);
+
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "simd: %d, mode: %d, opa: %d, %s, %s", simd, modes[mode_i], opas[opa_i],
+                            variant & 0x1 ? "map" : "fill", variant & 0x2 ? "mask" : "no mask");
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(dest_ref, dest_simd, sizeof(dest_ref), msg);
+            }
+        }
+    }
+}
+
+void test_draw_sw_blend_simd_same_as_scalar(void)
+{
+    static const lv_draw_sw_simd_t simds[] = {LV_DRAW_SW_SIMD_SSE2, LV_DRAW_SW_SIMD_AVX2, LV_DRAW_SW_SIMD_NEON};
+
+    uint32_t i;
+    for(i = 0; i < sizeof(simds) / sizeof(simds[0]); i++) {
+        /*Skip the instruction sets the CPU doesn't have*/
+        lv_draw_sw_blend_set_simd(simds[i]);
+        if(lv_draw_sw_blend_get_simd() != simds[i]) continue;
+
+        test_blend_modes(simds[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,147 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    #define FONT_CACHE_ENABLED (LV_FONT_COMPRESSED_CACHE_SIZE > 0)
+#else
+    #define FONT_CACHE_ENABLED 0
+#endif
+
+#if FONT_CACHE_ENABLED
+static const lv_font_t * font = &lv_font_montserrat_28_compressed;
+#endif
+
+void setUp(void)
+{
+    lv_font_fmt_txt_cache_clear();
+    lv_font_fmt_txt_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_font_fmt_txt_cache_clear();
+}
+
+#if FONT_CACHE_ENABLED
+static uint32_t get_bitmap_size(uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, letter, 0));
+    /*3 bpp is decompressed to 4 bpp*/
+    uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;
+    return (g.box_w * g.box_h * bpp + 7) / 8;
+}
+#endif
+
+void test_font_fmt_txt_cache_hit_is_same_as_decompressed(void)
+{
+#if FONT_CACHE_ENABLED
+    static uint8_t ref[1024];
+    uint32_t letter;
+    for(letter = 'A'; letter <= 'D'; letter++) {
+        uint32_t size = get_bitmap_size(letter);
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(ref), size);
+
+        const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, letter);
+        TEST_ASSERT_NOT_NULL(bitmap);
+        lv_memcpy(ref, bitmap, size);
+
+        /*Get another glyph to overwrite the shared decompression buffer if the bitmap wasn't cached*/
+        lv_font_get_glyph_bitmap(font, 'x');
+
+        bitmap = lv_font_get_glyph_bitmap(font, letter);
+        TEST_ASSERT_EQUAL_MEMORY(ref, bitmap, size);
+    }
+
+    lv_font_fmt_txt_cache_stats_t stats;
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    /*'A'-'D' and 'x' are decompressed once*/
+    TEST_ASSERT_EQUAL(5, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(7, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(5, stats.entry_cnt);
+
+    /*Decompressed again after clearing the cache*/
+    lv_font_fmt_txt_cache_clear();
+    lv_font_get_glyph_bitmap(font, 'A');
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(6, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+#endif
+}
+
+void test_font_fmt_txt_cache_drops_least_recently_used(void)
+{
+#if FONT_CACHE_ENABLED
+    uint32_t letter;
+    for(letter = 'a'; letter <= 'z'; letter++) {
+        lv_font_get_glyph_bitmap(font, letter);
+        /*Keep using 'a'*/
+        lv_font_get_glyph_bitmap(font, 'a');
+    }
+
+    lv_font_fmt_txt_cache_stats_t stats;
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_FONT_COMPRESSED_CACHE_SIZE, stats.size);
+    TEST_ASSERT_LESS_THAN(26, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(26, stats.miss_cnt);
+
+    /*'a' and the last letters are still cached, the first ones are dropped*/
+    lv_font_fmt_txt_cache_reset_stats();
+    lv_font_get_glyph_bitmap(font, 'a');
+    lv_font_get_glyph_bitmap(font, 'z');
+    lv_font_get_glyph_bitmap(font, 'b');
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+#endif
+}
+
+void test_font_fmt_txt_cache_is_used_when_drawing(void)
+{
+#if FONT_CACHE_ENABLED
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "abab");
+
+    lv_refr_now(NULL);
+
+    lv_font_fmt_txt_cache_stats_t stats;
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(2, stats.hit_cnt);
+
+    lv_obj_del(label);
+#endif
+}
+
+void test_font_fmt_txt_cache_free_releases_the_bitmaps(void)
+{
+#if FONT_CACHE_ENABLED
+    _lv_font_clean_up_fmt_txt();
+    lv_mem_buf_free_all();
+    uint32_t mem_before = lv_test_get_free_mem();
+
+    uint32_t letter;
+    for(letter = 'a'; letter <= 'e'; letter++) {
+        lv_font_get_glyph_bitmap(font, letter);
+    }
+    _lv_font_clean_up_fmt_txt();
+    lv_mem_buf_free_all();
+
+    lv_font_fmt_txt_cache_stats_t stats;
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(5, stats.entry_cnt);
+
+    _lv_font_fmt_txt_cache_free();
+    lv_font_fmt_txt_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.size);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem()));
+#endif
+}
+
+#endif
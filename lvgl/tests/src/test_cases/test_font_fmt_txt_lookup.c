@@ -0,0 +1,129 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+/*Search the glyph id in the character maps as the font specification describes it*/
+static uint32_t ref_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(letter < cmap->range_start || letter >= cmap->range_start + cmap->range_length) continue;
+
+        uint32_t rcp = letter - cmap->range_start;
+        if(cmap->unicode_list == NULL) {
+            if(cmap->glyph_id_ofs_list == NULL) return cmap->glyph_id_start + rcp;
+            else return cmap->glyph_id_start + ((const uint8_t *)cmap->glyph_id_ofs_list)[rcp];
+        }
+
+        uint32_t j;
+        for(j = 0; j < cmap->list_length; j++) {
+            if(cmap->unicode_list[j] != rcp) continue;
+            if(cmap->glyph_id_ofs_list == NULL) return cmap->glyph_id_start + j;
+            else return cmap->glyph_id_start + ((const uint16_t *)cmap->glyph_id_ofs_list)[j];
+        }
+        return 0;
+    }
+    return 0;
+}
+
+static void test_glyph_ids(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    uint32_t letter;
+    for(letter = 1; letter < 0x10000; letter++) {
+        /*Plain fonts return the bitmaps from `glyph_bitmap` so they tell the glyph id*/
+        uint32_t gid = ref_glyph_id(fdsc, letter);
+        const uint8_t * bitmap_ref = gid ? &fdsc->glyph_bitmap[fdsc->glyph_dsc[gid].bitmap_index] : NULL;
+        if(letter == '\t') continue;
+
+        lv_font_glyph_dsc_t g;
+        TEST_ASSERT_EQUAL(gid != 0, lv_font_get_glyph_dsc(font, &g, letter, 0));
+        TEST_ASSERT_EQUAL_PTR(bitmap_ref, lv_font_get_glyph_bitmap(font, letter));
+    }
+}
+
+void test_font_fmt_txt_lookup_glyph_ids(void)
+{
+    test_glyph_ids(&lv_font_montserrat_14);
+#if LV_FONT_SIMSUN_16_CJK
+    test_glyph_ids(&lv_font_simsun_16_cjk);
+#endif
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    test_glyph_ids(&lv_font_dejavu_16_persian_hebrew);
+#endif
+#if LV_FONT_UNSCII_8
+    test_glyph_ids(&lv_font_unscii_8);
+#endif
+}
+
+void test_font_fmt_txt_lookup_kern_pairs(void)
+{
+    /*Montserrat with kerning pairs instead of classes*/
+    static lv_font_fmt_txt_dsc_t fdsc;
+    lv_memcpy(&fdsc, lv_font_montserrat_14.dsc, sizeof(fdsc));
+    lv_font_t font = lv_font_montserrat_14;
+    font.dsc = &fdsc;
+
+    /*Find a symbol whose glyph id is not in the kerning matrix*/
+    uint32_t symbol;
+    for(symbol = 0xF000; symbol < 0xF900; symbol++) {
+        if(ref_glyph_id(&fdsc, symbol) >= 130) break;
+    }
+    TEST_ASSERT_LESS_THAN(0xF900, symbol);
+
+    uint32_t gid_a = ref_glyph_id(&fdsc, 'A');
+    uint32_t gid_v = ref_glyph_id(&fdsc, 'V');
+    uint32_t gid_t = ref_glyph_id(&fdsc, 'T');
+    uint32_t gid_o = ref_glyph_id(&fdsc, 'o');
+    uint32_t gid_symbol = ref_glyph_id(&fdsc, symbol);
+    uint8_t glyph_ids[] = {gid_a, gid_v, gid_t, gid_o, gid_symbol, gid_a};
+    static const int8_t values[] = {-32, -16, -48};
+    lv_font_fmt_txt_kern_pair_t kern_pairs;
+    kern_pairs.glyph_ids = glyph_ids;
+    kern_pairs.values = values;
+    kern_pairs.pair_cnt = 3;
+    kern_pairs.glyph_ids_size = 0;
+
+    fdsc.kern_dsc = &kern_pairs;
+    fdsc.kern_classes = 0;
+    fdsc.kern_scale = 16;
+    fdsc.cache = NULL;
+
+    TEST_ASSERT_EQUAL(-2, lv_font_get_glyph_width(&font, 'A', 'V') - lv_font_get_glyph_width(&font, 'A', 'B'));
+    TEST_ASSERT_EQUAL(-1, lv_font_get_glyph_width(&font, 'T', 'o') - lv_font_get_glyph_width(&font, 'T', 'B'));
+    TEST_ASSERT_EQUAL(-3, lv_font_get_glyph_width(&font, symbol, 'A') - lv_font_get_glyph_width(&font, symbol, 'B'));
+    TEST_ASSERT_EQUAL(lv_font_get_glyph_width(&font, 'V', 'B'), lv_font_get_glyph_width(&font, 'V', 'A'));
+
+    _lv_font_fmt_txt_free_fast_lookup(&font);
+}
+
+void test_font_fmt_txt_lookup_free_all(void)
+{
+    _lv_font_fmt_txt_free_all_fast_lookup();
+    uint32_t mem_before = lv_test_get_free_mem();
+
+    /*The tables are built again after freeing them*/
+    test_glyph_ids(&lv_font_montserrat_14);
+#if LV_FONT_SIMSUN_16_CJK
+    test_glyph_ids(&lv_font_simsun_16_cjk);
+#endif
+    LV_HEAP_CHECK(TEST_ASSERT_LESS_THAN(mem_before, lv_test_get_free_mem()));
+
+    _lv_font_fmt_txt_free_all_fast_lookup();
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem()));
+}
+
+#endif
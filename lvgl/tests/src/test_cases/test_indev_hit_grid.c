@@ -0,0 +1,167 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * cont;
+
+void setUp(void)
+{
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 600, 400);
+    lv_obj_set_pos(cont, 20, 30);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Search by checking all the children*/
+static lv_obj_t * search_ref(lv_obj_t * obj, lv_point_t * point)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
+
+    lv_point_t p_trans = *point;
+    lv_obj_transform_point(obj, &p_trans, false, true);
+
+    if(_lv_area_is_point_on(&obj->coords, &p_trans, 0) || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        int32_t i;
+        for(i = lv_obj_get_child_cnt(obj) - 1; i >= 0; i--) {
+            lv_obj_t * found = search_ref(lv_obj_get_child(obj, i), &p_trans);
+            if(found) return found;
+        }
+    }
+
+    return lv_obj_hit_test(obj, &p_trans) ? obj : NULL;
+}
+
+static void check_all_points(void)
+{
+    lv_obj_update_layout(lv_scr_act());
+
+    lv_point_t p;
+    for(p.y = -5; p.y < 490; p.y += 3) {
+        for(p.x = -5; p.x < 810; p.x += 3) {
+            lv_obj_t * found = lv_indev_search_obj(lv_scr_act(), &p);
+            lv_obj_t * found_ref = search_ref(lv_scr_act(), &p);
+            if(found != found_ref) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "on %d;%d", (int)p.x, (int)p.y);
+                TEST_ASSERT_EQUAL_PTR_MESSAGE(found_ref, found, msg);
+            }
+        }
+    }
+}
+
+static void create_children(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = lv_obj_create(cont);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+        /*Some overlap*/
+        lv_obj_set_size(obj, 25 + (i % 7) * 5, 20 + (i % 5) * 6);
+        lv_obj_set_pos(obj, (i % 20) * 29 - 5, (i / 20) * 23 - 5);
+    }
+}
+
+void test_hit_grid_finds_the_same_as_checking_all(void)
+{
+    create_children(400);
+    check_all_points();
+
+#if LV_INDEV_HIT_GRID_MIN
+    TEST_ASSERT_NOT_NULL(cont->spec_attr->hit_grid);
+#endif
+
+    /*Move, resize, reorder and delete some children*/
+    uint32_t i;
+    for(i = 0; i < 400; i += 13) {
+        lv_obj_t * obj = lv_obj_get_child(cont, i);
+        lv_obj_set_pos(obj, (i * 7) % 550, (i * 11) % 350);
+        lv_obj_set_width(obj, 10 + i % 90);
+    }
+    lv_obj_move_to_index(lv_obj_get_child(cont, 5), -1);
+    lv_obj_swap(lv_obj_get_child(cont, 100), lv_obj_get_child(cont, 200));
+    lv_obj_del(lv_obj_get_child(cont, 50));
+    lv_obj_create(cont);
+    check_all_points();
+
+    /*Scroll the container*/
+    lv_obj_scroll_to(cont, 40, 70, LV_ANIM_OFF);
+    check_all_points();
+    lv_obj_scroll_by(cont, 15, -30, LV_ANIM_OFF);
+    check_all_points();
+
+    /*Move the container*/
+    lv_obj_set_pos(cont, 60, 10);
+    check_all_points();
+}
+
+void test_hit_grid_special_children(void)
+{
+    create_children(200);
+    check_all_points();
+
+    /*Floating children don't move when scrolling*/
+    lv_obj_t * floating = lv_obj_get_child(cont, 10);
+    lv_obj_add_flag(floating, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_size(floating, 50, 50);
+    lv_obj_scroll_to_y(cont, 60, LV_ANIM_OFF);
+    check_all_points();
+
+    /*Grandchildren out of the child can be found with overflow visible*/
+    lv_obj_t * overflow = lv_obj_get_child(cont, 20);
+    lv_obj_t * grandchild = lv_obj_create(overflow);
+    lv_obj_set_pos(grandchild, 40, 40);
+    lv_obj_set_size(grandchild, 30, 30);
+    check_all_points();
+    lv_obj_add_flag(overflow, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    check_all_points();
+
+    /*Extended click area*/
+    lv_obj_set_ext_click_area(lv_obj_get_child(cont, 30), 15);
+    check_all_points();
+
+    /*Transformed children*/
+    lv_obj_t * zoomed = lv_obj_get_child(cont, 40);
+    lv_obj_set_style_transform_zoom(zoomed, 512, 0);
+    lv_obj_set_style_transform_angle(zoomed, 300, 0);
+    check_all_points();
+    lv_obj_set_style_transform_zoom(zoomed, 256, 0);
+    lv_obj_set_style_transform_angle(zoomed, 0, 0);
+    check_all_points();
+
+    /*Hidden and a large child*/
+    lv_obj_add_flag(lv_obj_get_child(cont, 50), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_size(lv_obj_get_child(cont, 60), 500, 300);
+    check_all_points();
+}
+
+void test_hit_grid_with_layout(void)
+{
+    create_children(300);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    check_all_points();
+
+    lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_START);
+    lv_obj_set_style_pad_column(cont, 7, 0);
+    check_all_points();
+
+    lv_obj_scroll_to_y(cont, 200, LV_ANIM_OFF);
+    check_all_points();
+
+    lv_obj_set_layout(cont, LV_LAYOUT_GRID);
+    static lv_coord_t col_dsc[] = {80, 80, 80, 80, 80, 80, 80, LV_GRID_TEMPLATE_LAST};
+    static lv_coord_t row_dsc[] = {30, 30, 30, 30, 30, 30, 30, 30, 30, 30, LV_GRID_TEMPLATE_LAST};
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+    uint32_t i;
+    for(i = 0; i < 70; i++) {
+        lv_obj_set_grid_cell(lv_obj_get_child(cont, i), LV_GRID_ALIGN_STRETCH, i % 7, 1, LV_GRID_ALIGN_START, i / 7, 1);
+    }
+    check_all_points();
+}
+
+#endif
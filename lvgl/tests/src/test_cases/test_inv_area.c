@@ -0,0 +1,116 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+static uint8_t flushed[VER_RES][HOR_RES];
+static uint32_t flushed_px;
+static void (*flush_cb_ori)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+static void record_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        for(x = area->x1; x <= area->x2; x++) {
+            flushed[y][x] = 1;
+        }
+    }
+    flushed_px += lv_area_get_size(area);
+
+    flush_cb_ori(disp_drv, area, color_p);
+}
+
+void setUp(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_refr_now(disp);
+
+    lv_memset_00(flushed, sizeof(flushed));
+    flushed_px = 0;
+    flush_cb_ori = disp->driver->flush_cb;
+    disp->driver->flush_cb = record_flush_cb;
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->flush_cb = flush_cb_ori;
+}
+
+static void assert_flushed(const lv_area_t * area)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        for(x = area->x1; x <= area->x2; x++) {
+            TEST_ASSERT_EQUAL_MESSAGE(1, flushed[y][x], "an invalidated pixel is not redrawn");
+        }
+    }
+}
+
+void test_inv_area_few_areas_are_redrawn_exactly(void)
+{
+    lv_area_t a1 = {10, 10, 29, 19};
+    lv_area_t a2 = {500, 300, 505, 302};
+    _lv_inv_area(NULL, &a1);
+    _lv_inv_area(NULL, &a2);
+    lv_refr_now(NULL);
+
+    assert_flushed(&a1);
+    assert_flushed(&a2);
+    TEST_ASSERT_EQUAL(lv_area_get_size(&a1) + lv_area_get_size(&a2), flushed_px);
+}
+
+void test_inv_area_many_small_areas_are_not_a_full_redraw(void)
+{
+    /*E.g. the points of a chart and a few list items*/
+    static lv_area_t areas[300];
+    uint32_t i;
+    for(i = 0; i < 250; i++) {
+        lv_coord_t x = 100 + i * 2;
+        lv_coord_t y = 200 + ((i * 7) % 60);
+        lv_area_set(&areas[i], x, y, x + 3, y + 3);
+    }
+    for(; i < 300; i++) {
+        lv_coord_t y = 320 + (i - 250) * 3;
+        lv_area_set(&areas[i], 20, y, 220, y + 1);
+    }
+
+    for(i = 0; i < 300; i++) {
+        _lv_inv_area(NULL, &areas[i]);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(LV_INV_BUF_SIZE, lv_disp_get_default()->inv_p);
+
+    lv_refr_now(NULL);
+
+    for(i = 0; i < 300; i++) {
+        assert_flushed(&areas[i]);
+    }
+    TEST_ASSERT_LESS_THAN(HOR_RES * VER_RES / 2, flushed_px);
+}
+
+void test_inv_area_scattered_areas_are_redrawn(void)
+{
+    uint32_t rnd = 12345;
+    static lv_area_t areas[500];
+    uint32_t i;
+    for(i = 0; i < 500; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        lv_coord_t x = (rnd >> 8) % (HOR_RES - 10);
+        rnd = rnd * 1103515245 + 12345;
+        lv_coord_t y = (rnd >> 8) % (VER_RES - 10);
+        lv_area_set(&areas[i], x, y, x + (i % 10), y + (i % 7));
+        _lv_inv_area(NULL, &areas[i]);
+    }
+
+    lv_refr_now(NULL);
+
+    for(i = 0; i < 500; i++) {
+        assert_flushed(&areas[i]);
+    }
+}
+
+#endif
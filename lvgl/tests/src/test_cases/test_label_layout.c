@@ -0,0 +1,140 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+static char long_txt[2048];
+static lv_color_t screen[VER_RES][HOR_RES];
+static void (*flush_cb_ori)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+static void record_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    const lv_color_t * px = color_p;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&screen[y][area->x1], px, lv_area_get_width(area) * sizeof(lv_color_t));
+        px += lv_area_get_width(area);
+    }
+
+    flush_cb_ori(disp_drv, area, color_p);
+}
+
+void setUp(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    flush_cb_ori = disp->driver->flush_cb;
+    disp->driver->flush_cb = record_flush_cb;
+
+    /*Lines of different length, some of them are wrapped*/
+    long_txt[0] = '\0';
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        const char * words = (i % 3) == 0 ? "Lorem ipsum dolor sit amet, consectetur adipiscing elit" : "Short line";
+        lv_snprintf(&long_txt[strlen(long_txt)], sizeof(long_txt) - strlen(long_txt), "%d. %s\n", (int)i, words);
+    }
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->flush_cb = flush_cb_ori;
+    lv_obj_clean(lv_scr_act());
+}
+
+static void test_size(const char * txt, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_draw_label_layout_t layout;
+    lv_draw_label_layout_init(&layout);
+
+    lv_point_t size;
+    lv_point_t size_ref;
+    TEST_ASSERT_TRUE(lv_draw_label_layout_update(&layout, txt, &lv_font_montserrat_14, 1, 3, max_w, flag,
+                                                 LV_BASE_DIR_LTR, &size));
+    lv_txt_get_size(&size_ref, txt, &lv_font_montserrat_14, 1, 3, max_w, flag);
+    TEST_ASSERT_EQUAL(size_ref.x, size.x);
+    TEST_ASSERT_EQUAL(size_ref.y, size.y);
+
+    lv_draw_label_layout_free(&layout);
+}
+
+void test_label_layout_size_is_same_as_txt_size(void)
+{
+    test_size(long_txt, 150, LV_TEXT_FLAG_NONE);
+    test_size(long_txt, 150, LV_TEXT_FLAG_EXPAND);
+    test_size(long_txt, 150, LV_TEXT_FLAG_FIT);
+    test_size("Line 1\nLine 2\n", 150, LV_TEXT_FLAG_NONE);
+    test_size("Line 1\r\n", 150, LV_TEXT_FLAG_NONE);
+    test_size("", 150, LV_TEXT_FLAG_NONE);
+}
+
+void test_label_layout_is_kept_only_for_long_texts(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 150);
+    lv_label_t * label_p = (lv_label_t *)label;
+
+    lv_label_set_text(label, "Line 1\nLine 2");
+    TEST_ASSERT_NULL(label_p->layout.lines);
+
+    lv_label_set_text(label, long_txt);
+    TEST_ASSERT_NOT_NULL(label_p->layout.lines);
+    TEST_ASSERT_GREATER_THAN(40, label_p->layout.line_cnt);
+    TEST_ASSERT_EQUAL_PTR(label_p->text, label_p->layout.txt);
+
+    /*The text is measured again with the new width*/
+    lv_obj_set_width(label, 300);
+    lv_obj_update_layout(label);
+    TEST_ASSERT_EQUAL(300, label_p->layout.max_w);
+}
+
+static void test_draw(const lv_font_t * font, lv_text_align_t align, lv_base_dir_t base_dir, const char * txt)
+{
+    /*Show only some lines of the label to draw with a clipped area*/
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 200, 120);
+    lv_obj_t * label = lv_label_create(cont);
+    lv_obj_set_width(label, 160);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_set_style_text_align(label, align, 0);
+    lv_obj_set_style_base_dir(label, base_dir, 0);
+    lv_label_set_text(label, txt);
+    lv_obj_update_layout(cont);
+    lv_obj_scroll_to_y(cont, 250, LV_ANIM_OFF);
+    TEST_ASSERT_NOT_NULL(((lv_label_t *)label)->layout.lines);
+
+    static lv_color_t screen_ref[VER_RES][HOR_RES];
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(screen_ref, screen, sizeof(screen));
+
+    /*Draw without the layout as well*/
+    lv_draw_label_layout_free(&((lv_label_t *)label)->layout);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(screen_ref, screen, sizeof(screen));
+
+    lv_obj_del(cont);
+}
+
+void test_label_layout_draws_the_same_as_without_it(void)
+{
+    test_draw(&lv_font_montserrat_14, LV_TEXT_ALIGN_LEFT, LV_BASE_DIR_LTR, long_txt);
+    test_draw(&lv_font_montserrat_14, LV_TEXT_ALIGN_CENTER, LV_BASE_DIR_LTR, long_txt);
+    test_draw(&lv_font_montserrat_14, LV_TEXT_ALIGN_RIGHT, LV_BASE_DIR_LTR, long_txt);
+
+#if LV_USE_BIDI && LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    static char bidi_txt[2048];
+    bidi_txt[0] = '\0';
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_snprintf(&bidi_txt[strlen(bidi_txt)], sizeof(bidi_txt) - strlen(bidi_txt),
+                    "%d. \xd7\xa9\xd7\x9c\xd7\x95\xd7\x9d abc \xd7\xa2\xd7\x95\xd7\x9c\xd7\x9d (%d)\n", (int)i, (int)i * 7);
+    }
+    test_draw(&lv_font_dejavu_16_persian_hebrew, LV_TEXT_ALIGN_AUTO, LV_BASE_DIR_RTL, bidi_txt);
+    test_draw(&lv_font_dejavu_16_persian_hebrew, LV_TEXT_ALIGN_CENTER, LV_BASE_DIR_AUTO, bidi_txt);
+#endif
+}
+
+#endif
@@ -0,0 +1,128 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static void count_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+static lv_obj_t * create_item(lv_obj_t * parent, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+static lv_obj_t * create_list(lv_coord_t x)
+{
+    lv_obj_t * list = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(list);
+    lv_obj_set_pos(list, x, 0);
+    lv_obj_set_size(list, 200, 400);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(list, 5, 0);
+
+    uint32_t i;
+    for(i = 0; i < 50; i++) create_item(list, LV_PCT(100), 20);
+
+    return list;
+}
+
+void test_layout_update_only_the_changed_containers(void)
+{
+    lv_obj_t * list1 = create_list(0);
+    lv_obj_t * list2 = create_list(300);
+    lv_obj_update_layout(lv_scr_act());
+
+    uint32_t cnt1 = 0;
+    uint32_t cnt2 = 0;
+    lv_obj_add_event_cb(list1, count_event_cb, LV_EVENT_LAYOUT_CHANGED, &cnt1);
+    lv_obj_add_event_cb(list2, count_event_cb, LV_EVENT_LAYOUT_CHANGED, &cnt2);
+
+    /*Nothing to do*/
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, cnt1);
+    TEST_ASSERT_EQUAL(0, cnt2);
+
+    /*Append an item to the first list*/
+    lv_obj_t * item = create_item(list1, LV_PCT(100), 30);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, cnt1);
+    TEST_ASSERT_EQUAL(0, cnt2);
+    TEST_ASSERT_EQUAL(50 * 25, item->coords.y1);
+    TEST_ASSERT_EQUAL(200, lv_obj_get_width(item));
+
+    /*Resize a nested item in the second list*/
+    lv_obj_t * item2 = lv_obj_get_child(list2, 10);
+    lv_obj_set_height(item2, 40);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, cnt1);
+    TEST_ASSERT_EQUAL(1, cnt2);
+    TEST_ASSERT_EQUAL(11 * 25 + 20, lv_obj_get_child(list2, 11)->coords.y1);
+
+    /*Resize both lists. The items' width is in percentage so they are updated too*/
+    lv_obj_set_width(list1, 150);
+    lv_obj_set_width(list2, 150);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_GREATER_THAN(1, cnt1);
+    TEST_ASSERT_EQUAL(cnt1, cnt2);
+    TEST_ASSERT_EQUAL(150, lv_obj_get_width(item));
+    TEST_ASSERT_EQUAL(150, lv_obj_get_width(item2));
+}
+
+void test_layout_update_flex_grow_on_tracks(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER);
+
+    lv_obj_t * a = create_item(cont, 100, 20);
+    lv_obj_t * b = create_item(cont, 10, 20);
+    lv_obj_set_flex_grow(b, 1);
+    lv_obj_t * c = create_item(cont, 100, 20);
+    lv_obj_t * d = create_item(cont, 150, 30);
+    lv_obj_add_flag(d, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK);
+    lv_obj_t * e = create_item(cont, 10, 20);
+    lv_obj_set_flex_grow(e, 2);
+    lv_obj_t * f = create_item(cont, 10, 20);
+    lv_obj_set_flex_grow(f, 1);
+    lv_obj_update_layout(lv_scr_act());
+
+    /*The tracks are 20 and 30 px high in the middle*/
+    TEST_ASSERT_EQUAL(0, a->coords.x1);
+    TEST_ASSERT_EQUAL(75, a->coords.y1);
+    TEST_ASSERT_EQUAL(100, b->coords.x1);
+    TEST_ASSERT_EQUAL(100, lv_obj_get_width(b));
+    TEST_ASSERT_EQUAL(200, c->coords.x1);
+    TEST_ASSERT_EQUAL(0, d->coords.x1);
+    TEST_ASSERT_EQUAL(95, d->coords.y1);
+    TEST_ASSERT_EQUAL(150, e->coords.x1);
+    TEST_ASSERT_EQUAL(100, lv_obj_get_width(e));
+    TEST_ASSERT_EQUAL(250, f->coords.x1);
+    TEST_ASSERT_EQUAL(50, lv_obj_get_width(f));
+
+    /*A max. width leaves more space for the other grow item*/
+    lv_obj_set_style_max_width(e, 60, 0);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(60, lv_obj_get_width(e));
+    TEST_ASSERT_EQUAL(210, f->coords.x1);
+    TEST_ASSERT_EQUAL(90, lv_obj_get_width(f));
+}
+
+#endif
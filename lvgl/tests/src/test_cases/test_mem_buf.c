@@ -0,0 +1,130 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    lv_mem_buf_free_all();
+}
+
+void tearDown(void)
+{
+    lv_mem_buf_free_all();
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_mem_buf_reuses_buffers_of_the_bucket(void)
+{
+    uint8_t * p1 = lv_mem_buf_get(100);
+    uint8_t * p2 = lv_mem_buf_get(100);
+    TEST_ASSERT_NOT_NULL(p1);
+    TEST_ASSERT_NOT_NULL(p2);
+    TEST_ASSERT_NOT_EQUAL(p1, p2);
+    lv_memset_ff(p1, 100);
+    lv_memset_ff(p2, 100);
+
+    /*Any size up to 128 bytes can use the same buffer*/
+    lv_mem_buf_release(p1);
+    TEST_ASSERT_EQUAL_PTR(p1, lv_mem_buf_get(128));
+    lv_mem_buf_release(p1);
+    TEST_ASSERT_EQUAL_PTR(p1, lv_mem_buf_get(65));
+
+    /*The larger buffer is used if there is no other*/
+    lv_mem_buf_release(p2);
+    TEST_ASSERT_EQUAL_PTR(p2, lv_mem_buf_get(10));
+
+    /*Too large*/
+    lv_mem_buf_release(p2);
+    uint8_t * p3 = lv_mem_buf_get(129);
+    TEST_ASSERT_NOT_EQUAL(p2, p3);
+    lv_memset_ff(p3, 129);
+
+    lv_mem_buf_release(p1);
+    lv_mem_buf_release(p3);
+}
+
+void test_mem_buf_drops_not_used_buffers(void)
+{
+    void * p[LV_MEM_BUF_MAX_NUM];
+    uint32_t i;
+    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        p[i] = lv_mem_buf_get(32 + i * 32);
+        TEST_ASSERT_NOT_NULL(p[i]);
+    }
+
+    /*No free entry so the memory of a not used buffer is dropped*/
+    lv_mem_buf_release(p[3]);
+    uint8_t * big = lv_mem_buf_get(5000);
+    TEST_ASSERT_NOT_NULL(big);
+    lv_memset_ff(big, 5000);
+
+    /*The dropped buffer is not known anymore, the new one is*/
+    lv_mem_buf_release(big);
+    TEST_ASSERT_EQUAL_PTR(big, lv_mem_buf_get(4097));
+
+    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(i != 3) lv_mem_buf_release(p[i]);
+    }
+    lv_mem_buf_release(big);
+}
+
+void test_mem_buf_uses_the_arena_after_a_refresh(void)
+{
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT(lv_mem_buf);
+
+    void * p1 = lv_mem_buf_get(1000);
+    void * p2 = lv_mem_buf_get(3000);
+    TEST_ASSERT_EQUAL(1024 + 4096, pool->frame_size);
+    TEST_ASSERT_NULL(pool->arena);
+    lv_mem_buf_release(p1);
+    lv_mem_buf_release(p2);
+
+    /*The next arena is as large as the buffers were*/
+    lv_mem_buf_free_all();
+    TEST_ASSERT_EQUAL(1024 + 4096, pool->arena_size);
+    TEST_ASSERT_EQUAL(0, pool->frame_size);
+    TEST_ASSERT_GREATER_OR_EQUAL(1024 + 4096, pool->frame_size_max);
+
+    uint8_t * a1 = lv_mem_buf_get(4000);
+    uint8_t * a2 = lv_mem_buf_get(600);
+    TEST_ASSERT_EQUAL_PTR(pool->arena, a1);
+    TEST_ASSERT_EQUAL_PTR(pool->arena + 4096, a2);
+
+    /*Doesn't fit into the arena*/
+    uint8_t * h = lv_mem_buf_get(600);
+    TEST_ASSERT_TRUE(h < pool->arena || h >= pool->arena + pool->arena_size);
+    lv_mem_buf_release(a1);
+    lv_mem_buf_release(a2);
+    lv_mem_buf_release(h);
+
+    lv_mem_buf_free_all();
+    TEST_ASSERT_EQUAL(4096 + 1024 + 1024, pool->arena_size);
+}
+
+void test_mem_buf_frees_everything_at_refresh(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Some text to draw");
+    lv_obj_set_style_shadow_width(label, 20, 0);
+    lv_obj_set_style_radius(label, 10, 0);
+    lv_obj_set_style_bg_opa(label, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+
+    /*The arena is freed too*/
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT(lv_mem_buf);
+    TEST_ASSERT_NULL(pool->arena);
+    TEST_ASSERT_EQUAL(0, pool->buf_cnt);
+    TEST_ASSERT_GREATER_THAN(0, pool->arena_size);
+
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor(&mon1);
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon2);
+    TEST_ASSERT_EQUAL(mon1.free_size, mon2.free_size);
+}
+
+#endif
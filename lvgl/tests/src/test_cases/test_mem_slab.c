@@ -0,0 +1,151 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_MEM_CUSTOM == 0
+    #define SLAB_ENABLED (LV_MEM_SLAB_SIZE >= 1024)
+#else
+    #define SLAB_ENABLED 0
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+#if SLAB_ENABLED
+static lv_mem_monitor_t get_mon(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon;
+}
+#endif
+
+void test_mem_slab_serves_small_allocations(void)
+{
+#if SLAB_ENABLED
+    lv_mem_monitor_t mon_start = get_mon();
+    TEST_ASSERT_EQUAL(LV_MEM_SLAB_SIZE, mon_start.slab_size);
+
+    void * p[10];
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        p[i] = lv_mem_alloc(40);
+        TEST_ASSERT_NOT_NULL(p[i]);
+        lv_memset(p[i], i, 40);
+    }
+
+    lv_mem_monitor_t mon = get_mon();
+    TEST_ASSERT_EQUAL(mon_start.slab_used + 10 * 40, mon.slab_used);
+    TEST_ASSERT_EQUAL(mon_start.free_size - 10 * 40, mon.free_size);
+    TEST_ASSERT_EQUAL(mon_start.used_cnt + 10, mon.used_cnt);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+
+    for(i = 0; i < 10; i++) lv_mem_free(p[i]);
+
+    mon = get_mon();
+    TEST_ASSERT_EQUAL(mon_start.slab_used, mon.slab_used);
+    TEST_ASSERT_EQUAL(mon_start.free_size, mon.free_size);
+#endif
+}
+
+void test_mem_slab_reuses_freed_slots(void)
+{
+#if SLAB_ENABLED
+    void * p1 = lv_mem_alloc(56);
+    void * p2 = lv_mem_alloc(50);
+    lv_mem_free(p1);
+    TEST_ASSERT_EQUAL_PTR(p1, lv_mem_alloc(49));
+
+    lv_mem_free(p1);
+    lv_mem_free(p2);
+#endif
+}
+
+void test_mem_slab_realloc_keeps_the_content(void)
+{
+#if SLAB_ENABLED
+    lv_mem_monitor_t mon_start = get_mon();
+
+    uint8_t * p = lv_mem_alloc(16);
+    uint32_t i;
+    for(i = 0; i < 16; i++) p[i] = i;
+
+    /*Fits into the slot*/
+    TEST_ASSERT_EQUAL_PTR(p, lv_mem_realloc(p, 10));
+    TEST_ASSERT_EQUAL_PTR(p, lv_mem_realloc(p, 16));
+
+    /*Moved to a larger slot*/
+    p = lv_mem_realloc(p, 100);
+    TEST_ASSERT_NOT_NULL(p);
+    for(i = 0; i < 16; i++) TEST_ASSERT_EQUAL(i, p[i]);
+    TEST_ASSERT_EQUAL(mon_start.slab_used + 112, get_mon().slab_used);
+
+    /*Moved out of the slab*/
+    p = lv_mem_realloc(p, 1000);
+    TEST_ASSERT_NOT_NULL(p);
+    for(i = 0; i < 16; i++) TEST_ASSERT_EQUAL(i, p[i]);
+    TEST_ASSERT_EQUAL(mon_start.slab_used, get_mon().slab_used);
+
+    /*Stays out of the slab when shrinking*/
+    p = lv_mem_realloc(p, 20);
+    TEST_ASSERT_EQUAL(mon_start.slab_used, get_mon().slab_used);
+
+    lv_mem_free(p);
+    TEST_ASSERT_EQUAL(mon_start.free_size, get_mon().free_size);
+#endif
+}
+
+void test_mem_slab_falls_back_when_full(void)
+{
+#if SLAB_ENABLED
+    static void * p[LV_MEM_SLAB_SIZE / 64 + 10];
+    lv_mem_monitor_t mon_start = get_mon();
+
+    /*Fill the slab. Some pages might be used by other classes.*/
+    uint32_t cnt;
+    for(cnt = 0; cnt < sizeof(p) / sizeof(p[0]); cnt++) {
+        p[cnt] = lv_mem_alloc(64);
+        TEST_ASSERT_NOT_NULL(p[cnt]);
+        if(get_mon().slab_fallback_cnt > mon_start.slab_fallback_cnt) break;
+    }
+    TEST_ASSERT_LESS_THAN(sizeof(p) / sizeof(p[0]), cnt);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+
+    /*A freed slot is used again*/
+    lv_mem_free(p[0]);
+    p[0] = lv_mem_alloc(60);
+    TEST_ASSERT_EQUAL(mon_start.slab_fallback_cnt + 1, get_mon().slab_fallback_cnt);
+
+    uint32_t i;
+    for(i = 0; i <= cnt; i++) lv_mem_free(p[i]);
+
+    lv_mem_monitor_t mon = get_mon();
+    TEST_ASSERT_EQUAL(mon_start.slab_used, mon.slab_used);
+    TEST_ASSERT_EQUAL(mon_start.free_size, mon.free_size);
+#endif
+}
+
+void test_mem_slab_is_used_by_widgets(void)
+{
+#if SLAB_ENABLED
+    /*Let the screen allocate what it keeps for its children*/
+    lv_obj_del(lv_obj_create(lv_scr_act()));
+    lv_mem_monitor_t mon_start = get_mon();
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    TEST_ASSERT_GREATER_THAN(mon_start.slab_used, get_mon().slab_used);
+
+    lv_obj_del(obj);
+    TEST_ASSERT_EQUAL(mon_start.slab_used, get_mon().slab_used);
+#endif
+}
+
+#endif
@@ -0,0 +1,185 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_style_t style_main;
+static lv_style_t style_pressed;
+
+void setUp(void)
+{
+    lv_style_init(&style_main);
+    lv_style_init(&style_pressed);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style_main);
+    lv_style_reset(&style_pressed);
+}
+
+static lv_obj_t * create_obj(lv_obj_t * parent)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style_main, 0);
+    lv_obj_add_style(obj, &style_pressed, LV_STATE_PRESSED);
+    return obj;
+}
+
+void test_obj_style_cache_changed_styles(void)
+{
+    lv_style_set_bg_opa(&style_main, LV_OPA_50);
+    lv_obj_t * obj = create_obj(lv_scr_act());
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, 0));
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, 0));
+
+    /*Changing a shared style without reporting it*/
+    lv_style_set_bg_opa(&style_main, LV_OPA_70);
+    TEST_ASSERT_EQUAL(LV_OPA_70, lv_obj_get_style_bg_opa(obj, 0));
+    lv_style_remove_prop(&style_main, LV_STYLE_BG_OPA);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, 0));
+
+    /*Local styles*/
+    lv_obj_set_style_bg_opa(obj, LV_OPA_20, 0);
+    TEST_ASSERT_EQUAL(LV_OPA_20, lv_obj_get_style_bg_opa(obj, 0));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_OPA, 0);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, 0));
+
+    /*Adding and removing a style*/
+    static lv_style_t style_other;
+    lv_style_init(&style_other);
+    lv_style_set_bg_opa(&style_other, LV_OPA_40);
+    lv_obj_add_style(obj, &style_other, 0);
+    TEST_ASSERT_EQUAL(LV_OPA_40, lv_obj_get_style_bg_opa(obj, 0));
+    lv_obj_remove_style(obj, &style_other, 0);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, 0));
+    lv_style_reset(&style_other);
+
+    /*Other parts of the same object*/
+    lv_obj_set_style_bg_opa(obj, LV_OPA_30, LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL(LV_OPA_30, lv_obj_get_style_bg_opa(obj, LV_PART_SCROLLBAR));
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, 0));
+}
+
+void test_obj_style_cache_state_and_inheritance(void)
+{
+    lv_style_set_text_color(&style_main, lv_color_hex(0xff0000));
+    lv_style_set_text_color(&style_pressed, lv_color_hex(0x0000ff));
+    lv_obj_t * parent = create_obj(lv_scr_act());
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_remove_style_all(child);
+
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(child, 0).full);
+
+    /*The child inherits the color of the parent's new state*/
+    lv_obj_add_state(parent, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x0000ff).full, lv_obj_get_style_text_color(parent, 0).full);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x0000ff).full, lv_obj_get_style_text_color(child, 0).full);
+    lv_obj_clear_state(parent, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(child, 0).full);
+
+    /*Inheriting from a new parent*/
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x00ff00), 0);
+    lv_obj_set_parent(child, parent2);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x00ff00).full, lv_obj_get_style_text_color(child, 0).full);
+}
+
+void test_obj_style_cache_invalidates_only_the_changed_objects(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    lv_obj_t * obj1 = create_obj(lv_scr_act());
+    lv_obj_t * obj2 = create_obj(lv_scr_act());
+    lv_obj_t * child = lv_obj_create(obj1);
+    lv_obj_remove_style_all(child);
+    uint32_t version = _lv_style_get_version();
+    uint32_t stamp2 = obj2->style_cache_stamp;
+    uint32_t stamp_child = child->style_cache_stamp;
+
+    /*A local property which is not inherited changes only its object*/
+    lv_obj_set_style_bg_opa(obj1, LV_OPA_20, 0);
+    TEST_ASSERT_EQUAL(LV_OPA_20, lv_obj_get_style_bg_opa(obj1, 0));
+    TEST_ASSERT_EQUAL(version, _lv_style_get_version());
+    TEST_ASSERT_EQUAL(stamp2, obj2->style_cache_stamp);
+    TEST_ASSERT_EQUAL(stamp_child, child->style_cache_stamp);
+
+    /*An inherited one changes the children too*/
+    TEST_ASSERT_NOT_EQUAL(lv_color_hex(0x00ff00).full, lv_obj_get_style_text_color(child, 0).full);
+    lv_obj_set_style_text_color(obj1, lv_color_hex(0x00ff00), 0);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_hex(0x00ff00).full, lv_obj_get_style_text_color(child, 0).full);
+    TEST_ASSERT_NOT_EQUAL(stamp_child, child->style_cache_stamp);
+    TEST_ASSERT_EQUAL(stamp2, obj2->style_cache_stamp);
+
+    /*States*/
+    lv_style_set_bg_opa(&style_pressed, LV_OPA_80);
+    lv_obj_remove_local_style_prop(obj1, LV_STYLE_BG_OPA, 0);
+    stamp2 = obj2->style_cache_stamp;
+    lv_obj_add_state(obj1, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_80, lv_obj_get_style_bg_opa(obj1, 0));
+    TEST_ASSERT_EQUAL(stamp2, obj2->style_cache_stamp);
+
+    /*Only the shared styles change the version*/
+    TEST_ASSERT_EQUAL(version + 1, _lv_style_get_version());
+#endif
+}
+
+void test_obj_style_cache_new_object_on_the_same_address(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_border_width(obj, 7, 0);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_border_width(obj, 0));
+    lv_obj_del(obj);
+
+    /*Probably allocated at the same address*/
+    obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, 0));
+}
+
+void test_obj_style_cache_temporary_state(void)
+{
+    lv_style_set_bg_opa(&style_main, LV_OPA_50);
+    lv_style_set_bg_opa(&style_pressed, LV_OPA_80);
+    lv_obj_t * obj = create_obj(lv_scr_act());
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, 0));
+
+    /*Widgets change the state while drawing some parts in an other state*/
+    obj->skip_trans = 1;
+    obj->state = LV_STATE_PRESSED;
+    TEST_ASSERT_EQUAL(LV_OPA_80, lv_obj_get_style_bg_opa(obj, 0));
+    obj->state = LV_STATE_DEFAULT;
+    obj->skip_trans = 0;
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, 0));
+}
+
+void test_obj_style_cache_transition(void)
+{
+    static const lv_style_prop_t props[] = {LV_STYLE_BG_OPA, 0};
+    static lv_style_transition_dsc_t tr;
+    lv_style_transition_dsc_init(&tr, props, lv_anim_path_linear, 100, 0, NULL);
+    lv_style_set_transition(&style_pressed, &tr);
+    lv_style_set_bg_opa(&style_main, 0);
+    lv_style_set_bg_opa(&style_pressed, 200);
+    lv_obj_t * obj = create_obj(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_bg_opa(obj, 0));
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_bg_opa(obj, 0));
+
+    /*Every step of the animation is read*/
+    lv_opa_t opa_prev = 0;
+    uint32_t i;
+    for(i = 0; i < 15; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+        lv_opa_t opa = lv_obj_get_style_bg_opa(obj, 0);
+        TEST_ASSERT_GREATER_OR_EQUAL(opa_prev, opa);
+        if(i == 4) TEST_ASSERT_LESS_THAN(200, opa);
+        opa_prev = opa;
+    }
+    TEST_ASSERT_EQUAL(200, lv_obj_get_style_bg_opa(obj, 0));
+}
+
+#endif
@@ -106,4 +106,100 @@ void test_inherit_meta_with_lower_precedence_style(void)
     TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(grandchild, LV_PART_MAIN).full);
 }
 
+void test_frozen_style(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, lv_color_hex(0x112233));
+    lv_style_set_radius(&style, 5);
+    lv_style_set_transform_pivot_y(&style, 17);    /*The last built-in property*/
+    lv_style_set_width(&style, 100);
+    lv_style_set_text_opa(&style, LV_OPA_50);
+    lv_style_set_prop_meta(&style, LV_STYLE_TEXT_COLOR, LV_STYLE_PROP_META_INHERIT);
+    lv_style_set_prop_meta(&style, LV_STYLE_BORDER_WIDTH, LV_STYLE_PROP_META_INITIAL);
+
+    /*Get all the properties before freezing*/
+    lv_style_res_t res_ref[_LV_STYLE_NUM_BUILT_IN_PROPS];
+    lv_style_value_t v_ref[_LV_STYLE_NUM_BUILT_IN_PROPS];
+    uint32_t i;
+    for(i = 0; i < _LV_STYLE_NUM_BUILT_IN_PROPS; i++) {
+        v_ref[i].num = 0;
+        res_ref[i] = lv_style_get_prop(&style, i, &v_ref[i]);
+    }
+
+    TEST_ASSERT_TRUE(lv_style_freeze(&style));
+    TEST_ASSERT_FALSE(lv_style_is_empty(&style));
+    for(i = 0; i < _LV_STYLE_NUM_BUILT_IN_PROPS; i++) {
+        lv_style_value_t v = {.num = 0};
+        TEST_ASSERT_EQUAL(res_ref[i], lv_style_get_prop(&style, i, &v));
+        TEST_ASSERT_EQUAL(v_ref[i].num, v.num);
+    }
+
+    /*Frozen styles can't be changed*/
+    lv_style_set_radius(&style, 10);
+    TEST_ASSERT_FALSE(lv_style_remove_prop(&style, LV_STYLE_WIDTH));
+    lv_style_value_t v;
+    lv_style_get_prop(&style, LV_STYLE_RADIUS, &v);
+    TEST_ASSERT_EQUAL(5, v.num);
+
+    /*Used by an object*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_add_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL(100, lv_obj_get_style_width(obj, 0));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, 0));
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x112233).full, lv_obj_get_style_bg_color(obj, 0).full);
+    lv_obj_del(obj);
+
+    lv_style_reset(&style);
+    TEST_ASSERT_TRUE(lv_style_is_empty(&style));
+    lv_style_set_radius(&style, 10);
+    lv_style_get_prop(&style, LV_STYLE_RADIUS, &v);
+    TEST_ASSERT_EQUAL(10, v.num);
+    lv_style_reset(&style);
+}
+
+void test_frozen_style_single_and_custom_prop(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    TEST_ASSERT_TRUE(lv_style_freeze(&style));
+    TEST_ASSERT_TRUE(lv_style_is_empty(&style));
+    lv_style_reset(&style);
+
+    lv_style_value_t v;
+    lv_style_set_pad_top(&style, 3);
+    TEST_ASSERT_TRUE(lv_style_freeze(&style));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_PAD_TOP, &v));
+    TEST_ASSERT_EQUAL(3, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_PAD_BOTTOM, &v));
+    lv_style_reset(&style);
+
+    /*Custom properties can't be frozen*/
+    lv_style_set_pad_top(&style, 3);
+    lv_style_set_prop(&style, _LV_STYLE_NUM_BUILT_IN_PROPS + 1, v);
+    TEST_ASSERT_FALSE(lv_style_freeze(&style));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_PAD_TOP, &v));
+    lv_style_reset(&style);
+}
+
+static const lv_style_value_t frozen_values[] = {
+    {.num = 20}, {.num = 4}
+};
+
+static const lv_style_frozen_t frozen_dsc = {
+    .has_prop = {(1 << LV_STYLE_WIDTH) | (1 << LV_STYLE_RADIUS)},
+    .values = frozen_values,
+};
+
+static LV_STYLE_FROZEN_INIT(style_rom, frozen_dsc);
+
+void test_frozen_style_in_rom(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_add_style(obj, (lv_style_t *)&style_rom, 0);
+    TEST_ASSERT_EQUAL(20, lv_obj_get_style_width(obj, 0));
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_radius(obj, 0));
+    lv_obj_del(obj);
+}
+
 #endif
@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_timer_t * sys_timers[16];
+static uint32_t sys_timer_cnt;
+static char run_log[64];
+
+void setUp(void)
+{
+    /*Pause the display and input device timers to see only the timers of the tests*/
+    sys_timer_cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        if(!timer->paused && sys_timer_cnt < 16) {
+            lv_timer_pause(timer);
+            sys_timers[sys_timer_cnt] = timer;
+            sys_timer_cnt++;
+        }
+        timer = lv_timer_get_next(timer);
+    }
+    run_log[0] = '\0';
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < sys_timer_cnt; i++) lv_timer_resume(sys_timers[i]);
+}
+
+static void log_char(char c)
+{
+    size_t len = strlen(run_log);
+    run_log[len] = c;
+    run_log[len + 1] = '\0';
+}
+
+static void log_cb(lv_timer_t * timer)
+{
+    log_char((char)(lv_uintptr_t)timer->user_data);
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = timer->user_data;
+    (*cnt)++;
+}
+
+static void del_other_cb(lv_timer_t * timer)
+{
+    log_char('x');
+    lv_timer_del(timer->user_data);
+}
+
+static void del_self_cb(lv_timer_t * timer)
+{
+    log_char('d');
+    lv_timer_del(timer);
+}
+
+static bool timer_exists(lv_timer_t * timer)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == timer) return true;
+        t = lv_timer_get_next(t);
+    }
+    return false;
+}
+
+static void advance(uint32_t ms)
+{
+    uint32_t i;
+    for(i = 0; i < ms; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+}
+
+void test_timer_runs_in_the_order_of_next_run(void)
+{
+    lv_timer_t * t1 = lv_timer_create(log_cb, 40, (void *)'c');
+    lv_timer_t * t2 = lv_timer_create(log_cb, 10, (void *)'a');
+    lv_timer_t * t3 = lv_timer_create(log_cb, 25, (void *)'b');
+
+    lv_tick_inc(45);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING("abc", run_log);
+
+    /*The next runs are 10, 25 and 40 ms from now*/
+    advance(30);
+    TEST_ASSERT_EQUAL_STRING("abcaaba", run_log);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    lv_timer_del(t3);
+}
+
+void test_timer_zero_period_runs_once_per_call(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, &cnt);
+
+    lv_timer_handler();
+    lv_timer_handler();
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, cnt);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_till_next());
+
+    lv_timer_del(timer);
+}
+
+void test_timer_time_till_next(void)
+{
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 100, &cnt);
+    TEST_ASSERT_EQUAL(100, lv_timer_get_time_till_next());
+
+    lv_tick_inc(40);
+    TEST_ASSERT_EQUAL(60, lv_timer_handler());
+    TEST_ASSERT_EQUAL(60, lv_timer_get_time_till_next());
+
+    lv_timer_pause(timer);
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+    lv_timer_resume(timer);
+    TEST_ASSERT_EQUAL(60, lv_timer_get_time_till_next());
+
+    lv_timer_set_period(timer, 50);
+    TEST_ASSERT_EQUAL(10, lv_timer_get_time_till_next());
+
+    lv_timer_ready(timer);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_till_next());
+    TEST_ASSERT_EQUAL(50, lv_timer_handler());
+    TEST_ASSERT_EQUAL(1, cnt);
+
+    lv_tick_inc(20);
+    lv_timer_reset(timer);
+    TEST_ASSERT_EQUAL(50, lv_timer_get_time_till_next());
+
+    lv_timer_del(timer);
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_get_time_till_next());
+}
+
+void test_timer_repeat_count(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 10, &cnt);
+    lv_timer_set_repeat_count(timer, 2);
+
+    advance(100);
+    TEST_ASSERT_EQUAL(2, cnt);
+    TEST_ASSERT_FALSE(timer_exists(timer));
+
+    /*0 repeat count deletes the timer without calling it*/
+    timer = lv_timer_create(count_cb, 1000, &cnt);
+    lv_timer_set_repeat_count(timer, 0);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, cnt);
+    TEST_ASSERT_FALSE(timer_exists(timer));
+}
+
+void test_timer_delete_in_callback(void)
+{
+    lv_timer_t * t_del = lv_timer_create(log_cb, 20, (void *)'b');
+    lv_timer_t * t_other = lv_timer_create(del_other_cb, 10, t_del);
+    lv_timer_t * t_keep = lv_timer_create(log_cb, 20, (void *)'c');
+    lv_timer_create(del_self_cb, 15, NULL);
+
+    /*A timer deletes an other before it's run and one deletes itself*/
+    lv_tick_inc(25);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING("xdc", run_log);
+    TEST_ASSERT_FALSE(timer_exists(t_del));
+
+    lv_timer_del(t_other);
+    lv_timer_del(t_keep);
+}
+
+void test_timer_many_timers(void)
+{
+    static uint32_t cnt[200];
+    static lv_timer_t * timers[200];
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        cnt[i] = 0;
+        timers[i] = lv_timer_create(count_cb, 1 + (i * 37) % 97, &cnt[i]);
+    }
+
+    advance(1000);
+
+    for(i = 0; i < 200; i++) {
+        TEST_ASSERT_EQUAL(1000 / timers[i]->period, cnt[i]);
+        lv_timer_del(timers[i]);
+    }
+}
+
+#endif
@@ -10,6 +10,7 @@
 #define _DEFAULT_SOURCE /* needed for usleep() */
 #include <stdlib.h>
 #include <unistd.h>
+#include <pthread.h>
 #define SDL_MAIN_HANDLED /*To fix SDL's "undefined reference to WinMain" issue*/
 #include <SDL2/SDL.h>
 #include "lvgl/lvgl.h"
@@ -18,6 +19,7 @@
 #include "lv_drivers/sdl/sdl.h"
 
 #include "lvgl/pe_examples/lvgl_2048.h"
+#include "lvgl/pe_examples/lvgl_2048_solver.h"
 /*********************
  *      DEFINES
  *********************/
@@ -30,10 +32,14 @@
  *  STATIC PROTOTYPES
  **********************/
 static void hal_init(void);
+static void lvgl_lock(void);
+static void lvgl_unlock(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Held while LVGL runs; background threads take it before calling into LVGL*/
+static pthread_mutex_t lvgl_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 /**********************
  *      MACROS
@@ -93,13 +99,19 @@ int main(int argc, char **argv)
   //  lv_example_label_1();
 
   // lv_demo_widgets();
+  lvgl_2048_solver_set_port(lvgl_lock, lvgl_unlock, sdl_wake_up); /*Wake up the loop when a solver thread posts its result*/
   lvgl_2048_start();
   while (1)
   {
     /* Periodically call the lv_task handler.
      * It could be done in a timer interrupt or an OS task too.*/
-    lv_timer_handler();
-    usleep(5 * 1000);
+    lvgl_lock(); /*Background solver threads post results with lv_async_call*/
+    sdl_handle_events();
+    uint32_t time_till_next = lv_timer_handler();
+    lvgl_unlock();
+
+    /*Sleep until an input, a posted call or the next timer*/
+    sdl_wait_event(time_till_next);
   }
 
   return 0;
@@ -120,8 +132,15 @@ static void hal_init(void)
 
   /*Create a display buffer*/
   static lv_disp_draw_buf_t disp_buf1;
+#if SDL_DOUBLE_BUFFERED
+  /*Two screen sized buffers in direct mode: only the changed areas are rendered and uploaded*/
+  static lv_color_t buf1_1[SDL_HOR_RES * SDL_VER_RES];
+  static lv_color_t buf1_2[SDL_HOR_RES * SDL_VER_RES];
+  lv_disp_draw_buf_init(&disp_buf1, buf1_1, buf1_2, SDL_HOR_RES * SDL_VER_RES);
+#else
   static lv_color_t buf1_1[SDL_HOR_RES * 100];
   lv_disp_draw_buf_init(&disp_buf1, buf1_1, NULL, SDL_HOR_RES * 100);
+#endif
 
   /*Create a display*/
   static lv_disp_drv_t disp_drv;
@@ -130,6 +149,9 @@ static void hal_init(void)
   disp_drv.flush_cb = sdl_display_flush;
   disp_drv.hor_res = SDL_HOR_RES;
   disp_drv.ver_res = SDL_VER_RES;
+#if SDL_DOUBLE_BUFFERED
+  disp_drv.direct_mode = 1;
+#endif
 
   lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
 
@@ -169,3 +191,13 @@ static void hal_init(void)
   lv_img_set_src(cursor_obj, &mouse_cursor_icon);     /*Set the image source*/
   lv_indev_set_cursor(mouse_indev, cursor_obj);       /*Connect the image  object to the driver*/
 }
+
+static void lvgl_lock(void)
+{
+  pthread_mutex_lock(&lvgl_mutex);
+}
+
+static void lvgl_unlock(void)
+{
+  pthread_mutex_unlock(&lvgl_mutex);
+}